@@ -8,7 +8,7 @@
 # .. code-block:: cmake
 #
 #    usFunctionAddResources(TARGET target [BUNDLE_NAME bundle_name]
-#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level]
+#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level] [BINARY_MANIFEST]
 #      [FILES res1...] [ZIP_ARCHIVES archive1...])
 #
 # This CMake function uses an external command line program to generate a ZIP archive
@@ -45,6 +45,11 @@
 #      FILES argument. If no or a relative path is given, it is considered relative to the
 #      current CMake source directory.
 #
+# **Options**
+#    * ``BINARY_MANIFEST``: Add a compiled ``manifest.bin`` next to the bundle's ``manifest.json``.
+#      The framework loads the compiled manifest without parsing JSON, which speeds up
+#      installing the bundle.
+#
 # **Multi-value keywords**
 #    * ``FILES`` (optional): A list of resource files (paths to external files in the file system)
 #      relative to the current working directory.
@@ -60,7 +65,7 @@
 #
 function(usFunctionAddResources)
 
-  cmake_parse_arguments(US_RESOURCE "" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
+  cmake_parse_arguments(US_RESOURCE "BINARY_MANIFEST" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
 
   if(NOT US_RESOURCE_TARGET)
     message(SEND_ERROR "TARGET argument not specified.")
@@ -85,9 +90,15 @@ function(usFunctionAddResources)
     set(US_RESOURCE_WORKING_DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}/${US_RESOURCE_WORKING_DIRECTORY}")
   endif()
 
-  if(US_RESOURCE_COMPRESSION_LEVEL)
+  # Level 0 (store without compression) is valid, so test for an empty value
+  if(NOT "${US_RESOURCE_COMPRESSION_LEVEL}" STREQUAL "")
     set(cmd_line_args -c ${US_RESOURCE_COMPRESSION_LEVEL})
   endif()
+  if(US_RESOURCE_BINARY_MANIFEST)
+    list(APPEND cmd_line_args -B)
+  endif()
+  # Reuse unchanged entries of the zip file from a previous build
+  list(APPEND cmd_line_args -i)
 
   if(CMAKE_CROSSCOMPILING)
     # Cross-compiled builds need to use the imported host version of usResourceCompiler
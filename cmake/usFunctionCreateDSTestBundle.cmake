@@ -1,12 +1,16 @@
 function(usFunctionCreateDSTestBundle name)
-  # Add in rule for how to build the autogen source for the glue
+  # Add in rule for how to build the autogen source for the glue and the
+  # serialized component metadata, which is embedded as the resource
+  # scr_metadata.bin
 
   set(_glue_file ${CMAKE_CURRENT_BINARY_DIR}/autogen_${name}_Glue.cpp)
   set(_glue_file ${_glue_file} PARENT_SCOPE)
+  set(_metadata_file ${CMAKE_CURRENT_BINARY_DIR}/resources/scr_metadata.bin)
 
   add_custom_command(
-    OUTPUT ${_glue_file}
-    COMMAND $<TARGET_FILE:SCRCodeGen> --manifest ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json --out-file ${_glue_file} --include-headers ServiceComponents.hpp
+    OUTPUT ${_glue_file} ${_metadata_file}
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${CMAKE_CURRENT_BINARY_DIR}/resources
+    COMMAND $<TARGET_FILE:SCRCodeGen> --manifest ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json --out-file ${_glue_file} --metadata-file ${_metadata_file} --include-headers ServiceComponents.hpp
     DEPENDS SCRCodeGen usServiceComponent ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json
     COMMENT "Generate bundle activator based on manifest.json"
     VERBATIM)
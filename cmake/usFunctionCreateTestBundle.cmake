@@ -22,7 +22,13 @@ macro(_us_create_test_bundle_helper)
   target_link_libraries(${name} ${${PROJECT_NAME}_TARGET} ${US_TEST_LINK_LIBRARIES} ${US_TEST_OTHER_LIBRARIES} CppMicroServices)
 
   if(_res_files OR US_TEST_LINK_LIBRARIES)
+    set(_binary_manifest )
+    if(US_TEST_BINARY_MANIFEST)
+      set(_binary_manifest BINARY_MANIFEST)
+    endif()
     usFunctionAddResources(TARGET ${name} WORKING_DIRECTORY ${_res_root}
+                           COMPRESSION_LEVEL "${US_TEST_COMPRESSION_LEVEL}"
+                           ${_binary_manifest}
                            FILES ${_res_files}
                            ZIP_ARCHIVES ${US_TEST_LINK_LIBRARIES})
   endif()
@@ -49,7 +55,7 @@ function(usFunctionCreateTestBundle name)
 endfunction()
 
 function(usFunctionCreateTestBundleWithResources name)
-  cmake_parse_arguments(US_TEST "SKIP_BUNDLE_LIST;LINK_RESOURCES;APPEND_RESOURCES" "RESOURCES_ROOT;LIBRARY_EXTENSION;BUNDLE_SYMBOLIC_NAME" "SOURCES;RESOURCES;BINARY_RESOURCES;LINK_LIBRARIES;OTHER_LIBRARIES" "" ${ARGN})
+  cmake_parse_arguments(US_TEST "SKIP_BUNDLE_LIST;LINK_RESOURCES;APPEND_RESOURCES;BINARY_MANIFEST" "RESOURCES_ROOT;LIBRARY_EXTENSION;BUNDLE_SYMBOLIC_NAME;COMPRESSION_LEVEL" "SOURCES;RESOURCES;BINARY_RESOURCES;LINK_LIBRARIES;OTHER_LIBRARIES" "" ${ARGN})
 
   if(US_TEST_BUNDLE_SYMBOLIC_NAME)
     set(_bundle_symbolic_name ${US_TEST_BUNDLE_SYMBOLIC_NAME})
@@ -8,7 +8,7 @@
 # .. code-block:: cmake
 #
 #    usFunctionEmbedResources(TARGET target [BUNDLE_NAME bundle_name] [APPEND | LINK]
-#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level]
+#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level] [BINARY_MANIFEST]
 #      [FILES res1...] [ZIP_ARCHIVES archive1...])
 #
 # This CMake function uses an external command line program to generate a ZIP archive
@@ -53,7 +53,7 @@
 #    * ``APPEND``: Append the resources zip file to the target file.
 #    * ``LINK``: Link (embed) the resources zip file if possible.
 #
-# For the ``WORKING_DIRECTORY``, ``COMPRESSION_LEVEL``, ``FILES``, ``ZIP_ARCHIVES`` parameters see the
+# For the ``WORKING_DIRECTORY``, ``COMPRESSION_LEVEL``, ``BINARY_MANIFEST``, ``FILES``, ``ZIP_ARCHIVES`` parameters see the
 # documentation of the usFunctionAddResources macro which is called with these parameters if set.
 #
 # .. seealso::
@@ -64,19 +64,24 @@
 #
 function(usFunctionEmbedResources)
 
-  cmake_parse_arguments(US_RESOURCE "APPEND;LINK" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
+  cmake_parse_arguments(US_RESOURCE "APPEND;LINK;BINARY_MANIFEST" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
 
   if(NOT US_RESOURCE_TARGET)
     message(SEND_ERROR "TARGET argument not specified.")
   endif()
 
   if(US_RESOURCE_FILES OR US_RESOURCE_ZIP_ARCHIVES)
+    set(_binary_manifest )
+    if(US_RESOURCE_BINARY_MANIFEST)
+      set(_binary_manifest BINARY_MANIFEST)
+    endif()
     usFunctionAddResources(TARGET ${US_RESOURCE_TARGET}
       BUNDLE_NAME ${US_RESOURCE_BUNDLE_NAME}
       WORKING_DIRECTORY ${US_RESOURCE_WORKING_DIRECTORY}
       COMPRESSION_LEVEL ${US_RESOURCE_COMPRESSION_LEVEL}
       FILES ${US_RESOURCE_FILES}
       ZIP_ARCHIVES ${US_RESOURCE_ZIP_ARCHIVES}
+      ${_binary_manifest}
     )
   endif()
 
@@ -61,7 +61,7 @@ void ComponentContextImpl::InitializeServicesCache()
   for(const auto& refManager : refManagers) {
     const auto& sRefs = refManager->GetBoundReferences();
     const auto& refName = refManager->GetReferenceName();
-    const auto& refScope = refManager->GetReferenceScope();
+    const bool bundleScope = (refManager->GetReferenceScope() == metadata::ReferenceScope::Bundle);
     std::for_each(sRefs.rbegin()
                   , sRefs.rend()
                   , [&](const cppmicroservices::ServiceReferenceBase& sRef) {
@@ -70,13 +70,12 @@ void ComponentContextImpl::InitializeServicesCache()
                         ServiceReferenceU sRefU(sRef);
                         auto bc = GetBundleContext();
                         auto& serviceMap = boundServicesCache[refName];
-                        if(refScope == cppmicroservices::Constants::SCOPE_BUNDLE)
+                        if(bundleScope)
                         {
                           serviceMap.push_back(bc.GetService(sRefU));
                         }
                         else
                         {
-                          auto registeredScope = sRef.GetProperty(cppmicroservices::Constants::SERVICE_SCOPE).ToStringNoExcept();
                           cppmicroservices::ServiceObjects<void> sObjs = bc.GetServiceObjects(sRefU);
                           serviceMap.push_back(sObjs.GetService());
                         }
@@ -21,54 +21,73 @@
   =============================================================================*/
 
 #include "ComponentRegistry.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
 
 namespace cppmicroservices {
 namespace scrimpl {
 
+ComponentRegistry::ComponentRegistry()
+  : mSnapshot(std::make_shared<const Snapshot>())
+{
+}
+
+std::shared_ptr<const ComponentRegistry::Snapshot> ComponentRegistry::GetSnapshot() const
+{
+  return std::atomic_load(&mSnapshot);
+}
+
 std::vector<std::shared_ptr<ComponentManager>> ComponentRegistry::GetComponentManagers() const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex); 
+  auto snapshot = GetSnapshot();
   std::vector<std::shared_ptr<ComponentManager>> managers;
-  for (const auto& kv : mComponentsByName)
+  managers.reserve(snapshot->count);
+  for (const auto& kv : snapshot->shards)
   {
-    managers.push_back(kv.second);
+    managers.insert(managers.end(), kv.second->managers.begin(), kv.second->managers.end());
   }
   return managers;
 }
 
 std::vector<std::shared_ptr<ComponentManager>> ComponentRegistry::GetComponentManagers(unsigned long bundleId) const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  std::vector<std::shared_ptr<ComponentManager>> managers;
-  for (const auto& kv : mComponentsByName)
+  auto snapshot = GetSnapshot();
+  auto iter = snapshot->shards.find(bundleId);
+  if(iter == snapshot->shards.end())
   {
-    if(kv.first.first == bundleId)
-    {
-      managers.push_back(kv.second);
-    }
+    return {};
   }
-  return managers;
+  return iter->second->managers;
 }
 
 std::shared_ptr<ComponentManager> ComponentRegistry::GetComponentManager(unsigned long bundleId,
                                                                          const std::string& compName) const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  return mComponentsByName.at(std::make_pair(bundleId, compName));
+  auto snapshot = GetSnapshot();
+  auto iter = snapshot->shards.find(bundleId);
+  if(iter == snapshot->shards.end())
+  {
+    throw std::out_of_range("No component with the name " + compName + " in the bundle with id " + std::to_string(bundleId));
+  }
+  auto compIter = iter->second->managersByName.find(compName);
+  if(compIter == iter->second->managersByName.end())
+  {
+    throw std::out_of_range("No component with the name " + compName + " in the bundle with id " + std::to_string(bundleId));
+  }
+  return compIter->second;
 }
 
 bool ComponentRegistry::AddComponentManager(const std::shared_ptr<ComponentManager>& cm)
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  auto result = mComponentsByName.insert(std::make_pair(std::make_pair(static_cast<unsigned long>(cm->GetBundleId()), cm->GetName()), cm));
-  return result.second;
+  ComponentKey key(static_cast<unsigned long>(cm->GetBundleId()), cm->GetName());
+  return !Update({ std::make_pair(std::move(key), cm) }, {}).empty();
 }
 
 void ComponentRegistry::RemoveComponentManager(unsigned long bundleId,
                                                const std::string& compName)
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  mComponentsByName.erase(std::make_pair(bundleId, compName));
+  Update({}, { ComponentKey(bundleId, compName) });
 }
 
 void ComponentRegistry::RemoveComponentManager(const std::shared_ptr<ComponentManager>& cm)
@@ -77,16 +96,108 @@ void ComponentRegistry::RemoveComponentManager(const std::shared_ptr<ComponentMa
                          cm->GetName());
 }
 
+std::vector<std::shared_ptr<ComponentManager>> ComponentRegistry::AddComponentManagers(const std::vector<std::shared_ptr<ComponentManager>>& cms)
+{
+  std::vector<std::pair<ComponentKey, std::shared_ptr<ComponentManager>>> added;
+  added.reserve(cms.size());
+  for(const auto& cm : cms)
+  {
+    added.emplace_back(ComponentKey(static_cast<unsigned long>(cm->GetBundleId()), cm->GetName()), cm);
+  }
+  return Update(added, {});
+}
+
+void ComponentRegistry::RemoveComponentManagers(const std::vector<std::shared_ptr<ComponentManager>>& cms)
+{
+  std::vector<ComponentKey> removed;
+  removed.reserve(cms.size());
+  for(const auto& cm : cms)
+  {
+    removed.emplace_back(static_cast<unsigned long>(cm->GetBundleId()), cm->GetName());
+  }
+  Update({}, removed);
+}
+
+std::vector<std::shared_ptr<ComponentManager>> ComponentRegistry::Update(const std::vector<std::pair<ComponentKey, std::shared_ptr<ComponentManager>>>& added,
+                                                                         const std::vector<ComponentKey>& removed)
+{
+  std::vector<std::shared_ptr<ComponentManager>> inserted;
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  auto next = std::make_shared<Snapshot>(*GetSnapshot());
+  // the shards modified by this update are copied once, the other shards
+  // are shared with the current snapshot
+  std::map<unsigned long, std::shared_ptr<BundleShard>> copies;
+  auto getShard = [&next, &copies](unsigned long bundleId) -> BundleShard& {
+    auto& copy = copies[bundleId];
+    if(!copy)
+    {
+      auto iter = next->shards.find(bundleId);
+      copy = (iter != next->shards.end()) ? std::make_shared<BundleShard>(*iter->second)
+                                          : std::make_shared<BundleShard>();
+    }
+    return *copy;
+  };
+
+  std::unordered_set<const ComponentManager*> removedManagers;
+  for(const auto& key : removed)
+  {
+    auto& shard = getShard(key.first);
+    auto iter = shard.managersByName.find(key.second);
+    if(iter != shard.managersByName.end())
+    {
+      removedManagers.insert(iter->second.get());
+      shard.managersByName.erase(iter);
+      --next->count;
+    }
+  }
+  for(const auto& entry : added)
+  {
+    auto& shard = getShard(entry.first.first);
+    if(shard.managersByName.emplace(entry.first.second, entry.second).second)
+    {
+      shard.managers.push_back(entry.second);
+      inserted.push_back(entry.second);
+      ++next->count;
+    }
+  }
+  if(inserted.empty() && removedManagers.empty())
+  {
+    return inserted;
+  }
+
+  for(auto& kv : copies)
+  {
+    auto& managers = kv.second->managers;
+    if(!removedManagers.empty())
+    {
+      managers.erase(std::remove_if(managers.begin(), managers.end(),
+                                    [&removedManagers](const std::shared_ptr<ComponentManager>& cm) {
+                                      return removedManagers.count(cm.get()) != 0;
+                                    }),
+                     managers.end());
+    }
+    if(managers.empty())
+    {
+      next->shards.erase(kv.first);
+    }
+    else
+    {
+      next->shards[kv.first] = std::move(kv.second);
+    }
+  }
+  std::atomic_store(&mSnapshot, std::shared_ptr<const Snapshot>(std::move(next)));
+  return inserted;
+}
+
 void ComponentRegistry::Clear()
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  mComponentsByName.clear();
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  std::atomic_store(&mSnapshot, std::make_shared<const Snapshot>());
 }
 
 size_t ComponentRegistry::Count() const
 {
-  std::lock_guard<std::mutex> lock(mMapsMutex);
-  return mComponentsByName.size();
+  return GetSnapshot()->count;
 }
 }
 }
@@ -23,7 +23,11 @@
 #ifndef __COMPONENT_REGISTRY_HPP__
 #define __COMPONENT_REGISTRY_HPP__
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "manager/ComponentManager.hpp"
 
@@ -32,11 +36,18 @@ namespace scrimpl {
 /**
  * This class provides a thread-safe store for ComponentManager objects
  * created by the runtime.
+ *
+ * The component managers are stored in one shard per bundle, which maps
+ * the component names to the managers. The shards are immutable and
+ * published in a snapshot of the registry. A modification copies the
+ * shards of the affected bundles and publishes a new snapshot, while the
+ * readers use the snapshot which was current when they started. Reading
+ * the registry never waits for a bundle which is being loaded or unloaded.
  */
 class ComponentRegistry
 {
 public:
-  ComponentRegistry() = default;
+  ComponentRegistry();
   virtual ~ComponentRegistry() = default;
   ComponentRegistry(const ComponentRegistry&) = delete;
   ComponentRegistry& operator=(const ComponentRegistry&) = delete;
@@ -111,6 +122,31 @@ public:
    */
   virtual void RemoveComponentManager(const std::shared_ptr<ComponentManager>& cm);
 
+  /**
+   * Method to add several component manager objects, typically all the
+   * components of a bundle, into the component registry at once. The
+   * managers are visible to the readers of the registry together.
+   *
+   * The update is all or nothing: if it throws, none of the component
+   * managers is inserted. Callers which must not lose the other components
+   * when one of them fails add them with #AddComponentManager instead.
+   *
+   * \param cms are the {@link ComponentManager} objects to insert
+   * \return the component managers which were inserted into the registry.
+   *         A component manager is not inserted if the registry already
+   *         contains a component with the same name from the same bundle.
+   */
+  virtual std::vector<std::shared_ptr<ComponentManager>> AddComponentManagers(const std::vector<std::shared_ptr<ComponentManager>>& cms);
+
+  /**
+   * Method to remove several component manager objects, typically all the
+   * components of a bundle, from the component registry at once. The
+   * component managers which are not in the registry are ignored.
+   *
+   * \param cms are the {@link ComponentManager} objects to remove
+   */
+  virtual void RemoveComponentManagers(const std::vector<std::shared_ptr<ComponentManager>>& cms);
+
   /**
    * Removes all entries from the component registry
    */
@@ -121,8 +157,41 @@ public:
    */
   size_t Count() const;
 private:
-  std::map<std::pair<unsigned long,std::string>,std::shared_ptr<ComponentManager>> mComponentsByName;
-  mutable std::mutex mMapsMutex;
+  using ComponentKey = std::pair<unsigned long, std::string>;
+
+  /**
+   * The component managers of one bundle
+   */
+  struct BundleShard
+  {
+    std::vector<std::shared_ptr<ComponentManager>> managers; ///< in the order they were added
+    std::unordered_map<std::string, std::shared_ptr<ComponentManager>> managersByName;
+  };
+
+  /**
+   * An immutable state of the registry
+   */
+  struct Snapshot
+  {
+    std::map<unsigned long, std::shared_ptr<const BundleShard>> shards; ///< shards by bundle id
+    std::size_t count{ 0 }; ///< number of component managers in all shards
+  };
+
+  std::shared_ptr<const Snapshot> GetSnapshot() const;
+
+  /**
+   * Publishes a copy of the current snapshot in which the given components
+   * are added to or removed from their bundle shards.
+   *
+   * \param added are the managers to add with their keys
+   * \param removed are the keys of the managers to remove
+   * \return the managers which were added
+   */
+  std::vector<std::shared_ptr<ComponentManager>> Update(const std::vector<std::pair<ComponentKey, std::shared_ptr<ComponentManager>>>& added,
+                                                        const std::vector<ComponentKey>& removed);
+
+  std::shared_ptr<const Snapshot> mSnapshot; ///< accessed with the atomic shared_ptr functions
+  std::mutex mWriteMutex; ///< serializes the modifications of the registry
 };
 } // scrimpl
 } // cppmicroservices
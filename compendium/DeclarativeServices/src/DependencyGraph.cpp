@@ -0,0 +1,199 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "DependencyGraph.hpp"
+#include "metadata/ReferenceMetadata.hpp"
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+DependencyGraph::DependencyGraph(const std::vector<std::shared_ptr<ComponentManager>>& managers)
+{
+  Add(managers);
+}
+
+void DependencyGraph::Add(const std::vector<std::shared_ptr<ComponentManager>>& managers)
+{
+  std::lock_guard<std::mutex> lock(graphMutex);
+  for (const auto& manager : managers)
+  {
+    for (const auto& interfaceName : manager->GetMetadata()->serviceMetadata.interfaces)
+    {
+      providers[interfaceName].push_back(manager);
+    }
+  }
+}
+
+void DependencyGraph::Remove(const std::vector<std::shared_ptr<ComponentManager>>& managers)
+{
+  std::lock_guard<std::mutex> lock(graphMutex);
+  for (const auto& manager : managers)
+  {
+    for (const auto& interfaceName : manager->GetMetadata()->serviceMetadata.interfaces)
+    {
+      auto it = providers.find(interfaceName);
+      if (it == providers.end())
+      {
+        continue;
+      }
+      auto& interfaceProviders = it->second;
+      interfaceProviders.erase(std::remove(interfaceProviders.begin(), interfaceProviders.end(), manager),
+                               interfaceProviders.end());
+      if (interfaceProviders.empty())
+      {
+        providers.erase(it);
+      }
+    }
+  }
+}
+
+std::vector<std::shared_ptr<ComponentManager>>
+DependencyGraph::GetDependencies(const std::shared_ptr<ComponentManager>& manager) const
+{
+  std::vector<std::shared_ptr<ComponentManager>> dependencies;
+  for (const auto& refMetadata : manager->GetMetadata()->refsMetadata)
+  {
+    // the second element is the minimum cardinality
+    if (std::get<1>(metadata::GetReferenceCardinalityExtents(refMetadata.cardinality)) == 0)
+    {
+      continue;
+    }
+    auto it = providers.find(refMetadata.interfaceName);
+    if (it == providers.end())
+    {
+      continue;
+    }
+    for (const auto& provider : it->second)
+    {
+      // a component never satisfies its own references
+      if (provider != manager)
+      {
+        dependencies.push_back(provider);
+      }
+    }
+  }
+  return dependencies;
+}
+
+std::vector<std::vector<std::shared_ptr<ComponentManager>>>
+DependencyGraph::FindCycles(const std::vector<std::shared_ptr<ComponentManager>>& managers) const
+{
+  // Tarjan's algorithm for strongly connected components, with an explicit
+  // stack so that deep graphs do not overflow the call stack. The state is
+  // kept per visited node, so only the reachable part of the graph is visited.
+  struct NodeState
+  {
+    std::size_t index;
+    std::size_t lowLink;
+    bool onStack;
+  };
+  struct Frame
+  {
+    std::shared_ptr<ComponentManager> node;
+    std::vector<std::shared_ptr<ComponentManager>> dependencies;
+    std::size_t next; ///< index of the next dependency to visit
+  };
+  std::lock_guard<std::mutex> lock(graphMutex);
+  std::unordered_map<const ComponentManager*, NodeState> visited;
+  std::unordered_set<const ComponentManager*> wanted;
+  std::vector<std::shared_ptr<ComponentManager>> sccStack;
+  std::vector<Frame> callStack;
+  std::size_t nextIndex = 0;
+  std::vector<std::vector<std::shared_ptr<ComponentManager>>> cycles;
+
+  for (const auto& manager : managers)
+  {
+    wanted.insert(manager.get());
+  }
+
+  auto visit = [&](const std::shared_ptr<ComponentManager>& node) {
+    visited[node.get()] = NodeState{ nextIndex, nextIndex, true };
+    ++nextIndex;
+    sccStack.push_back(node);
+    callStack.push_back(Frame{ node, GetDependencies(node), 0 });
+  };
+
+  for (const auto& manager : managers)
+  {
+    if (visited.count(manager.get()) != 0u)
+    {
+      continue;
+    }
+    visit(manager);
+    while (!callStack.empty())
+    {
+      auto& frame = callStack.back();
+      auto& nodeState = visited[frame.node.get()];
+      if (frame.next < frame.dependencies.size())
+      {
+        const auto dependency = frame.dependencies[frame.next++];
+        auto it = visited.find(dependency.get());
+        if (it == visited.end())
+        {
+          // invalidates frame
+          visit(dependency);
+        }
+        else if (it->second.onStack)
+        {
+          nodeState.lowLink = (std::min)(nodeState.lowLink, it->second.index);
+        }
+        continue;
+      }
+      const auto node = frame.node;
+      const auto lowLink = nodeState.lowLink;
+      const auto isRoot = lowLink == nodeState.index;
+      callStack.pop_back();
+      if (!callStack.empty())
+      {
+        auto& parentState = visited[callStack.back().node.get()];
+        parentState.lowLink = (std::min)(parentState.lowLink, lowLink);
+      }
+      if (!isRoot)
+      {
+        continue;
+      }
+      // node is the root of a strongly connected component
+      std::vector<std::shared_ptr<ComponentManager>> component;
+      bool containsWanted = false;
+      std::shared_ptr<ComponentManager> member;
+      do
+      {
+        member = sccStack.back();
+        sccStack.pop_back();
+        visited[member.get()].onStack = false;
+        containsWanted = containsWanted || wanted.count(member.get()) != 0u;
+        component.push_back(member);
+      } while (member != node);
+      if (component.size() > 1 && containsWanted)
+      {
+        cycles.push_back(std::move(component));
+      }
+    }
+  }
+  return cycles;
+}
+} // scrimpl
+} // cppmicroservices
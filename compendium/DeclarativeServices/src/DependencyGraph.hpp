@@ -0,0 +1,109 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __DEPENDENCY_GRAPH_HPP__
+#define __DEPENDENCY_GRAPH_HPP__
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "manager/ComponentManager.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+/**
+ * This class represents the mandatory references between components. Each
+ * component is connected to the components which provide the service
+ * interface of one of its mandatory references. Target filters are not
+ * considered.
+ *
+ * The components of a cycle in this graph never satisfy each other. They
+ * are only satisfied if a service they reference is registered by a bundle
+ * outside of the cycle.
+ *
+ * The graph is updated as bundles are loaded and unloaded. Only the
+ * providers of each service interface are stored, the edges of a component
+ * are looked up from its references when the graph is traversed. Adding or
+ * removing a component therefore does not visit the rest of the graph.
+ * This class is thread safe.
+ */
+class DependencyGraph
+{
+public:
+  DependencyGraph() = default;
+
+  /**
+   * Creates the graph of the mandatory references between the given components
+   *
+   * \param managers are the {@link ComponentManager} objects of the components
+   */
+  explicit DependencyGraph(const std::vector<std::shared_ptr<ComponentManager>>& managers);
+  DependencyGraph(const DependencyGraph&) = delete;
+  DependencyGraph& operator=(const DependencyGraph&) = delete;
+  DependencyGraph(DependencyGraph&&) = delete;
+  DependencyGraph& operator=(DependencyGraph&&) = delete;
+  ~DependencyGraph() = default;
+
+  /**
+   * Adds the given components to the graph
+   *
+   * \param managers are the {@link ComponentManager} objects of the components
+   */
+  void Add(const std::vector<std::shared_ptr<ComponentManager>>& managers);
+
+  /**
+   * Removes the given components from the graph. Components which are not
+   * part of this graph are ignored.
+   *
+   * \param managers are the {@link ComponentManager} objects of the components
+   */
+  void Remove(const std::vector<std::shared_ptr<ComponentManager>>& managers);
+
+  /**
+   * Returns the reference cycles which contain at least one of the given
+   * components. Each cycle is returned as the set of components which are
+   * strongly connected through mandatory references. Only the part of the
+   * graph reachable from the given components is visited.
+   *
+   * \param managers are the components the cycles must contain. Components
+   *        which are not part of this graph are ignored.
+   * \return the components of each cycle, in no particular order
+   */
+  std::vector<std::vector<std::shared_ptr<ComponentManager>>>
+  FindCycles(const std::vector<std::shared_ptr<ComponentManager>>& managers) const;
+
+private:
+  /**
+   * Returns the components in this graph which provide a mandatory
+   * reference of the given component. The caller must hold #graphMutex.
+   */
+  std::vector<std::shared_ptr<ComponentManager>> GetDependencies(const std::shared_ptr<ComponentManager>& manager) const;
+
+  mutable std::mutex graphMutex; ///< protects #providers
+  std::unordered_map<std::string, std::vector<std::shared_ptr<ComponentManager>>> providers; ///< the components of the graph providing each service interface
+};
+} // scrimpl
+} // cppmicroservices
+
+#endif // __DEPENDENCY_GRAPH_HPP__
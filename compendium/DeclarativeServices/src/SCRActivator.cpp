@@ -20,6 +20,7 @@
 
   =============================================================================*/
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <memory>
@@ -31,6 +32,7 @@
 #include "manager/ComponentManager.hpp"
 #include "manager/ReferenceManager.hpp"
 #include "ServiceComponentRuntimeImpl.hpp"
+#include "DependencyGraph.hpp"
 
 #include "cppmicroservices/SharedLibraryException.h"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
@@ -40,6 +42,7 @@
 
 using cppmicroservices::logservice::SeverityLevel;
 using cppmicroservices::service::component::ComponentConstants::SERVICE_COMPONENT;
+using cppmicroservices::service::component::ComponentConstants::TRANSITION_THREADS;
 
 namespace cppmicroservices {
 namespace scrimpl {
@@ -52,6 +55,26 @@ void SCRActivator::Start(BundleContext context)
   // Create the Logger object used by this runtime
   logger = std::make_shared<SCRLogger>(context);
   logger->Log(SeverityLevel::LOG_DEBUG, "Starting SCR bundle");
+  // Create the executor for component enable and disable transitions
+  std::size_t transitionThreads = 0;
+  auto threadsProp = context.GetProperty(TRANSITION_THREADS);
+  if (!threadsProp.Empty())
+  {
+    try
+    {
+      transitionThreads = static_cast<std::size_t>((std::max)(any_cast<int>(threadsProp), 1));
+    }
+    catch (...)
+    {
+      logger->Log(SeverityLevel::LOG_WARNING, "Ignoring invalid value of " + TRANSITION_THREADS, std::current_exception());
+    }
+  }
+  componentRuntime.executor = std::make_shared<TransitionExecutor>(transitionThreads);
+  // Create the tracker which counts component activations and runs the idle
+  // timeouts of all delayed components
+  componentRuntime.activationTracker = std::make_shared<ActivationTracker>();
+  // Create the graph used to report reference cycles when bundles are loaded
+  componentRuntime.dependencyGraph = std::make_shared<DependencyGraph>();
   // Add bundle listener
   bundleListenerToken = context.AddBundleListener(std::bind(&SCRActivator::BundleChanged, this, std::placeholders::_1));
   // HACK: Workaround for lack of Bundle Tracker. Iterate over all bundles and call the tracker method manually
@@ -64,7 +87,7 @@ void SCRActivator::Start(BundleContext context)
     }
   }
   // Publish ServiceComponentRuntimeService
-  auto service = std::make_shared<ServiceComponentRuntimeImpl>(runtimeContext, componentRegistry, logger);
+  auto service = std::make_shared<ServiceComponentRuntimeImpl>(runtimeContext, componentRegistry, logger, componentRuntime);
   scrServiceReg = context.RegisterService<ServiceComponentRuntime>(std::move(service));
 }
 
@@ -89,6 +112,13 @@ void SCRActivator::Stop(cppmicroservices::BundleContext context)
     }
     // clear component registry
     componentRegistry->Clear();
+    // wait for the remaining transitions. Component managers which are still
+    // referenced elsewhere keep the executor alive, their later transitions
+    // run on the calling thread.
+    componentRuntime.executor->Shutdown();
+    componentRuntime.executor.reset();
+    // discard the idle timeouts of the disposed components
+    componentRuntime.activationTracker.reset();
     logger->Log(SeverityLevel::LOG_DEBUG, "SCR Bundle stopped.");
   }
   catch (...)
@@ -120,7 +150,7 @@ void SCRActivator::CreateExtension(const cppmicroservices::Bundle& bundle)
     try
     {
       auto const& scrMap = ref_any_cast<cppmicroservices::AnyMap>(headers.at(SERVICE_COMPONENT));
-      auto ba = std::make_unique<SCRBundleExtension>(bundle.GetBundleContext(), scrMap, componentRegistry, logger);
+      auto ba = std::make_unique<SCRBundleExtension>(bundle.GetBundleContext(), scrMap, componentRegistry, logger, componentRuntime);
       {
         std::lock_guard<std::mutex> l(bundleRegMutex);
         bundleRegistry.insert(std::make_pair(bundle.GetBundleId(),std::move(ba)));
@@ -31,6 +31,7 @@
 #include "ComponentRegistry.hpp"
 #include "SCRBundleExtension.hpp"
 #include "SCRLogger.hpp"
+#include "manager/ComponentRuntimeContext.hpp"
 
 using cppmicroservices::service::component::runtime::ServiceComponentRuntime;
 
@@ -73,6 +74,7 @@ private:
   std::mutex bundleRegMutex;
   std::unordered_map<long, std::unique_ptr<SCRBundleExtension>> bundleRegistry;
   std::shared_ptr<SCRLogger> logger;
+  ComponentRuntimeContext componentRuntime; ///< the transition executor and activation tracker shared by all components
   ListenerToken bundleListenerToken;
 };
 } // scrimpl
@@ -21,13 +21,19 @@
   =============================================================================*/
 
 #include "SCRBundleExtension.hpp"
+#include "cppmicroservices/BundleResource.h"
+#include "cppmicroservices/BundleResourceStream.h"
 #include "cppmicroservices/SharedLibraryException.h"
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "manager/ComponentManagerImpl.hpp"
 #include "metadata/ComponentMetadata.hpp"
 #include "metadata/MetadataParser.hpp"
 #include "metadata/MetadataParserFactory.hpp"
+#include "DependencyGraph.hpp"
+#include "metadata/MetadataTableReader.hpp"
 #include "metadata/Util.hpp"
+#include <exception>
+#include <utility>
 
 using cppmicroservices::service::component::ComponentConstants::SERVICE_COMPONENT;
 
@@ -39,10 +45,13 @@ using util::ObjectValidator;
 SCRBundleExtension::SCRBundleExtension(const cppmicroservices::BundleContext& bundleContext,
                                        const cppmicroservices::AnyMap& scrMetadata,
                                        const std::shared_ptr<ComponentRegistry>& registry,
-                                       const std::shared_ptr<LogService>& logger)
+                                       const std::shared_ptr<LogService>& logger,
+                                       const ComponentRuntimeContext& runtime)
   : bundleContext(bundleContext)
   , registry(registry)
   , logger(logger)
+  , executor(runtime.executor)
+  , dependencyGraph(runtime.dependencyGraph)
 {
   if(!bundleContext || !registry || !logger || scrMetadata.empty())
   {
@@ -51,21 +60,46 @@ SCRBundleExtension::SCRBundleExtension(const cppmicroservices::BundleContext& bu
 
   auto version = ObjectValidator(scrMetadata, "version").GetValue<int>();
   auto metadataparser = metadata::MetadataParserFactory::Create(version, logger);
+  // all components of the bundle share the table of factory functions
+  auto bundleRuntime = runtime;
+  bundleRuntime.factoryTable = GetComponentFactoryTable(bundleContext.GetBundle());
   std::vector<std::shared_ptr<ComponentMetadata>> componentsMetadata;
-  componentsMetadata = metadataparser->ParseAndGetComponentsMetadata(scrMetadata);
+  // use the metadata serialized by SCRCodeGen into the bundle resources,
+  // which saves parsing and validating the manifest. It is read from the
+  // resource container, so the bundle binary is not loaded here.
+  try
+  {
+    auto tableResource = bundleContext.GetBundle().GetResource(metadata::COMPONENT_METADATA_RESOURCE);
+    if(tableResource.IsValid() && version == 1)
+    {
+      BundleResourceStream table(tableResource, std::ios_base::binary);
+      componentsMetadata = metadata::CreateComponentsMetadata(table, scrMetadata);
+    }
+  }
+  catch (const std::exception&)
+  {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+                "Failed to read the precompiled component metadata of bundle "
+                + bundleContext.GetBundle().GetSymbolicName(),
+                std::current_exception());
+    componentsMetadata.clear();
+  }
+  if(componentsMetadata.empty())
+  {
+    componentsMetadata = metadataparser->ParseAndGetComponentsMetadata(scrMetadata);
+  }
+  // start the initialization of all components before waiting for any of
+  // them, so that the components are enabled concurrently
+  std::vector<std::shared_ptr<ComponentManager>> compManagers;
   for (auto& oneCompMetadata : componentsMetadata)
   {
     try
     {
-      auto compManager = std::make_shared<ComponentManagerImpl>(oneCompMetadata,
-                                                                registry,
-                                                                bundleContext,
-                                                                logger);
-      if(registry->AddComponentManager(compManager))
-      {
-        managers.push_back(compManager);
-        compManager->Initialize();
-      }
+      compManagers.push_back(std::make_shared<ComponentManagerImpl>(oneCompMetadata,
+                                                                    registry,
+                                                                    bundleContext,
+                                                                    logger,
+                                                                    bundleRuntime));
     } catch (const cppmicroservices::SharedLibraryException&) {
       throw;
     } catch (const std::exception&) {
@@ -74,6 +108,65 @@ SCRBundleExtension::SCRBundleExtension(const cppmicroservices::BundleContext& bu
                   std::current_exception());
     }
   }
+  // the components of the bundle are published in the registry together.
+  // AddComponentManagers inserts all of them or none, so if it fails the
+  // components are added one by one and only the failing ones are dropped.
+  try
+  {
+    managers = registry->AddComponentManagers(compManagers);
+  } catch (const std::exception&) {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                "Failed to add the components from bundle with Id " + std::to_string(bundleContext.GetBundle().GetBundleId()) + " together, adding them one by one",
+                std::current_exception());
+    for (auto& compManager : compManagers)
+    {
+      try
+      {
+        if(registry->AddComponentManager(compManager))
+        {
+          managers.push_back(compManager);
+        }
+      } catch (const std::exception&) {
+        logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
+                    "Failed to add component with name " + compManager->GetName() + " from bundle with Id " + std::to_string(bundleContext.GetBundle().GetBundleId()),
+                    std::current_exception());
+      }
+    }
+  }
+  std::vector<std::pair<std::shared_ptr<ComponentManagerImpl>, std::shared_future<void>>> initializations;
+  for (auto& compManager : managers)
+  {
+    auto compManagerImpl = std::static_pointer_cast<ComponentManagerImpl>(compManager);
+    initializations.emplace_back(compManagerImpl, compManagerImpl->InitializeAsync());
+  }
+
+  // reference cycles are detected once, when the components are loaded.
+  // Only the part of the graph reachable from this bundle is visited.
+  if(dependencyGraph && !managers.empty())
+  {
+    dependencyGraph->Add(managers);
+  }
+  LogReferenceCycles();
+
+  std::exception_ptr sharedLibraryError;
+  for (auto& initialization : initializations)
+  {
+    try
+    {
+      initialization.first->WaitForInitialization(initialization.second);
+    } catch (const cppmicroservices::SharedLibraryException&) {
+      if(!sharedLibraryError)
+      {
+        sharedLibraryError = std::current_exception();
+      }
+    }
+  }
+  if(sharedLibraryError)
+  {
+    // the destructor is not called for a failed construction
+    DisposeManagers();
+    std::rethrow_exception(sharedLibraryError);
+  }
   logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
               "Created instance of SCRBundleExtension for " + bundleContext.GetBundle().GetSymbolicName());
 }
@@ -82,15 +175,66 @@ SCRBundleExtension::~SCRBundleExtension()
 {
   logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
               "Deleting instance of SCRBundleExtension for " + bundleContext.GetBundle().GetSymbolicName());
-  for(auto compManager : managers)
+  DisposeManagers();
+  registry.reset();
+};
+
+void SCRBundleExtension::LogReferenceCycles() const
+{
+  if(!dependencyGraph || managers.empty())
+  {
+    return;
+  }
+  for(const auto& cycle : dependencyGraph->FindCycles(managers))
+  {
+    std::string names;
+    for(const auto& compManager : cycle)
+    {
+      names += (names.empty() ? "" : ", ") + compManager->GetName()
+               + " (bundle id " + std::to_string(compManager->GetBundleId()) + ")";
+    }
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                "The mandatory references of the components " + names + " form a cycle. "
+                "These components are only satisfied if a service they reference is "
+                "registered by a component or bundle outside of the cycle.");
+  }
+}
+
+void SCRBundleExtension::DisposeManagers()
+{
+  // disable all components before waiting for any of them
+  std::vector<std::shared_future<void>> futures;
+  futures.reserve(managers.size());
+  for(auto& compManager : managers)
+  {
+    futures.push_back(compManager->Disable());
+  }
+  if(!managers.empty())
   {
-    auto fut = compManager->Disable();
-    registry->RemoveComponentManager(compManager);
-    fut.get(); // since this happens when the bundle is stopped. Wait until the disable is finished on the other thread.
+    registry->RemoveComponentManagers(managers);
+    if(dependencyGraph)
+    {
+      dependencyGraph->Remove(managers);
+    }
+  }
+  // since this happens when the bundle is stopped. Wait until the disable is finished on the other threads.
+  for(std::size_t i = 0; i < futures.size(); ++i)
+  {
+    try
+    {
+      if(executor)
+      {
+        executor->Wait(futures[i]);
+      }
+      futures[i].get();
+    } catch (...) {
+      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR,
+                  "Failed to disable component with name " + managers[i]->GetName(),
+                  std::current_exception());
+    }
   }
   managers.clear();
-  registry.reset();
-};
+}
 } // scrimpl
 } // cppmicroservices
 
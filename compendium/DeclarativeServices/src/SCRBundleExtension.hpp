@@ -28,6 +28,7 @@
 #include "cppmicroservices/BundleContext.h"
 #include "ComponentRegistry.hpp"
 #include "manager/ComponentManager.hpp"
+#include "manager/ComponentRuntimeContext.hpp"
 #include "cppmicroservices/logservice/LogService.hpp"
 #include "metadata/Util.hpp"
 
@@ -47,7 +48,8 @@ public:
   SCRBundleExtension(const cppmicroservices::BundleContext& bundleContext,
                      const cppmicroservices::AnyMap& scrMetadata,
                      const std::shared_ptr<ComponentRegistry>& registry,
-                     const std::shared_ptr<LogService>& logger);
+                     const std::shared_ptr<LogService>& logger,
+                     const ComponentRuntimeContext& runtime = {});
   SCRBundleExtension(const SCRBundleExtension&) = delete;
   SCRBundleExtension(SCRBundleExtension&&) = delete;
   SCRBundleExtension& operator=(const SCRBundleExtension&) = delete;
@@ -56,9 +58,23 @@ public:
 private:
   FRIEND_TEST(SCRBundleExtensionTest, CtorWithValidArgs);
 
+  /**
+   * Disables all component managers created by this object, removes them
+   * from the registry and waits until they are disabled.
+   */
+  void DisposeManagers();
+
+  /**
+   * Logs a warning for each cycle of mandatory references in the dependency
+   * graph of the runtime which contains a component of this bundle.
+   */
+  void LogReferenceCycles() const;
+
   cppmicroservices::BundleContext bundleContext;
   std::shared_ptr<ComponentRegistry> registry;
   std::shared_ptr<LogService> logger;
+  std::shared_ptr<TransitionExecutor> executor;
+  std::shared_ptr<DependencyGraph> dependencyGraph;
   std::vector<std::shared_ptr<ComponentManager>> managers;
 };
 } // scrimpl
@@ -96,10 +96,12 @@ ReferenceDTO ToDTO(const ReferenceMetadata& refData)
 
 ServiceComponentRuntimeImpl::ServiceComponentRuntimeImpl(cppmicroservices::BundleContext context,
                                                          std::shared_ptr<ComponentRegistry> componentRegistry,
-                                                         std::shared_ptr<cppmicroservices::logservice::LogService> logger)
+                                                         std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                                                         ComponentRuntimeContext runtime)
   : scrContext(std::move(context))
   , registry(std::move(componentRegistry))
   , logger(std::move(logger))
+  , runtime(std::move(runtime))
 {
   if(!scrContext || !registry || !(this->logger))
   {
@@ -180,6 +182,31 @@ std::shared_future<void> ServiceComponentRuntimeImpl::DisableComponent(const Com
   return holder->Disable();
 }
 
+TransitionStatisticsDTO ServiceComponentRuntimeImpl::GetTransitionStatistics() const
+{
+  TransitionStatisticsDTO stats = {};
+  if(const auto& executor = runtime.executor)
+  {
+    stats.queued = executor->GetQueuedCount();
+    stats.running = executor->GetRunningCount();
+    stats.threads = executor->GetThreadCount();
+  }
+  return stats;
+}
+
+ActivationStatisticsDTO ServiceComponentRuntimeImpl::GetActivationStatistics() const
+{
+  ActivationStatisticsDTO stats = {};
+  if(const auto& activationTracker = runtime.activationTracker)
+  {
+    stats.activations = activationTracker->GetActivationCount();
+    stats.deactivations = activationTracker->GetDeactivationCount();
+    stats.idleDeactivations = activationTracker->GetIdleDeactivationCount();
+    stats.pendingIdleDeactivations = activationTracker->GetScheduledCount();
+  }
+  return stats;
+}
+
 ComponentDescriptionDTO ServiceComponentRuntimeImpl::CreateDTO(const std::shared_ptr<ComponentManager>& compManager) const
 {
   ComponentDescriptionDTO compDescription = {};
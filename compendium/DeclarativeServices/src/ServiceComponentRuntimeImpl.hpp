@@ -27,12 +27,15 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/servicecomponent/runtime/ServiceComponentRuntime.hpp"
 #include "ComponentRegistry.hpp"
+#include "manager/ComponentRuntimeContext.hpp"
 
 using cppmicroservices::service::component::runtime::ServiceComponentRuntime;
 using cppmicroservices::service::component::runtime::dto::ComponentDescriptionDTO;
 using cppmicroservices::service::component::runtime::dto::ComponentConfigurationDTO;
 using cppmicroservices::service::component::runtime::dto::SatisfiedReferenceDTO;
 using cppmicroservices::service::component::runtime::dto::UnsatisfiedReferenceDTO;
+using cppmicroservices::service::component::runtime::dto::TransitionStatisticsDTO;
+using cppmicroservices::service::component::runtime::dto::ActivationStatisticsDTO;
 
 namespace cppmicroservices {
 namespace scrimpl {
@@ -48,7 +51,8 @@ class ServiceComponentRuntimeImpl final
 public:
   ServiceComponentRuntimeImpl(cppmicroservices::BundleContext context,
                               std::shared_ptr<ComponentRegistry> componentRegistry,
-                              std::shared_ptr<cppmicroservices::logservice::LogService> logger);
+                              std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                              ComponentRuntimeContext runtime = {});
   ~ServiceComponentRuntimeImpl() override = default;
   ServiceComponentRuntimeImpl(const ServiceComponentRuntimeImpl&) = delete;
   ServiceComponentRuntimeImpl& operator=(const ServiceComponentRuntimeImpl&) = delete;
@@ -112,6 +116,20 @@ public:
    * any of the known components in the runtime.
    */
   std::shared_future<void> DisableComponent(const ComponentDescriptionDTO& description) override;
+
+  /**
+   * This method returns the number of queued and running transitions of the
+   * executor shared by all component managers of this runtime.
+   * See {@code ServiceComponentRuntime#GetTransitionStatistics}
+   */
+  TransitionStatisticsDTO GetTransitionStatistics() const override;
+
+  /**
+   * This method returns the counters of the activation tracker shared by
+   * all component configurations of this runtime.
+   * See {@code ServiceComponentRuntime#GetActivationStatistics}
+   */
+  ActivationStatisticsDTO GetActivationStatistics() const override;
 private:
   FRIEND_TEST(ServiceComponentRuntimeImplTest, Validate_Ctor);
 
@@ -123,6 +141,7 @@ private:
   cppmicroservices::BundleContext scrContext;
   std::shared_ptr<ComponentRegistry> registry;
   std::shared_ptr<cppmicroservices::logservice::LogService> logger;
+  ComponentRuntimeContext runtime; ///< the executor and activation tracker reported in the statistics
 };
 } // scrimpl
 } // cppmicroservices
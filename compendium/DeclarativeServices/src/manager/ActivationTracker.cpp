@@ -0,0 +1,153 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "ActivationTracker.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+ActivationTracker::ActivationTracker(std::chrono::milliseconds tick,
+                                     std::size_t slotCount)
+  : tick((std::max)(tick, std::chrono::milliseconds(1)))
+  , slots((std::max)(slotCount, std::size_t(1)))
+{
+}
+
+ActivationTracker::~ActivationTracker()
+{
+  assert(thread.get_id() != std::this_thread::get_id() && "ActivationTracker destroyed by one of its own tasks");
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopping = true;
+  }
+  cond.notify_all();
+  if(thread.joinable())
+  {
+    thread.join();
+  }
+}
+
+ActivationTracker::TimerId ActivationTracker::Schedule(std::chrono::milliseconds delay,
+                                                       std::function<void()> task)
+{
+  // the wheel advances at most one tick after the timer was scheduled,
+  // so one more tick is needed to never expire before the delay elapsed
+  const auto ticks = (delay.count() > 0 ? static_cast<std::size_t>(delay.count() / tick.count()) : 0) + 2;
+  bool notify = false;
+  TimerId id = 0;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    if(timers.empty())
+    {
+      nextTick = std::chrono::steady_clock::now() + tick;
+      notify = true;
+    }
+    if(!thread.joinable())
+    {
+      thread = std::thread(&ActivationTracker::Run, this);
+    }
+    id = ++nextId;
+    const auto slotIndex = (currentSlot + ticks) % slots.size();
+    auto& slot = slots[slotIndex];
+    slot.push_back(Timer{ id, (ticks - 1) / slots.size(), std::move(task) });
+    timers.emplace(id, std::make_pair(slotIndex, std::prev(slot.end())));
+  }
+  if(notify)
+  {
+    cond.notify_all();
+  }
+  return id;
+}
+
+bool ActivationTracker::Cancel(TimerId id)
+{
+  std::function<void()> task; // destroyed after the lock is released
+  std::lock_guard<std::mutex> lock(mtx);
+  auto iter = timers.find(id);
+  if(iter == timers.end())
+  {
+    return false;
+  }
+  task = std::move(iter->second.second->task);
+  slots[iter->second.first].erase(iter->second.second);
+  timers.erase(iter);
+  return true;
+}
+
+std::size_t ActivationTracker::GetScheduledCount() const
+{
+  std::lock_guard<std::mutex> lock(mtx);
+  return timers.size();
+}
+
+void ActivationTracker::Run()
+{
+  std::unique_lock<std::mutex> lock(mtx);
+  while(true)
+  {
+    cond.wait(lock, [this]() { return stopping || !timers.empty(); });
+    if(stopping || cond.wait_until(lock, nextTick, [this]() { return stopping; }))
+    {
+      return;
+    }
+    nextTick += tick;
+    currentSlot = (currentSlot + 1) % slots.size();
+    std::vector<std::function<void()>> expired;
+    auto& slot = slots[currentSlot];
+    for(auto iter = slot.begin(); iter != slot.end();)
+    {
+      if(iter->rounds == 0)
+      {
+        expired.push_back(std::move(iter->task));
+        timers.erase(iter->id);
+        iter = slot.erase(iter);
+      }
+      else
+      {
+        --iter->rounds;
+        ++iter;
+      }
+    }
+    if(expired.empty())
+    {
+      continue;
+    }
+    lock.unlock();
+    for(auto& task : expired)
+    {
+      try
+      {
+        task();
+      }
+      catch(...)
+      {
+        // the tasks log their own errors, keep the other timers running
+      }
+    }
+    expired.clear();
+    lock.lock();
+  }
+}
+}
+}
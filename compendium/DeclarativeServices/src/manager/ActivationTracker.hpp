@@ -0,0 +1,145 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __ACTIVATIONTRACKER_HPP__
+#define __ACTIVATIONTRACKER_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+/**
+ * Counts the activations and deactivations of the component instances of
+ * a runtime and runs the idle timeouts of delayed components.
+ *
+ * All idle timeouts share a single hashed timing wheel which is driven by
+ * one thread. The thread is created when the first timeout is scheduled
+ * and only wakes up once per tick while timeouts are pending. Scheduling
+ * and cancelling a timeout are constant time operations.
+ */
+class ActivationTracker
+{
+public:
+  using TimerId = std::uint64_t;
+
+  /**
+   * \param tick is the resolution of the idle timeouts. A timeout never
+   *        expires before its delay elapsed, and at most two ticks later.
+   * \param slotCount is the number of slots of the timing wheel
+   */
+  explicit ActivationTracker(std::chrono::milliseconds tick = std::chrono::milliseconds(100),
+                             std::size_t slotCount = 512);
+  ActivationTracker(const ActivationTracker&) = delete;
+  ActivationTracker(ActivationTracker&&) = delete;
+  ActivationTracker& operator=(const ActivationTracker&) = delete;
+  ActivationTracker& operator=(ActivationTracker&&) = delete;
+
+  /**
+   * Discards the pending timeouts and joins the timer thread. Must not
+   * be called from a timeout task.
+   */
+  ~ActivationTracker();
+
+  /**
+   * Schedules \c task to run on the timer thread once \c delay elapsed.
+   *
+   * \return an identifier which can be passed to #Cancel
+   */
+  TimerId Schedule(std::chrono::milliseconds delay, std::function<void()> task);
+
+  /**
+   * Cancels the timeout with the given identifier. Does nothing if the
+   * timeout already expired or was cancelled.
+   *
+   * \return \c true if the timeout was pending, \c false otherwise
+   */
+  bool Cancel(TimerId id);
+
+  /**
+   * Returns the number of timeouts which have not expired yet
+   */
+  std::size_t GetScheduledCount() const;
+
+  /**
+   * Called when a component instance is activated
+   */
+  void CountActivation() { ++activations; }
+
+  /**
+   * Called when a component instance is deactivated
+   *
+   * \param idle is \c true if the instance was deactivated because its
+   *        idle timeout expired
+   */
+  void CountDeactivation(bool idle)
+  {
+    ++deactivations;
+    if(idle)
+    {
+      ++idleDeactivations;
+    }
+  }
+
+  std::size_t GetActivationCount() const { return activations.load(); }
+  std::size_t GetDeactivationCount() const { return deactivations.load(); }
+  std::size_t GetIdleDeactivationCount() const { return idleDeactivations.load(); }
+
+private:
+  struct Timer
+  {
+    TimerId id;
+    std::size_t rounds; ///< number of full turns of the wheel left before the timer expires
+    std::function<void()> task;
+  };
+  using Slot = std::list<Timer>;
+
+  void Run();
+
+  const std::chrono::milliseconds tick;
+  std::vector<Slot> slots;
+  std::unordered_map<TimerId, std::pair<std::size_t, Slot::iterator>> timers; ///< slot index and position of the pending timers
+  std::size_t currentSlot{ 0 };
+  std::chrono::steady_clock::time_point nextTick; ///< time at which the wheel advances to the next slot
+  TimerId nextId{ 0 };
+  mutable std::mutex mtx; ///< protects the wheel and #stopping
+  std::condition_variable cond; ///< signalled when the first timer is scheduled or the tracker stops
+  bool stopping{ false };
+  std::thread thread;
+
+  std::atomic<std::size_t> activations{ 0 };
+  std::atomic<std::size_t> deactivations{ 0 };
+  std::atomic<std::size_t> idleDeactivations{ 0 };
+};
+}
+}
+
+#endif /* __ACTIVATIONTRACKER_HPP__ */
@@ -23,7 +23,6 @@
 #include "cppmicroservices/SharedLibraryException.h"
 
 #include "BundleLoader.hpp"
-#include <regex>
 #if defined(_WIN32)
 #  include <Windows.h>
 #else
@@ -55,83 +54,170 @@ std::wstring UTF8StrToWStr(const std::string& inStr)
 }
 #endif
 
-std::tuple<std::function<ComponentInstance*(void)>,
-           std::function<void(ComponentInstance*)>>
-GetComponentCreatorDeletors(const std::string& compName,
-                            const cppmicroservices::Bundle& fromBundle)
+namespace {
+
+using NewInstanceFunc = ComponentFactoryTable::NewInstanceFunc;
+using DeleteInstanceFunc = ComponentFactoryTable::DeleteInstanceFunc;
+
+void* OpenBundleBinary(const cppmicroservices::Bundle& fromBundle)
 {
-  // cannot use bundle id as key because id is reused when the framework is restarted.
-  // strings are not optimal but will work fine as long as a binary is not unloaded
-  // from the process.
-  // Note: This code is a temporary hack until the core framework supports Bundle#load API.
-  static Guarded<std::map<std::string, void*>>
-    bundleBinaries; ///< map of bundle location and handle pairs
-  const auto bundleLoc = fromBundle.GetLocation();
-
-  void* handle = nullptr;
-  if (bundleBinaries.lock()->count(bundleLoc) != 0u) {
-    handle = bundleBinaries.lock()->at(bundleLoc);
-  } else {
 #if defined(_WIN32)
-    std::wstring bundlePathWstr = UTF8StrToWStr(fromBundle.GetLocation());
-    handle = reinterpret_cast<void*>(LoadLibraryW(bundlePathWstr.c_str()));
-    if (handle == nullptr) {
-      std::error_code err_code(GetLastError(), std::generic_category());
-      std::string errMsg("Unable to load bundle binary ");
-      errMsg += fromBundle.GetLocation();
-      errMsg += ". Error: ";
-      errMsg += std::to_string(GetLastError());
-      throw cppmicroservices::SharedLibraryException(
-        err_code, std::move(errMsg), std::move(fromBundle));
-    }
+  std::wstring bundlePathWstr = UTF8StrToWStr(fromBundle.GetLocation());
+  void* handle = reinterpret_cast<void*>(LoadLibraryW(bundlePathWstr.c_str()));
+  if (handle == nullptr) {
+    std::error_code err_code(GetLastError(), std::generic_category());
+    std::string errMsg("Unable to load bundle binary ");
+    errMsg += fromBundle.GetLocation();
+    errMsg += ". Error: ";
+    errMsg += std::to_string(GetLastError());
+    throw cppmicroservices::SharedLibraryException(
+      err_code, std::move(errMsg), fromBundle);
+  }
 #else
-    handle = dlopen(fromBundle.GetLocation().c_str(), RTLD_LAZY | RTLD_LOCAL);
-    if (handle == nullptr) {
-      std::error_code err_code(errno, std::generic_category());
-      std::string errMsg("Unable to load bundle binary ");
-      errMsg += fromBundle.GetLocation();
-      errMsg += ". Error: ";
-      const char* dlErrMsg = dlerror();
-      errMsg += (dlErrMsg) ? dlErrMsg : "none";
-      throw cppmicroservices::SharedLibraryException(
-        err_code, std::move(errMsg), std::move(fromBundle));
-    }
+  void* handle = dlopen(fromBundle.GetLocation().c_str(), RTLD_LAZY | RTLD_LOCAL);
+  if (handle == nullptr) {
+    std::error_code err_code(errno, std::generic_category());
+    std::string errMsg("Unable to load bundle binary ");
+    errMsg += fromBundle.GetLocation();
+    errMsg += ". Error: ";
+    const char* dlErrMsg = dlerror();
+    errMsg += (dlErrMsg) ? dlErrMsg : "none";
+    throw cppmicroservices::SharedLibraryException(
+      err_code, std::move(errMsg), fromBundle);
+  }
 #endif
-    bundleBinaries.lock()->emplace(bundleLoc, handle);
+  return handle;
+}
+
+void* FindSymbol(void* handle, const std::string& name)
+{
+#if defined(_WIN32)
+  return reinterpret_cast<void*>(
+    GetProcAddress(reinterpret_cast<HMODULE>(handle), name.c_str()));
+#else
+  return dlsym(handle, name.c_str());
+#endif
+}
+
+/// Returns the component name with all occurrences of "::" replaced by "_"
+std::string GetSymbolSuffix(const std::string& compName)
+{
+  std::string suffix;
+  suffix.reserve(compName.size());
+  for (std::size_t i = 0; i < compName.size(); ++i) {
+    if (compName[i] == ':' && i + 1 < compName.size() &&
+        compName[i + 1] == ':') {
+      suffix += '_';
+      ++i;
+    } else {
+      suffix += compName[i];
+    }
+  }
+  return suffix;
+}
+}
+
+void ComponentFactoryTable::Load(const cppmicroservices::Bundle& fromBundle)
+{
+  std::lock_guard<std::mutex> lock(loadMutex);
+  if (loaded.load(std::memory_order_relaxed)) {
+    return;
+  }
+  handle = OpenBundleBinary(fromBundle);
+
+  using GetFactoriesFunc =
+    const service::component::detail::ComponentInstanceFactory* (*)();
+  const std::string tableFuncName =
+    US_STR(US_SCR_COMPONENT_FACTORIES_PREFIX) + fromBundle.GetSymbolicName();
+  if (auto sym = FindSymbol(handle, tableFuncName)) {
+    auto getFactories = reinterpret_cast<GetFactoriesFunc>(sym); // NOLINT
+    for (auto entry = getFactories(); entry && entry->name != nullptr;
+         ++entry) {
+      factories.emplace(
+        entry->name, std::make_pair(entry->newInstance, entry->deleteInstance));
+    }
+  }
+  loaded.store(true, std::memory_order_release);
+}
+
+std::tuple<std::function<ComponentInstance*(void)>,
+           std::function<void(ComponentInstance*)>>
+ComponentFactoryTable::GetCreatorDeletors(
+  const std::string& compName,
+  const cppmicroservices::Bundle& fromBundle)
+{
+  if (!loaded.load(std::memory_order_acquire)) {
+    Load(fromBundle);
+  }
+
+  auto factory = factories.find(compName);
+  if (factory != factories.end()) {
+    return std::make_tuple(factory->second.first, factory->second.second);
+  }
+
+  // the bundle was built without the factory table
+  auto resolvedFactories = resolved.lock();
+  auto resolvedFactory = resolvedFactories->find(compName);
+  if (resolvedFactory != resolvedFactories->end()) {
+    return std::make_tuple(resolvedFactory->second.first,
+                           resolvedFactory->second.second);
   }
 
-  const std::string symbolName =
-    std::regex_replace(compName, std::regex("::"), "_");
+  const std::string symbolName = GetSymbolSuffix(compName);
   const std::string newInstanceFuncName("NewInstance_" + symbolName);
   const std::string deleteInstanceFuncName("DeleteInstance_" + symbolName);
-#if defined(_WIN32)
-  void* sym = reinterpret_cast<void*>(GetProcAddress(
-    reinterpret_cast<HMODULE>(handle), newInstanceFuncName.c_str()));
-  void* delsym = reinterpret_cast<void*>(GetProcAddress(
-    reinterpret_cast<HMODULE>(handle), deleteInstanceFuncName.c_str()));
+  void* sym = FindSymbol(handle, newInstanceFuncName);
+  void* delsym = FindSymbol(handle, deleteInstanceFuncName);
   if (sym == nullptr || delsym == nullptr) {
     std::string errMsg("Unable to find entry-point functions in bundle ");
     errMsg += fromBundle.GetLocation();
+#if defined(_WIN32)
     errMsg += ". Error code: ";
     errMsg += std::to_string(GetLastError());
-    throw std::runtime_error(errMsg);
-  }
 #else
-  void* sym = dlsym(handle, newInstanceFuncName.c_str());
-  void* delsym = dlsym(handle, deleteInstanceFuncName.c_str());
-  if (sym == nullptr || delsym == nullptr) {
-    std::string errMsg("Unable to find entry-point functions in bundle ");
-    errMsg += fromBundle.GetLocation();
     errMsg += ". Error: ";
     const char* dlErrMsg = dlerror();
     errMsg += (dlErrMsg) ? dlErrMsg : "none";
+#endif
     throw std::runtime_error(errMsg);
   }
-#endif
 
-  return std::make_tuple(
-    reinterpret_cast<ComponentInstance* (*)(void)>(sym),     // NOLINT
-    reinterpret_cast<void (*)(ComponentInstance*)>(delsym)); // NOLINT
+  auto newInstance = reinterpret_cast<NewInstanceFunc>(sym);          // NOLINT
+  auto deleteInstance = reinterpret_cast<DeleteInstanceFunc>(delsym); // NOLINT
+  resolvedFactories->emplace(compName,
+                             std::make_pair(newInstance, deleteInstance));
+  return std::make_tuple(newInstance, deleteInstance);
+}
+
+std::shared_ptr<ComponentFactoryTable> GetComponentFactoryTable(
+  const cppmicroservices::Bundle& fromBundle)
+{
+  // cannot use bundle id as key because id is reused when the framework is restarted.
+  // strings are not optimal but will work fine as long as a binary is not unloaded
+  // from the process. The symbolic name is part of the key because bundles
+  // linked into the same binary share a location.
+  // Note: This code is a temporary hack until the core framework supports Bundle#load API.
+  static Guarded<std::map<std::pair<std::string, std::string>,
+                          std::shared_ptr<ComponentFactoryTable>>>
+    factoryTables; ///< map of bundle location and symbolic name to factory tables
+  auto key =
+    std::make_pair(fromBundle.GetLocation(), fromBundle.GetSymbolicName());
+
+  auto tables = factoryTables.lock();
+  auto& table = (*tables)[std::move(key)];
+  if (!table) {
+    table = std::make_shared<ComponentFactoryTable>();
+  }
+  return table;
+}
+
+std::tuple<std::function<ComponentInstance*(void)>,
+           std::function<void(ComponentInstance*)>>
+GetComponentCreatorDeletors(const std::string& compName,
+                            const cppmicroservices::Bundle& fromBundle)
+{
+  return GetComponentFactoryTable(fromBundle)->GetCreatorDeletors(compName,
+                                                                  fromBundle);
 }
 }
 }
@@ -25,7 +25,10 @@
 
 #include "ConcurrencyUtil.hpp"
 #include "cppmicroservices/servicecomponent/detail/ComponentInstance.hpp"
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 using cppmicroservices::service::component::detail::ComponentInstance;
 //typedef ComponentInstance*(*NewComponentInstanceFuncPtr)();
@@ -33,6 +36,65 @@ using cppmicroservices::service::component::detail::ComponentInstance;
 
 namespace cppmicroservices {
 namespace scrimpl {
+
+/**
+ * The extern C helper functions used to create and delete
+ * {@link ComponentInstance} objects of all components in a bundle.
+ *
+ * The bundle binary is loaded on the first lookup. If the bundle exports the
+ * factory table generated by SCRCodeGen, all entry points are read from it
+ * at once and later lookups do not take a lock. For bundles without the
+ * table, the entry points of each component are looked up and cached on
+ * first use.
+ */
+class ComponentFactoryTable
+{
+public:
+  using NewInstanceFunc = ComponentInstance* (*)();
+  using DeleteInstanceFunc = void (*)(ComponentInstance*);
+
+  ComponentFactoryTable() = default;
+  ComponentFactoryTable(const ComponentFactoryTable&) = delete;
+  ComponentFactoryTable(ComponentFactoryTable&&) = delete;
+  ComponentFactoryTable& operator=(const ComponentFactoryTable&) = delete;
+  ComponentFactoryTable& operator=(ComponentFactoryTable&&) = delete;
+
+  /**
+   * Returns the helper functions used to create and delete instances of a
+   * component.
+   *
+   * \param compName is a unique identifier for the component
+   * \param fromBundle is the bundle where the component is located. Must be
+   *        the bundle this table was obtained for.
+   *
+   * \throws See #GetComponentCreatorDeletors
+   */
+  std::tuple<std::function<ComponentInstance*(void)>,
+             std::function<void(ComponentInstance*)>>
+  GetCreatorDeletors(const std::string& compName,
+                     const cppmicroservices::Bundle& fromBundle);
+
+private:
+  void Load(const cppmicroservices::Bundle& fromBundle);
+
+  std::atomic<bool> loaded{ false };
+  std::mutex loadMutex; ///< serializes the loading of the bundle binary
+  void* handle = nullptr; ///< the bundle binary, written once while loading
+  std::unordered_map<std::string, std::pair<NewInstanceFunc, DeleteInstanceFunc>>
+    factories; ///< entries of the generated factory table, immutable once loaded
+  Guarded<std::unordered_map<std::string, std::pair<NewInstanceFunc, DeleteInstanceFunc>>>
+    resolved; ///< entry points looked up by name for components missing from #factories
+};
+
+/**
+ * Returns the factory table of the given bundle. All callers asking for the
+ * same bundle share one table.
+ *
+ * \param fromBundle is the bundle whose components are looked up
+ */
+std::shared_ptr<ComponentFactoryTable> GetComponentFactoryTable(
+  const cppmicroservices::Bundle& fromBundle);
+
 /**
  * Method to load and find the extern C helper functions used to create and
  * delete {@link ComponentInstance} objects associated with a component from
@@ -28,8 +28,9 @@ namespace scrimpl {
 BundleOrPrototypeComponentConfigurationImpl::BundleOrPrototypeComponentConfigurationImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                                                                                          const cppmicroservices::Bundle& bundle,
                                                                                          std::shared_ptr<const ComponentRegistry> registry,
-                                                                                         std::shared_ptr<cppmicroservices::logservice::LogService> logger)
-  : ComponentConfigurationImpl(metadata, bundle, registry, logger)
+                                                                                         std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                                                                                         const ComponentRuntimeContext& runtime)
+  : ComponentConfigurationImpl(metadata, bundle, registry, logger, runtime)
 {
 }
 
@@ -90,6 +91,10 @@ void BundleOrPrototypeComponentConfigurationImpl::DeactivateComponentInstance(co
                      std::current_exception());
   }
   instCtxt.second->Invalidate();
+  if(auto tracker = GetActivationTracker())
+  {
+    tracker->CountDeactivation(/*idle=*/false);
+  }
 }
 
 InterfaceMapConstPtr BundleOrPrototypeComponentConfigurationImpl::GetService(const cppmicroservices::Bundle& bundle,
@@ -42,7 +42,8 @@ public:
   explicit BundleOrPrototypeComponentConfigurationImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                                                        const cppmicroservices::Bundle& bundle,
                                                        std::shared_ptr<const ComponentRegistry> registry,
-                                                       std::shared_ptr<cppmicroservices::logservice::LogService> logger);
+                                                       std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                                                       const ComponentRuntimeContext& runtime = {});
   BundleOrPrototypeComponentConfigurationImpl(const BundleOrPrototypeComponentConfigurationImpl&) = delete;
   BundleOrPrototypeComponentConfigurationImpl(BundleOrPrototypeComponentConfigurationImpl&&) = delete;
   BundleOrPrototypeComponentConfigurationImpl& operator=(const BundleOrPrototypeComponentConfigurationImpl&) = delete;
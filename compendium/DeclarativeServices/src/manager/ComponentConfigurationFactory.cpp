@@ -30,7 +30,8 @@ namespace scrimpl {
 std::shared_ptr<ComponentConfigurationImpl> ComponentConfigurationFactory::CreateConfigurationManager(std::shared_ptr<const metadata::ComponentMetadata> compDesc,
                                                                                                       const cppmicroservices::Bundle& bundle,
                                                                                                       std::shared_ptr<const ComponentRegistry> registry,
-                                                                                                      std::shared_ptr<logservice::LogService> logger)
+                                                                                                      std::shared_ptr<logservice::LogService> logger,
+                                                                                                      const ComponentRuntimeContext& runtime)
 {
   std::shared_ptr<ComponentConfigurationImpl> retVal;
   std::string scope = compDesc->serviceMetadata.scope;
@@ -39,7 +40,8 @@ std::shared_ptr<ComponentConfigurationImpl> ComponentConfigurationFactory::Creat
     retVal = std::make_shared<SingletonComponentConfigurationImpl>(compDesc,
                                                                    bundle,
                                                                    registry,
-                                                                   logger);
+                                                                   logger,
+                                                                   runtime);
   }
   else if (scope == cppmicroservices::Constants::SCOPE_BUNDLE ||
            scope == cppmicroservices::Constants::SCOPE_PROTOTYPE)
@@ -47,7 +49,8 @@ std::shared_ptr<ComponentConfigurationImpl> ComponentConfigurationFactory::Creat
     retVal = std::make_shared<BundleOrPrototypeComponentConfigurationImpl>(compDesc,
                                                                            bundle,
                                                                            registry,
-                                                                           logger);
+                                                                           logger,
+                                                                           runtime);
   }
   if(retVal)
   {
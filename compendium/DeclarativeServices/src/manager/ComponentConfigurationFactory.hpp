@@ -39,7 +39,8 @@ public:
   static std::shared_ptr<ComponentConfigurationImpl> CreateConfigurationManager(std::shared_ptr<const metadata::ComponentMetadata> compDesc,
                                                                                 const cppmicroservices::Bundle& bundle,
                                                                                 std::shared_ptr<const ComponentRegistry> registry,
-                                                                                std::shared_ptr<logservice::LogService> logger);
+                                                                                std::shared_ptr<logservice::LogService> logger,
+                                                                                const ComponentRuntimeContext& runtime = {});
 };
 }
 }
@@ -22,6 +22,7 @@
 
 #include "ComponentConfigurationImpl.hpp"
 #include <cassert>
+#include <deque>
 #include <iostream>
 
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
@@ -38,17 +39,61 @@ using cppmicroservices::service::component::ComponentConstants::COMPONENT_NAME;
 
 namespace cppmicroservices { namespace scrimpl {
 
+namespace {
+// the queue of satisfaction changes processed by the current thread, if any
+thread_local std::deque<std::function<void()>>* propagationQueue = nullptr;
+
+/**
+ * Processes the given satisfaction change and all changes queued while
+ * processing it, in the order in which they were queued. Changes queued by
+ * a change are processed after it finished, so a component graph is
+ * processed breadth first instead of recursively. An exception thrown by a
+ * change does not prevent the remaining changes from being processed, the
+ * first exception is rethrown when the queue is empty.
+ */
+void ProcessChanges(std::function<void()> change)
+{
+  std::deque<std::function<void()>> queue{ std::move(change) };
+  propagationQueue = &queue;
+  std::exception_ptr firstError;
+  while(!queue.empty())
+  {
+    auto next = std::move(queue.front());
+    queue.pop_front();
+    try
+    {
+      next();
+    }
+    catch(...)
+    {
+      if(!firstError)
+      {
+        firstError = std::current_exception();
+      }
+    }
+  }
+  propagationQueue = nullptr;
+  if(firstError)
+  {
+    std::rethrow_exception(firstError);
+  }
+}
+}
+
 std::atomic<unsigned long> ComponentConfigurationImpl::idCounter(0);
 
 ComponentConfigurationImpl::ComponentConfigurationImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata
                                                        , const Bundle& bundle
                                                        , std::shared_ptr<const ComponentRegistry> registry
-                                                       , std::shared_ptr<cppmicroservices::logservice::LogService> logger)
+                                                       , std::shared_ptr<cppmicroservices::logservice::LogService> logger
+                                                       , const ComponentRuntimeContext& runtime)
   : configID(++idCounter)
   , metadata(std::move(metadata))
   , bundle(bundle)
   , registry(std::move(registry))
   , logger(std::move(logger))
+  , factoryTable(runtime.factoryTable)
+  , activationTracker(runtime.activationTracker)
   , state(std::make_shared<CCUnsatisfiedReferenceState>())
   , newCompInstanceFunc(nullptr)
   , deleteCompInstanceFunc(nullptr)
@@ -56,7 +101,8 @@ ComponentConfigurationImpl::ComponentConfigurationImpl(std::shared_ptr<const met
   if(!this->metadata || !this->bundle || !this->registry || !this->logger) {
     throw std::invalid_argument("ComponentConfigurationImpl - Invalid arguments passed to constructor");
   }
-  
+  properties = CreateProperties();
+
   auto const& serviceMetadata = this->metadata->serviceMetadata;
   if(!serviceMetadata.interfaces.empty()) {
     regManager = std::make_unique<RegistrationManager>(bundle.GetBundleContext(),
@@ -79,6 +125,7 @@ ComponentConfigurationImpl::~ComponentConfigurationImpl()
 
 void ComponentConfigurationImpl::Stop()
 {
+  stopped = true;
   std::for_each(referenceManagerTokens.begin()
                 , referenceManagerTokens.end()
                 , [](const std::unordered_map<std::shared_ptr<ReferenceManager>, ListenerTokenId>::value_type& kvpair){
@@ -92,10 +139,17 @@ void ComponentConfigurationImpl::Stop()
 }
 
 std::unordered_map<std::string, cppmicroservices::Any> ComponentConfigurationImpl::GetProperties() const {
-  auto props = metadata->properties;
-  props.emplace(COMPONENT_NAME, Any(this->metadata->name));
+  return *properties;
+}
+
+std::shared_ptr<const cppmicroservices::ServiceProperties> ComponentConfigurationImpl::CreateProperties() const
+{
+  cppmicroservices::ServiceProperties props;
+  props.reserve(metadata->properties.size() + 2);
+  props.insert(metadata->properties.begin(), metadata->properties.end());
+  props.emplace(COMPONENT_NAME, Any(metadata->name));
   props.emplace(COMPONENT_ID, Any(configID));
-  return props;
+  return std::make_shared<const cppmicroservices::ServiceProperties>(std::move(props));
 }
 
 void ComponentConfigurationImpl::Initialize()
@@ -153,7 +207,7 @@ ServiceReferenceBase ComponentConfigurationImpl::GetServiceReference() const
 bool ComponentConfigurationImpl::RegisterService()
 {
   return (regManager
-          ? regManager->RegisterService(GetFactory(), GetProperties())
+          ? regManager->RegisterService(GetFactory(), properties)
           : false);
 }
 
@@ -164,42 +218,61 @@ void ComponentConfigurationImpl::UnregisterService()
   }
 }
 
-class SatisfiedFunctor
+void ComponentConfigurationImpl::RefSatisfied(const std::string& refName)
 {
-public:
-  SatisfiedFunctor(std::string skipKeyName) : state(true), skipKey(std::move(skipKeyName)) {}
-  SatisfiedFunctor(const SatisfiedFunctor& cpy) = default;
-  SatisfiedFunctor(SatisfiedFunctor&& cpy) = default;
-  SatisfiedFunctor& operator=(const SatisfiedFunctor& cpy) = default;
-  SatisfiedFunctor& operator=(SatisfiedFunctor&& cpy) = default;
-  ~SatisfiedFunctor() = default;
-  bool IsSatisfied() const { return(state); }
-  void operator () (const std::unordered_map<std::string, std::shared_ptr<ReferenceManager>>::value_type& item)
+  auto refManager = referenceManagers.find(refName);
+  if(refManager == referenceManagers.end())
   {
-    if(skipKey.empty() || item.first != skipKey) {
-      state = state && item.second->IsSatisfied();
-    }
+    return;
   }
-private:
-  bool state;
-  std::string skipKey;
-};
-
-void ComponentConfigurationImpl::RefSatisfied(const std::string& refName)
-{
-  SatisfiedFunctor f = std::for_each(referenceManagers.begin(), referenceManagers.end(), SatisfiedFunctor(refName));
-  if(f.IsSatisfied()) {
-    GetState()->Register(*this);
+  {
+    auto satisfiedRefsHandle = satisfiedRefs.lock();
+    if(satisfiedRefsHandle->count(refName) != 0u)
+    {
+      return;
+    }
+    // a notification may arrive after the reference became unsatisfied
+    // again. Only the sender is asked, the other references are counted
+    // by their own notifications.
+    if(!refManager->second->IsSatisfied())
+    {
+      return;
+    }
+    satisfiedRefsHandle->insert(refName);
+    if(satisfiedRefsHandle->size() < referenceManagers.size())
+    {
+      return;
+    }
   }
+  PropagateChange([this]() {
+    // a reference may have become unsatisfied while the change was queued
+    if(!stopped && satisfiedRefs.lock()->size() == referenceManagers.size())
+    {
+      GetState()->Register(*this);
+    }
+  });
 }
 
 void ComponentConfigurationImpl::RefUnsatisfied(const std::string& refName)
 {
   if(referenceManagers.count(refName) != 0u) {
+    satisfiedRefs.lock()->erase(refName);
     // the state of the rest of the dependency managers is irrelevant.
     // deactivate the configuration
-    GetState()->Deactivate(*this);
+    PropagateChange([this]() { GetState()->Deactivate(*this); });
+  }
+}
+
+void ComponentConfigurationImpl::PropagateChange(std::function<void()> change)
+{
+  if(propagationQueue != nullptr)
+  {
+    // keep this configuration alive until the queued change is processed
+    auto self = shared_from_this();
+    propagationQueue->emplace_back([self, change]() { change(); });
+    return;
   }
+  ProcessChanges(std::move(change));
 }
 
 void ComponentConfigurationImpl::Register()
@@ -217,6 +290,11 @@ void ComponentConfigurationImpl::Deactivate()
   GetState()->Deactivate(*this);
 }
 
+void ComponentConfigurationImpl::DeactivateIdle()
+{
+  GetState()->DeactivateIdle(*this);
+}
+
 ComponentState ComponentConfigurationImpl::GetConfigState() const
 {
   return GetState()->GetValue();
@@ -238,7 +316,8 @@ void ComponentConfigurationImpl::LoadComponentCreatorDestructor()
 {
   if(newCompInstanceFunc == nullptr || deleteCompInstanceFunc == nullptr) {
     const auto compName = GetMetadata()->name.empty() ? GetMetadata()->implClassName : GetMetadata()->name;
-    std::tie(newCompInstanceFunc, deleteCompInstanceFunc) = GetComponentCreatorDeletors(compName, GetBundle());
+    auto table = factoryTable ? factoryTable : GetComponentFactoryTable(GetBundle());
+    std::tie(newCompInstanceFunc, deleteCompInstanceFunc) = table->GetCreatorDeletors(compName, GetBundle());
   }
 }
 
@@ -254,6 +333,10 @@ InstanceContextPair ComponentConfigurationImpl::CreateAndActivateComponentInstan
   auto ctxt = std::make_shared<ComponentContextImpl>(shared_from_this(), bundle);
   componentInstance->CreateInstanceAndBindReferences(ctxt);
   componentInstance->Activate();
+  if(auto tracker = GetActivationTracker())
+  {
+    tracker->CountActivation();
+  }
   return std::make_pair(componentInstance, ctxt);
 }
 
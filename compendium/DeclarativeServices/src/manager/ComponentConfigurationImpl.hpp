@@ -23,12 +23,17 @@
 #ifndef __COMPONENTCONFIGURATIONIMPL_HPP__
 #define __COMPONENTCONFIGURATIONIMPL_HPP__
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <unordered_set>
 #include "gtest/gtest_prod.h"
 #include "cppmicroservices/ServiceFactory.h"
 #include "cppmicroservices/logservice/LogService.hpp"
 #include "cppmicroservices/servicecomponent/detail/ComponentInstance.hpp"
 #include "ComponentConfiguration.hpp"
+#include "ComponentRuntimeContext.hpp"
+#include "ConcurrencyUtil.hpp"
 #include "../ComponentContextImpl.hpp"
 #include "../metadata/ComponentMetadata.hpp"
 #include "ReferenceManager.hpp"
@@ -53,12 +58,18 @@ class ComponentConfigurationImpl
 {
 public:
   /**
-   * \throws std::invalid_argument exception if any of the params is a nullptr 
+   * \param runtime provides the table of component factory functions of
+   *        \c bundle and the activation tracker, see {@link ComponentRuntimeContext}.
+   *        The executor is not used by a configuration.
+   *
+   * \throws std::invalid_argument exception if any of the params except
+   *         \c runtime is a nullptr
    */
   explicit ComponentConfigurationImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                                       const Bundle& bundle,
                                       std::shared_ptr<const ComponentRegistry> registry,
-                                      std::shared_ptr<cppmicroservices::logservice::LogService> logger);
+                                      std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                                      const ComponentRuntimeContext& runtime = {});
   ComponentConfigurationImpl(const ComponentConfigurationImpl&) = delete;
   ComponentConfigurationImpl(ComponentConfigurationImpl&&) = delete;
   ComponentConfigurationImpl& operator=(const ComponentConfigurationImpl&) = delete;
@@ -163,6 +174,15 @@ public:
    */
   virtual void DestroyComponentInstances() = 0;
 
+  /**
+   * Method called when the idle timeout of a delayed component expired.
+   * Subclasses which support idle timeouts must destroy their component
+   * instances unless they are in use.
+   *
+   * \return \c true if the instances were destroyed, \c false otherwise
+   */
+  virtual bool DestroyIdleComponentInstances() { return false; }
+
   /**
    * Method used to kick start the state machine of this configuration
    */
@@ -204,6 +224,13 @@ public:
    */
   void Deactivate();
 
+  /**
+   * Method used to trigger a state change from \c ACTIVE to \c SATISFIED when
+   * the component instance is no longer used.
+   * The call is delegated to the current \c state object
+   */
+  void DeactivateIdle();
+
   /**
    * Method called to stop the service trackers associated with this configuration's reference managers
    */
@@ -225,6 +252,11 @@ protected:
    */
   InstanceContextPair CreateAndActivateComponentInstanceHelper(const cppmicroservices::Bundle& bundle);
 
+  /**
+   * Returns the activation tracker of the runtime, \c nullptr if there is none
+   */
+  std::shared_ptr<ActivationTracker> GetActivationTracker() const { return activationTracker.lock(); }
+
   /**
    * Sets the function pointers used to create and delete a {@link ComponentInstance} object
    */
@@ -267,6 +299,16 @@ private:
    */
   void RefUnsatisfied(const std::string& refName);
 
+  /**
+   * Processes a change of the satisfaction of this configuration. If the
+   * current thread is already processing a change, for example because the
+   * registration of a service satisfied this configuration, the change is
+   * queued and processed after the current change finished. Changes which
+   * cascade through a component graph are therefore processed breadth first
+   * on one thread, without recursion.
+   */
+  void PropagateChange(std::function<void()> change);
+
   /**
    * Method is responsible for loading the bundle and populating the function
    * objects \c newCompInstanceFunc & \c deleteCompInstanceFunc used to create
@@ -287,19 +329,32 @@ private:
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyConcurrentRegisterDeactivate);
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyConcurrentActivateDeactivate);
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyRefSatisfied);
+  FRIEND_TEST(ComponentConfigurationImplTest, VerifyStaleRefSatisfied);
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyRefUnsatisfied);
   FRIEND_TEST(ComponentConfigurationImplTest, VerifyStateChangeDelegation);
   FRIEND_TEST(ComponentConfigurationImplTest, TestGetDependencyManagers);
 
+  /**
+   * Returns the properties of this component configuration, which are the
+   * properties from the component description along with
+   * \c ComponentConstants::COMPONENT_NAME and \c ComponentConstants::COMPONENT_ID
+   */
+  std::shared_ptr<const cppmicroservices::ServiceProperties> CreateProperties() const;
+
   unsigned long configID; ///< unique Id for the component configuration
   static std::atomic<unsigned long> idCounter; ///< used to assign unique identifiers to component configurations
   const std::shared_ptr<const metadata::ComponentMetadata> metadata; ///< component description
   Bundle bundle; ///< bundle this component configuration belongs to
   const std::shared_ptr<const ComponentRegistry> registry; ///< component registry of the runtime
   const std::shared_ptr<cppmicroservices::logservice::LogService> logger; ///< logger used for reporting errors/execptions
+  const std::shared_ptr<ComponentFactoryTable> factoryTable; ///< factory functions of the components in #bundle
+  const std::weak_ptr<ActivationTracker> activationTracker; ///< not owned, so that a configuration released by a timeout task never destroys the tracker on its own thread
+  std::shared_ptr<const cppmicroservices::ServiceProperties> properties; ///< built once, shared with every registration of the service
   std::unique_ptr<RegistrationManager> regManager; ///< registration manager used to manage registration/unregistration of the service provided by this component
   std::unordered_map<std::string, std::shared_ptr<ReferenceManager>> referenceManagers; ///< map of all the reference managers
   std::unordered_map<std::shared_ptr<ReferenceManager>, ListenerTokenId> referenceManagerTokens; ///< map of the listener tokens received from the reference managers
+  Guarded<std::unordered_set<std::string>> satisfiedRefs; ///< names of the references which are satisfied. The references not in this set are the unsatisfied ones, the configuration is satisfied once it contains all references.
+  std::atomic<bool> stopped{ false }; ///< set when the configuration stops tracking its references
   std::shared_ptr<ComponentConfigurationState> state; ///< only modified using std::atomic operations
 
   std::function<ComponentInstance*(void)> newCompInstanceFunc; ///< extern C function to create a new instance {@link ComponentInstance} class from the component's bundle
@@ -31,14 +31,28 @@
 namespace cppmicroservices {
 namespace scrimpl {
 
+namespace {
+// a component manager created outside of a runtime gets its own single threaded executor
+ComponentRuntimeContext WithExecutor(ComponentRuntimeContext runtime)
+{
+  if(!runtime.executor)
+  {
+    runtime.executor = std::make_shared<TransitionExecutor>(1);
+  }
+  return runtime;
+}
+}
+
 ComponentManagerImpl::ComponentManagerImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                                            std::shared_ptr<const ComponentRegistry> registry,
                                            BundleContext bundleContext,
-                                           std::shared_ptr<cppmicroservices::logservice::LogService> logger)
+                                           std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                                           ComponentRuntimeContext runtime)
   : registry(std::move(registry))
   , compDesc(std::move(metadata))
   , bundleContext(std::move(bundleContext))
   , logger(std::move(logger))
+  , runtime(WithExecutor(std::move(runtime)))
   , state(std::make_shared<CMDisabledState>())
 {
   if(!compDesc || !this->registry || !this->bundleContext || !this->logger)
@@ -49,11 +63,12 @@ ComponentManagerImpl::ComponentManagerImpl(std::shared_ptr<const metadata::Compo
 
 ComponentManagerImpl::~ComponentManagerImpl()
 {
-  GetState()->Disable(*this);
+  Disable();
   for(auto& fut : disableFutures)
   {
     try
     {
+      runtime.executor->Wait(fut);
       fut.get();
     }
     catch(...)
@@ -65,17 +80,28 @@ ComponentManagerImpl::~ComponentManagerImpl()
 
 void ComponentManagerImpl::Initialize()
 {
-  if(compDesc->enabled)
+  WaitForInitialization(InitializeAsync());
+}
+
+std::shared_future<void> ComponentManagerImpl::InitializeAsync()
+{
+  return compDesc->enabled ? Enable() : std::shared_future<void>();
+}
+
+void ComponentManagerImpl::WaitForInitialization(const std::shared_future<void>& fut)
+{
+  if(!fut.valid()) // the component is initially disabled
   {
-    auto fut = Enable();
-    try
-    {
-      fut.get();
-    } catch (const cppmicroservices::SharedLibraryException&) {
-      throw;
-    } catch (...) {
-      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR, "Failed to enable component with name" + GetName(), std::current_exception());
-    }
+    return;
+  }
+  try
+  {
+    runtime.executor->Wait(fut);
+    fut.get();
+  } catch (const cppmicroservices::SharedLibraryException&) {
+    throw;
+  } catch (...) {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR, "Failed to enable component with name" + GetName(), std::current_exception());
   }
 }
 
@@ -86,11 +112,13 @@ bool ComponentManagerImpl::IsEnabled() const
 
 std::shared_future<void> ComponentManagerImpl::Enable()
 {
+  std::lock_guard<std::mutex> lk(transitionMutex);
   return GetState()->Enable(*this);
 }
 
 std::shared_future<void> ComponentManagerImpl::Disable()
 {
+  std::lock_guard<std::mutex> lk(transitionMutex);
   return GetState()->Disable(*this);
 }
 
@@ -27,6 +27,7 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/logservice/LogService.hpp"
 #include "ComponentManager.hpp"
+#include "ComponentRuntimeContext.hpp"
 
 namespace cppmicroservices {
 namespace scrimpl {
@@ -46,7 +47,8 @@ public:
   ComponentManagerImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                        std::shared_ptr<const ComponentRegistry> registry,
                        cppmicroservices::BundleContext bundleContext,
-                       std::shared_ptr<cppmicroservices::logservice::LogService> logger);
+                       std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                       ComponentRuntimeContext runtime = {});
   ComponentManagerImpl(const ComponentManagerImpl&) = delete;
   ComponentManagerImpl(ComponentManagerImpl&&) = delete;
   ComponentManagerImpl& operator=(const ComponentManagerImpl&) = delete;
@@ -55,9 +57,31 @@ public:
 
   /**
    * Initialization method used to kick start the state machine implemented by this class.
+   * Equivalent to calling #WaitForInitialization with the result of #InitializeAsync.
    */
   void Initialize();
 
+  /**
+   * Enables the component if it is enabled in the component description.
+   * The method returns after the state change without waiting for the
+   * resulting configurations. This allows the caller to start the
+   * initialization of several components before waiting for them.
+   *
+   * \return the future of the initial transition, or an invalid future if
+   *         the component is initially disabled
+   */
+  std::shared_future<void> InitializeAsync();
+
+  /**
+   * Waits for the initial transition started by #InitializeAsync. Errors
+   * are logged.
+   *
+   * \param fut is the future returned from #InitializeAsync
+   * \throws cppmicroservices::SharedLibraryException if the component's
+   *         shared library could not be loaded
+   */
+  void WaitForInitialization(const std::shared_future<void>& fut);
+
   /** @copydoc ComponentManager::IsEnabled()
    * Delegates the call to the current state object
    */
@@ -104,6 +128,21 @@ public:
   std::shared_ptr<cppmicroservices::logservice::LogService> GetLogger() const
   { return logger; }
 
+  /**
+   * Returns the executor which runs the enable and disable transitions of
+   * this ComponentManager
+   */
+  std::shared_ptr<TransitionExecutor> GetExecutor() const
+  { return runtime.executor; }
+
+  /**
+   * Returns the collaborators of the runtime which contains the component,
+   * passed on to the component configurations. The executor is never
+   * \c nullptr.
+   */
+  const ComponentRuntimeContext& GetRuntimeContext() const
+  { return runtime; }
+
   /**
    * This method modifies the vector of futures stored in this object. If
    * any of the futures in the vector are ready, the ready future is replaced
@@ -140,9 +179,11 @@ private:
   const std::shared_ptr<const metadata::ComponentMetadata> compDesc; ///< the component description
   cppmicroservices::BundleContext bundleContext; ///< context of the bundle which contains the component
   const std::shared_ptr<cppmicroservices::logservice::LogService> logger; ///< logger associated with the current runtime
+  const ComponentRuntimeContext runtime; ///< collaborators of the current runtime, with the executor always set
   std::shared_ptr<ComponentManagerState> state; ///< This member is always accessed using atomic operations
   std::vector<std::shared_future<void>> disableFutures; ///< futures created when the component transitioned to \c DISABLED state
   std::mutex futuresMutex; ///< mutex to protect the #disableFutures member
+  std::mutex transitionMutex; ///< submits the transitions to the executor of the #runtime in the order of the state changes, so that a transition never waits for a transition queued after it
 };
 }
 }
@@ -0,0 +1,64 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __COMPONENTRUNTIMECONTEXT_HPP__
+#define __COMPONENTRUNTIMECONTEXT_HPP__
+
+#include "ActivationTracker.hpp"
+#include "BundleLoader.hpp"
+#include "TransitionExecutor.hpp"
+
+#include <memory>
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+class DependencyGraph;
+
+/**
+ * The collaborators a component manager and its configurations get from the
+ * runtime. The object is handed down from the {@link SCRBundleExtension} to
+ * the component configurations once, instead of passing each member through
+ * every constructor on the way.
+ *
+ * All members are optional. A component created outside of a runtime, for
+ * example in a test, falls back to the behavior described for each member.
+ */
+struct ComponentRuntimeContext
+{
+  /// runs the enable and disable transitions of the components. If \c nullptr,
+  /// each component manager uses its own single threaded executor.
+  std::shared_ptr<TransitionExecutor> executor;
+  /// factory functions of the components of the bundle. If \c nullptr, the
+  /// table is looked up when the first instance is created.
+  std::shared_ptr<ComponentFactoryTable> factoryTable;
+  /// counts the activations and schedules the idle timeouts. If \c nullptr,
+  /// nothing is counted and instances are not deactivated when idle.
+  std::shared_ptr<ActivationTracker> activationTracker;
+  /// the mandatory references of the components of all loaded bundles. If
+  /// \c nullptr, reference cycles are not reported.
+  std::shared_ptr<DependencyGraph> dependencyGraph;
+};
+}
+}
+
+#endif // __COMPONENTRUNTIMECONTEXT_HPP__
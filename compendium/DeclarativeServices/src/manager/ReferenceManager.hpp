@@ -78,7 +78,7 @@ public:
    * This method returns the service scope specified in the component
    * description for the reference managed by this object.
    */
-  virtual std::string GetReferenceScope() const = 0;
+  virtual metadata::ReferenceScope GetReferenceScope() const = 0;
 
   /**
    * This method returns the target string specified in the component
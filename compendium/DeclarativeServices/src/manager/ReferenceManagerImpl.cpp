@@ -27,7 +27,6 @@
 
 using cppmicroservices::logservice::SeverityLevel;
 using cppmicroservices::service::component::ComponentConstants::COMPONENT_NAME;
-using cppmicroservices::service::component::ComponentConstants::REFERENCE_SCOPE_PROTOTYPE_REQUIRED;
 using cppmicroservices::Constants::SERVICE_SCOPE;
 using cppmicroservices::Constants::SCOPE_PROTOTYPE;
 
@@ -48,7 +47,7 @@ LDAPFilter GetReferenceLDAPFilter(const metadata::ReferenceMetadata& refMetadata
     expr &= LDAPPropExpr(refMetadata.target);
   }
 
-  if(refMetadata.scope == REFERENCE_SCOPE_PROTOTYPE_REQUIRED)
+  if(metadata::ParseReferenceScope(refMetadata.scope) == metadata::ReferenceScope::PrototypeRequired)
   {
     expr &= (LDAPProp(SERVICE_SCOPE) ==  SCOPE_PROTOTYPE);
   }
@@ -60,6 +59,8 @@ ReferenceManagerImpl::ReferenceManagerImpl(const metadata::ReferenceMetadata& me
                                            std::shared_ptr<cppmicroservices::logservice::LogService> logger,
                                            const std::string& configName)
   : metadata(metadata)
+  , policyOption(scrimpl::metadata::ParseReferencePolicyOption(metadata.policyOption))
+  , scope(scrimpl::metadata::ParseReferenceScope(metadata.scope))
   , tracker(nullptr)
   , logger(std::move(logger))
   , configName(configName)
@@ -130,6 +131,19 @@ ReferenceManagerImpl::~ReferenceManagerImpl()
 struct dummyRefObj {
 };
 
+namespace {
+/**
+ * Returns the object handed to the ServiceTracker for every tracked service.
+ * The tracker only needs a non-null object, so a single shared instance avoids
+ * allocating one for each service event.
+ */
+const cppmicroservices::InterfaceMapConstPtr& GetTrackedServiceObject()
+{
+  static const cppmicroservices::InterfaceMapConstPtr trackedServiceObject = MakeInterfaceMap<dummyRefObj>(std::make_shared<dummyRefObj>());
+  return trackedServiceObject;
+}
+}
+
 bool ReferenceManagerImpl::UpdateBoundRefs()
 {
   auto matchedRefsHandle = matchedRefs.lock(); // acquires lock on matchedRefs
@@ -178,7 +192,7 @@ void ReferenceManagerImpl::ServiceAdded(const cppmicroservices::ServiceReference
   // auto becomesSatisfied = false;
   auto replacementNeeded = false;
   auto notifySatisfied = false;
-  auto serviceIdToUnbind = -1;
+  auto unbindRequired = false;
 
   if(!IsSatisfied())
   {
@@ -186,7 +200,7 @@ void ReferenceManagerImpl::ServiceAdded(const cppmicroservices::ServiceReference
   }
   else // previously satisfied
   {
-    if (metadata.policyOption == "greedy")
+    if (policyOption == metadata::ReferencePolicyOption::Greedy)
     {
       auto boundRefsHandle = boundRefs.lock(); // acquire lock on boundRefs
       if (boundRefsHandle->find(reference) == boundRefsHandle->end()) // reference is not bound yet
@@ -197,7 +211,7 @@ void ReferenceManagerImpl::ServiceAdded(const cppmicroservices::ServiceReference
           if (minBound < reference)
           {
             replacementNeeded = true;
-            serviceIdToUnbind = GetServiceId(minBound);
+            unbindRequired = true;
           }
         }
         else
@@ -215,7 +229,7 @@ void ReferenceManagerImpl::ServiceAdded(const cppmicroservices::ServiceReference
     notifications.push_back(std::move(notification));
     // The following "clear and copy" strategy is sufficient for
     // updating the boundRefs for static binding policy
-    if(0 < serviceIdToUnbind)
+    if(unbindRequired)
     {
       auto boundRefsHandle = boundRefs.lock();
       boundRefsHandle->clear();
@@ -241,8 +255,8 @@ cppmicroservices::InterfaceMapConstPtr ReferenceManagerImpl::AddingService(const
   // ASSUMPTION: If there is no component configuration name then its assumed this service was not registered by
   // DS and could not satisfy itself since it is not managed by DS.
   auto const compConfigName = reference.GetProperty(COMPONENT_NAME);
-  if ((!compConfigName.Empty() && configName != compConfigName.ToStringNoExcept()) ||
-    compConfigName.Empty()) { 
+  auto const compConfigNameStr = any_cast<std::string>(&compConfigName);
+  if (compConfigNameStr == nullptr || configName != *compConfigNameStr) {
     // acquire lock on matchedRefs
     auto matchedRefsHandle = matchedRefs.lock();
     matchedRefsHandle->insert(reference);
@@ -257,7 +271,7 @@ cppmicroservices::InterfaceMapConstPtr ReferenceManagerImpl::AddingService(const
 
   // A non-null object must be returned to indicate to the ServiceTracker that
   // we are tracking the service and need to be called back when the service is removed.
-  return MakeInterfaceMap<dummyRefObj>(std::make_shared<dummyRefObj>());
+  return GetTrackedServiceObject();
 }
 
 void ReferenceManagerImpl::ModifiedService(const cppmicroservices::ServiceReference<void>& /*reference*/,
@@ -336,18 +350,21 @@ std::atomic<cppmicroservices::ListenerTokenId> ReferenceManagerImpl::tokenCounte
  */
 cppmicroservices::ListenerTokenId ReferenceManagerImpl::RegisterListener(std::function<void(const RefChangeNotification&)> notify)
 {
+  // add the listener before checking the reference, so that it is notified
+  // if the reference becomes satisfied concurrently. The listener may be
+  // notified twice in this case.
+  cppmicroservices::ListenerTokenId retToken = ++tokenCounter;
+  {
+    auto listenerMapHandle = listenersMap.lock();
+    listenerMapHandle->emplace(retToken, notify);
+  }
+
   auto notifySatisfied = UpdateBoundRefs();
   if(notifySatisfied)
   {
     RefChangeNotification notification { metadata.name, RefEvent::BECAME_SATISFIED };
     notify(notification);
   }
-
-  cppmicroservices::ListenerTokenId retToken = ++tokenCounter;
-  {
-    auto listenerMapHandle = listenersMap.lock();
-    listenerMapHandle->emplace(retToken, notify);
-  }
   return retToken;
 }
 
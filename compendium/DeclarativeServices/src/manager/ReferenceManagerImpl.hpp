@@ -69,9 +69,9 @@ public:
   std::string GetReferenceName() const override { return metadata.name; }
 
   /**
-   * Returns name of the reference as specified in component description
+   * Returns scope of the reference as specified in component description
    */
-  std::string GetReferenceScope() const override { return metadata.scope; }
+  metadata::ReferenceScope GetReferenceScope() const override { return scope; }
 
   /**
    * Returns \c LDAPString specifying the match criteria for this dependency
@@ -191,6 +191,8 @@ private:
   void BatchNotifyAllListeners(const std::vector<RefChangeNotification>& notification) noexcept;
 
   const metadata::ReferenceMetadata metadata; ///< reference information from the component description
+  const metadata::ReferencePolicyOption policyOption; ///< policy option parsed from #metadata
+  const metadata::ReferenceScope scope; ///< scope parsed from #metadata
   std::unique_ptr<ServiceTracker<void>> tracker; ///< used to track service availability
   std::shared_ptr<cppmicroservices::logservice::LogService> logger; ///< logger for this runtime
   const std::string configName; ///< Keep track of which component configuration object this reference manager belongs to.
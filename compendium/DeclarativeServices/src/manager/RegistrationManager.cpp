@@ -75,6 +75,16 @@ bool RegistrationManager::IsServiceRegistered() const
 
 bool RegistrationManager::RegisterService(const std::shared_ptr<cppmicroservices::ServiceFactory>& factory,
                                           const cppmicroservices::ServiceProperties& props)
+{
+  if(IsServiceRegistered())
+  {
+    return true;
+  }
+  return RegisterService(factory, std::make_shared<const cppmicroservices::ServiceProperties>(props));
+}
+
+bool RegistrationManager::RegisterService(const std::shared_ptr<cppmicroservices::ServiceFactory>& factory,
+                                          const std::shared_ptr<const cppmicroservices::ServiceProperties>& props)
 {
   if(IsServiceRegistered())
   {
@@ -88,9 +98,15 @@ bool RegistrationManager::RegisterService(const std::shared_ptr<cppmicroservices
     {
       imap->emplace(interface, instance);
     }
-    auto localProps = props;
-    localProps.emplace(SERVICE_SCOPE, Any(scope));
-    serviceReg = bundleContext.RegisterService(imap, localProps);
+    // a component is registered again each time it becomes satisfied,
+    // always with the same properties
+    if(props != this->props)
+    {
+      registrationProps = *props;
+      registrationProps.emplace(SERVICE_SCOPE, Any(scope));
+      this->props = props;
+    }
+    serviceReg = bundleContext.RegisterService(imap, registrationProps);
   }
   catch(...)
   {
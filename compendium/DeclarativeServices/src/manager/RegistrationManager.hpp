@@ -89,6 +89,19 @@ public:
   bool RegisterService(const std::shared_ptr<cppmicroservices::ServiceFactory>& factory,
                        const cppmicroservices::ServiceProperties& props);
 
+  /**
+   * Same as RegisterService(const std::shared_ptr<ServiceFactory>&, const ServiceProperties&),
+   * but the properties are shared with the caller. When the service is
+   * registered again with the same properties object, the properties built
+   * for the previous registration are reused.
+   *
+   * \param factory - a {@link ServiceFactory} object used for service registration
+   * \param props - an immutable map with properties used for service registration
+   * \return \c true if registration succeeded, \c false otherwise
+   */
+  bool RegisterService(const std::shared_ptr<cppmicroservices::ServiceFactory>& factory,
+                       const std::shared_ptr<const cppmicroservices::ServiceProperties>& props);
+
   /**
    * This method unregisters the service from the framework service registry. The
    * {@link ServiceRegistration} member of this object is set to null before returning
@@ -104,6 +117,8 @@ private:
   cppmicroservices::BundleContext bundleContext;
   std::vector<std::string> services;
   std::string scope;
+  std::shared_ptr<const cppmicroservices::ServiceProperties> props; ///< properties passed to the last registration
+  cppmicroservices::ServiceProperties registrationProps; ///< #props along with the service scope
   std::shared_ptr<cppmicroservices::logservice::LogService> logger;
 };
 }
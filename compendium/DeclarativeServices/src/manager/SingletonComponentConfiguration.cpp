@@ -40,8 +40,9 @@ namespace scrimpl {
 SingletonComponentConfigurationImpl::SingletonComponentConfigurationImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                                                                          const Bundle& bundle,
                                                                          std::shared_ptr<const ComponentRegistry> registry,
-                                                                         std::shared_ptr<cppmicroservices::logservice::LogService> logger)
-  : ComponentConfigurationImpl(metadata, bundle, registry, logger)
+                                                                         std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                                                                         const ComponentRuntimeContext& runtime)
+  : ComponentConfigurationImpl(metadata, bundle, registry, logger, runtime)
 {
 }
 
@@ -53,6 +54,11 @@ std::shared_ptr<ServiceFactory> SingletonComponentConfigurationImpl::GetFactory(
 
 SingletonComponentConfigurationImpl::~SingletonComponentConfigurationImpl()
 {
+  auto tracker = GetActivationTracker();
+  if(idleTimer != 0 && tracker)
+  {
+    tracker->Cancel(idleTimer);
+  }
   DestroyComponentInstances();
 }
 
@@ -88,12 +94,31 @@ std::shared_ptr<ComponentInstance> SingletonComponentConfigurationImpl::CreateAn
 void SingletonComponentConfigurationImpl::DestroyComponentInstances()
 {
   auto instanceContextPair = data.lock();
+  DestroyComponentInstance(*instanceContextPair, /*idle=*/false);
+}
+
+bool SingletonComponentConfigurationImpl::DestroyIdleComponentInstances()
+{
+  auto instanceContextPair = data.lock();
+  {
+    std::lock_guard<std::mutex> lock(usersMutex);
+    if(!users.empty())
+    {
+      return false;
+    }
+  }
+  DestroyComponentInstance(*instanceContextPair, /*idle=*/true);
+  return true;
+}
+
+void SingletonComponentConfigurationImpl::DestroyComponentInstance(InstanceContextPair& instanceContextPair, bool idle)
+{
   try
   {
-    if(instanceContextPair->first)
+    if(instanceContextPair.first)
     {
-      instanceContextPair->first->Deactivate();
-      instanceContextPair->first->UnbindReferences();
+      instanceContextPair.first->Deactivate();
+      instanceContextPair.first->UnbindReferences();
     }
   }
   catch(...)
@@ -102,28 +127,83 @@ void SingletonComponentConfigurationImpl::DestroyComponentInstances()
                      "Exception received from user code while deactivating the component configuration",
                      std::current_exception());
   }
-  if(instanceContextPair->second)
+  if(instanceContextPair.second)
+  {
+    instanceContextPair.second->Invalidate();
+  }
+  auto tracker = GetActivationTracker();
+  if(instanceContextPair.first && tracker)
+  {
+    tracker->CountDeactivation(idle);
+  }
+  instanceContextPair.first.reset();
+  instanceContextPair.second.reset();
+}
+
+void SingletonComponentConfigurationImpl::IdleTimeoutExpired(std::size_t generation)
+{
   {
-    instanceContextPair->second->Invalidate();
+    std::lock_guard<std::mutex> lock(usersMutex);
+    if(generation != idleGeneration || !users.empty())
+    {
+      return;
+    }
+    idleTimer = 0;
   }
-  instanceContextPair->first.reset();
-  instanceContextPair->second.reset();
+  DeactivateIdle();
 }
 
 InterfaceMapConstPtr SingletonComponentConfigurationImpl::GetService(const cppmicroservices::Bundle& bundle,
                                                                      const cppmicroservices::ServiceRegistrationBase& /*registration*/)
 {
+  if(GetMetadata()->idleTimeout.count() > 0)
+  {
+    // the user is recorded before the activation, so that an idle timeout
+    // which expires concurrently does not destroy the returned instance
+    std::lock_guard<std::mutex> lock(usersMutex);
+    users.insert(bundle.GetBundleId());
+    ++idleGeneration;
+    if(idleTimer != 0)
+    {
+      if(auto tracker = GetActivationTracker())
+      {
+        tracker->Cancel(idleTimer);
+      }
+      idleTimer = 0;
+    }
+  }
   // if activation passed, return the interface map from the instance
   auto compInstance = Activate(bundle);
   return compInstance ? compInstance->GetInterfaceMap() : nullptr;
 }
 
-void SingletonComponentConfigurationImpl::UngetService(const cppmicroservices::Bundle& /*bundle*/,
+void SingletonComponentConfigurationImpl::UngetService(const cppmicroservices::Bundle& bundle,
                                                        const cppmicroservices::ServiceRegistrationBase& /*registration*/,
                                                        const cppmicroservices::InterfaceMapConstPtr& /*service*/)
 {
   // The singleton instance is not reset when UngetService is called.
-  // The instance is reset when the component is deactivated.
+  // The instance is reset when the component is deactivated, or when the
+  // idle timeout of the component expires after the last user released it.
+  const auto idleTimeout = GetMetadata()->idleTimeout;
+  auto tracker = GetActivationTracker();
+  if(idleTimeout.count() <= 0 || !tracker)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(usersMutex);
+  if(users.erase(bundle.GetBundleId()) == 0 || !users.empty() || idleTimer != 0)
+  {
+    return;
+  }
+  std::weak_ptr<SingletonComponentConfigurationImpl> weakThis =
+    std::dynamic_pointer_cast<SingletonComponentConfigurationImpl>(shared_from_this());
+  const auto generation = idleGeneration;
+  idleTimer = tracker->Schedule(idleTimeout, [weakThis, generation]() {
+    if(auto thisPtr = weakThis.lock())
+    {
+      thisPtr->IdleTimeoutExpired(generation);
+    }
+  });
 }
 
 void SingletonComponentConfigurationImpl::SetComponentInstancePair(InstanceContextPair instCtxtPair)
@@ -23,6 +23,10 @@
 #ifndef __SINGLETONCOMPONENTCONFIGURATION_HPP__
 #define __SINGLETONCOMPONENTCONFIGURATION_HPP__
 
+#include <mutex>
+#include <unordered_set>
+
+#include "ActivationTracker.hpp"
 #include "ComponentConfigurationImpl.hpp"
 #include "ConcurrencyUtil.hpp"
 
@@ -42,7 +46,8 @@ public:
   explicit SingletonComponentConfigurationImpl(std::shared_ptr<const metadata::ComponentMetadata> metadata,
                                                const cppmicroservices::Bundle& bundle,
                                                std::shared_ptr<const ComponentRegistry> registry,
-                                               std::shared_ptr<cppmicroservices::logservice::LogService> logger);
+                                               std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                                               const ComponentRuntimeContext& runtime = {});
   SingletonComponentConfigurationImpl(const SingletonComponentConfigurationImpl&) = delete;
   SingletonComponentConfigurationImpl(SingletonComponentConfigurationImpl&&) = delete;
   SingletonComponentConfigurationImpl& operator=(const SingletonComponentConfigurationImpl&) = delete;
@@ -67,6 +72,14 @@ public:
    */
   void DestroyComponentInstances() /* noexcept */ override;
 
+  /**
+   * Method removes the singleton {@link ComponentInstance} object if no bundle
+   * uses the service of this configuration.
+   *
+   * \return \c true if the instance was removed, \c false if it is in use
+   */
+  bool DestroyIdleComponentInstances() /* noexcept */ override;
+
   /**
    * Implements the {@link ServiceFactory#GetService} interface. This method
    * wraps the service implementation object in an {@link InterfaceMapConstPtr}
@@ -77,8 +90,10 @@ public:
                                                     const cppmicroservices::ServiceRegistrationBase& registration) override;
 
   /**
-   * Implements the {@link ServiceFactory#UngetService} interface. No-op since the
-   * service is a \c shared_ptr
+   * Implements the {@link ServiceFactory#UngetService} interface. The instance
+   * is not destroyed when the service is released, since the service is a
+   * \c shared_ptr. If the component has an idle timeout, the instance is
+   * deactivated once no bundle used the service for the duration of the timeout.
    */
   void UngetService(const cppmicroservices::Bundle& bundle,
                     const cppmicroservices::ServiceRegistrationBase& registration,
@@ -89,6 +104,7 @@ private:
   FRIEND_TEST(SingletonComponentConfigurationTest, TestDestroyComponentInstances);
   FRIEND_TEST(SingletonComponentConfigurationTest, TestGetService);
   FRIEND_TEST(SingletonComponentConfigurationTest, TestDestroyComponentInstances_DeactivateFailure);
+  FRIEND_TEST(SingletonComponentConfigurationTest, TestIdleDeactivation);
 
   /**
    * Set the member data, only used in tests
@@ -105,7 +121,22 @@ private:
    */
   std::shared_ptr<ComponentInstance> GetComponentInstance();
 
+  /**
+   * Deactivates, unbinds and removes the given component instance
+   */
+  void DestroyComponentInstance(InstanceContextPair& instanceContextPair, bool idle);
+
+  /**
+   * Deactivates the component instance if no bundle used the service since
+   * the idle timeout with the given generation was scheduled
+   */
+  void IdleTimeoutExpired(std::size_t generation);
+
   Guarded<InstanceContextPair> data; ///< singleton pair of component instance and context associated with this configuration
+  std::mutex usersMutex; ///< protects #users, #idleGeneration and #idleTimer
+  std::unordered_set<long> users; ///< ids of the bundles using the service, only tracked if the component has an idle timeout
+  std::size_t idleGeneration{ 0 }; ///< incremented whenever the service is requested, invalidates expired timeouts which were not cancelled in time
+  ActivationTracker::TimerId idleTimer{ 0 }; ///< the pending idle timeout, zero if there is none
 };
 }
 }
@@ -0,0 +1,265 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "TransitionExecutor.hpp"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+namespace {
+// the executor and worker index of the current thread, if it belongs to an executor
+thread_local const TransitionExecutor* currentExecutor = nullptr;
+thread_local std::size_t currentWorker = (std::numeric_limits<std::size_t>::max)();
+}
+
+TransitionExecutor::TransitionExecutor(std::size_t threadCount)
+{
+  if(threadCount == 0)
+  {
+    threadCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+  }
+  for(std::size_t i = 0; i < threadCount; ++i)
+  {
+    workers.push_back(std::make_unique<Worker>());
+  }
+}
+
+TransitionExecutor::~TransitionExecutor()
+{
+  assert(currentExecutor != this && "TransitionExecutor destroyed by one of its own tasks");
+  Shutdown();
+}
+
+void TransitionExecutor::Shutdown()
+{
+  assert(currentExecutor != this && "TransitionExecutor shut down by one of its own tasks");
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    stopping = true;
+  }
+  wakeCond.notify_all();
+  // tasks on overflow threads may still queue tasks for the workers
+  JoinOverflowThreads();
+  for(auto& worker : workers)
+  {
+    if(worker->thread.joinable())
+    {
+      worker->thread.join();
+    }
+  }
+  JoinOverflowThreads();
+}
+
+std::shared_future<void> TransitionExecutor::Submit(std::function<void()> task)
+{
+  std::packaged_task<void()> packagedTask(std::move(task));
+  auto fut = packagedTask.get_future().share();
+
+  const bool nested = (currentExecutor == this);
+  if(nested && busyWorkers.load() + queued.load() >= workers.size())
+  {
+    RunOnOverflowThread(std::move(packagedTask));
+    return fut;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    // the workers may already have stopped, or an overflow thread may
+    // submit a task after they did, so tasks are run right away
+    if(stopping)
+    {
+      lock.unlock();
+      Execute(packagedTask);
+      return fut;
+    }
+    std::call_once(startFlag, [this]() { Start(); });
+    ++queued;
+  }
+  // tasks submitted by a worker go to its own queue, where idle workers
+  // steal them from the back
+  auto index = (nested && currentWorker < workers.size())
+                 ? currentWorker
+                 : nextWorker++ % workers.size();
+  {
+    auto& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mtx);
+    worker.tasks.push_back(std::move(packagedTask));
+  }
+  wakeCond.notify_one();
+  doneCond.notify_all();
+  return fut;
+}
+
+void TransitionExecutor::Wait(const std::shared_future<void>& fut)
+{
+  if(!fut.valid())
+  {
+    return;
+  }
+  if(currentExecutor != this)
+  {
+    fut.wait();
+    return;
+  }
+  // overflow threads do not own a queue and only steal tasks
+  const auto index = (currentWorker < workers.size()) ? currentWorker : 0;
+  auto isReady = [&fut]() {
+    return fut.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+  };
+  while(!isReady())
+  {
+    std::packaged_task<void()> task;
+    if(TryPop(index, task))
+    {
+      --queued;
+      Execute(task);
+      continue;
+    }
+    // the future becomes ready when one of the tasks of this executor
+    // finished, and the queues only grow when a task is submitted
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    doneCond.wait(lock, [this, &isReady]() { return isReady() || queued.load() > 0; });
+  }
+}
+
+void TransitionExecutor::Start()
+{
+  for(std::size_t i = 0; i < workers.size(); ++i)
+  {
+    workers[i]->thread = std::thread(&TransitionExecutor::Run, this, i);
+  }
+}
+
+void TransitionExecutor::Run(std::size_t index)
+{
+  currentExecutor = this;
+  currentWorker = index;
+  while(true)
+  {
+    std::packaged_task<void()> task;
+    if(TryPop(index, task))
+    {
+      --queued;
+      ++busyWorkers;
+      Execute(task);
+      --busyWorkers;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeCond.wait(lock, [this]() { return stopping || queued.load() > 0; });
+    if(stopping && queued.load() == 0)
+    {
+      return;
+    }
+  }
+}
+
+bool TransitionExecutor::TryPop(std::size_t index, std::packaged_task<void()>& task)
+{
+  {
+    auto& own = *workers[index];
+    std::lock_guard<std::mutex> lock(own.mtx);
+    if(!own.tasks.empty())
+    {
+      task = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      return true;
+    }
+  }
+  for(std::size_t i = 1; i < workers.size(); ++i)
+  {
+    auto& victim = *workers[(index + i) % workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mtx);
+    if(!victim.tasks.empty())
+    {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void TransitionExecutor::Execute(std::packaged_task<void()>& task)
+{
+  ++running;
+  task(); // exceptions are stored in the future of the task
+  --running;
+  {
+    // a thread in #Wait checks its future while holding the mutex, so it
+    // can not miss this notification
+    std::lock_guard<std::mutex> lock(wakeMutex);
+  }
+  doneCond.notify_all();
+}
+
+void TransitionExecutor::RunOnOverflowThread(std::packaged_task<void()> task)
+{
+  std::lock_guard<std::mutex> lock(overflowMutex);
+  // join the overflow threads which already finished their task
+  for(auto it = overflowThreads.begin(); it != overflowThreads.end();)
+  {
+    if(it->done->load())
+    {
+      it->thread.join();
+      it = overflowThreads.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  auto done = std::make_shared<std::atomic<bool>>(false);
+  std::thread thread([this, done](std::packaged_task<void()> t) {
+                       currentExecutor = this;
+                       Execute(t);
+                       done->store(true);
+                     },
+                     std::move(task));
+  overflowThreads.push_back(OverflowThread{ std::move(thread), std::move(done) });
+}
+
+void TransitionExecutor::JoinOverflowThreads()
+{
+  while(true)
+  {
+    // join without holding the lock, the joined threads may start new ones
+    std::list<OverflowThread> threads;
+    {
+      std::lock_guard<std::mutex> lock(overflowMutex);
+      threads.swap(overflowThreads);
+    }
+    if(threads.empty())
+    {
+      return;
+    }
+    for(auto& overflow : threads)
+    {
+      overflow.thread.join();
+    }
+  }
+}
+}
+}
@@ -0,0 +1,157 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef __TRANSITIONEXECUTOR_HPP__
+#define __TRANSITIONEXECUTOR_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+/**
+ * A bounded work-stealing executor used to run the enable and disable
+ * transitions of the component managers.
+ *
+ * Each worker thread owns a task queue. Tasks submitted from other threads
+ * are distributed round-robin over the worker queues. A worker takes tasks
+ * from the front of its own queue and steals tasks from the back of the
+ * other queues when its own queue is empty. The worker threads are created
+ * on the first call to #Submit.
+ *
+ * A transition may wait for the transition of another component manager,
+ * for example when a component activation starts a bundle with components.
+ * If such a nested transition is submitted from a worker thread while no
+ * worker is idle, it is run on an additional thread instead of being queued,
+ * so that the waiting worker can not deadlock the executor. Transitions
+ * must wait for the futures of this executor through #Wait, which runs
+ * queued tasks on the waiting worker until the future is ready.
+ */
+class TransitionExecutor
+{
+public:
+  /**
+   * \param threadCount is the number of worker threads. A value of zero
+   *        uses the number of hardware threads.
+   */
+  explicit TransitionExecutor(std::size_t threadCount = 0);
+  TransitionExecutor(const TransitionExecutor&) = delete;
+  TransitionExecutor(TransitionExecutor&&) = delete;
+  TransitionExecutor& operator=(const TransitionExecutor&) = delete;
+  TransitionExecutor& operator=(TransitionExecutor&&) = delete;
+
+  /**
+   * Calls #Shutdown. Must not be called from a task run by this executor.
+   */
+  ~TransitionExecutor();
+
+  /**
+   * Runs all queued tasks and joins the worker threads. Tasks submitted
+   * once the shutdown started, including those submitted by running tasks,
+   * are run on the submitting thread. Must not be called from a task run
+   * by this executor.
+   */
+  void Shutdown();
+
+  /**
+   * Schedules the given task for execution.
+   *
+   * \param task is the task to run
+   * \return a future which becomes ready when the task finished. An
+   *         exception thrown by the task is stored in the future.
+   */
+  std::shared_future<void> Submit(std::function<void()> task);
+
+  /**
+   * Waits until the given future is ready. If called from a thread of this
+   * executor, queued tasks are run on the calling thread while waiting,
+   * so that a worker waiting for a task queued behind it can not deadlock
+   * the executor.
+   *
+   * \param fut is the future to wait for. An invalid future is ignored.
+   *        A thread of this executor only checks the future when a task
+   *        of this executor finished, so the future must belong to one.
+   */
+  void Wait(const std::shared_future<void>& fut);
+
+  /**
+   * Returns the number of worker threads of this executor
+   */
+  std::size_t GetThreadCount() const { return workers.size(); }
+
+  /**
+   * Returns the number of submitted tasks which have not started yet
+   */
+  std::size_t GetQueuedCount() const { return queued.load(); }
+
+  /**
+   * Returns the number of tasks which are currently running
+   */
+  std::size_t GetRunningCount() const { return running.load(); }
+
+private:
+  struct Worker
+  {
+    std::mutex mtx; ///< protects #tasks
+    std::deque<std::packaged_task<void()>> tasks; ///< tasks owned by this worker
+    std::thread thread;
+  };
+
+  struct OverflowThread
+  {
+    std::thread thread;
+    std::shared_ptr<std::atomic<bool>> done;
+  };
+
+  void Start();
+  void Run(std::size_t index);
+  bool TryPop(std::size_t index, std::packaged_task<void()>& task);
+  void Execute(std::packaged_task<void()>& task);
+  void RunOnOverflowThread(std::packaged_task<void()> task);
+  void JoinOverflowThreads();
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::once_flag startFlag; ///< used to create the worker threads on first use
+  std::atomic<std::size_t> nextWorker{ 0 }; ///< round-robin index for tasks from non-worker threads
+  std::atomic<std::size_t> queued{ 0 }; ///< number of tasks in all worker queues
+  std::atomic<std::size_t> running{ 0 }; ///< number of tasks currently executing
+  std::atomic<std::size_t> busyWorkers{ 0 }; ///< number of worker threads executing a task
+  std::mutex wakeMutex; ///< protects #stopping and is used with #wakeCond
+  std::condition_variable wakeCond; ///< signalled when a task is queued or the executor stops
+  std::condition_variable doneCond; ///< signalled when a task is queued or finished, used by #Wait
+  bool stopping{ false };
+  std::mutex overflowMutex; ///< protects #overflowThreads
+  std::list<OverflowThread> overflowThreads;
+};
+}
+}
+
+#endif /* __TRANSITIONEXECUTOR_HPP__ */
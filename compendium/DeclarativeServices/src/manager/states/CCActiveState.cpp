@@ -22,6 +22,7 @@
 
 #include "CCActiveState.hpp"
 #include "../ComponentConfigurationImpl.hpp"
+#include "CCRegisteredState.hpp"
 #include "CCUnsatisfiedReferenceState.hpp"
 #include "cppmicroservices/SharedLibraryException.h"
 
@@ -48,7 +49,8 @@ std::shared_ptr<ComponentInstance> CCActiveState::Activate(ComponentConfiguratio
   // no state change, already in active state. create and return a ComponentInstance object
   std::shared_ptr<ComponentInstance> instance;
   auto logger = mgr.GetLogger();
-  if(latch.CountUp())
+  const bool activating = latch.CountUp();
+  if(activating)
   {
     {
       LatchScopeGuard sg([this, logger]() {
@@ -68,18 +70,50 @@ std::shared_ptr<ComponentInstance> CCActiveState::Activate(ComponentConfiguratio
       // latch.CountDown().
       instance = mgr.CreateAndActivateComponentInstance(clientBundle);
     }
+  }
 
-    if(!instance)
-    {
-      logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR, "Component configuration activation failed");
-    }
-    return instance;
+  if(!instance && IsReplacedByIdleDeactivation(mgr))
+  {
+    // retry from the state which replaced this one
+    return mgr.GetState()->Activate(mgr, clientBundle);
   }
+  if(!instance && activating)
+  {
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_ERROR, "Component configuration activation failed");
+  }
+  else if(!instance)
+  {
+    // do not allow any new component instances to be created if Deactivate was called
+    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG, "Component configuration activation failed because component is not in active state");
+  }
+  return instance;
+}
 
-  // do not allow any new component instances to be created if Deactivate was called
-  logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG, "Component configuration activation failed because component is not in active state");
-  return nullptr;
-      
+bool CCActiveState::IsReplacedByIdleDeactivation(ComponentConfigurationImpl& mgr) const
+{
+  // an idle deactivation moves the configuration to the SATISFIED state
+  // before it waits for the activations which already started in this state
+  auto currentState = mgr.GetState();
+  return currentState.get() != this &&
+         currentState->GetValue() != ComponentState::UNSATISFIED_REFERENCE;
+}
+
+void CCActiveState::DeactivateIdle(ComponentConfigurationImpl& mgr)
+{
+  auto currentState = shared_from_this();
+  auto registeredState = std::make_shared<CCRegisteredState>();
+  if(!mgr.CompareAndSetState(&currentState, registeredState))
+  {
+    return; // the configuration changed its state in the meantime
+  }
+  latch.Wait(); // wait for the activations which started in this state
+  if(!mgr.DestroyIdleComponentInstances())
+  {
+    // the instance is used again. Restore the active state, unless the new
+    // user already activated the configuration from the registered state
+    auto expectedState = std::dynamic_pointer_cast<ComponentConfigurationState>(registeredState);
+    mgr.CompareAndSetState(&expectedState, std::make_shared<CCActiveState>());
+  }
 }
 }
 }
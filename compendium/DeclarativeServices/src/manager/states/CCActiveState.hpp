@@ -53,6 +53,13 @@ public:
   std::shared_ptr<ComponentInstance> Activate(ComponentConfigurationImpl& mgr,
                                               const cppmicroservices::Bundle& clientBundle) override;
 
+  /**
+   * Changes the state to {@link ComponentState::SATISFIED} and destroys the
+   * component instance once the running activations finished. The state is
+   * restored if the instance is used again before it is destroyed.
+   */
+  void DeactivateIdle(ComponentConfigurationImpl& mgr) override;
+
   /**
    * Returns {@link ComponentState::ACTIVE} to indicate the 
    * state represented by this object
@@ -64,6 +71,12 @@ public:
     latch.Wait();
   }
 private:
+  /**
+   * Returns \c true if an idle deactivation replaced this state, in which
+   * case a failed activation is retried from the current state
+   */
+  bool IsReplacedByIdleDeactivation(ComponentConfigurationImpl& mgr) const;
+
   CounterLatch latch;
 };
 }
@@ -45,11 +45,15 @@ std::shared_future<void> CMDisabledState::Enable(ComponentManagerImpl& cm)
   auto bundle = cm.GetBundle();
   auto reg = cm.GetRegistry();
   auto logger = cm.GetLogger();
+  auto runtime = cm.GetRuntimeContext();
+  // the configurations do not use the executor, and the task running on the
+  // executor must not keep it alive
+  runtime.executor.reset();
   std::packaged_task<void(std::shared_ptr<CMEnabledState>, std::exception_ptr&)>
-    task([metadata, bundle, reg, logger](std::shared_ptr<CMEnabledState> eState,
-                                         std::exception_ptr& ptr) {
+    task([metadata, bundle, reg, logger, runtime](std::shared_ptr<CMEnabledState> eState,
+                                                  std::exception_ptr& ptr) {
       try {
-        eState->CreateConfigurations(metadata, bundle, reg, logger);
+        eState->CreateConfigurations(metadata, bundle, reg, logger, runtime);
       } catch (const cppmicroservices::SharedLibraryException&) {
         ptr = std::current_exception();
       }
@@ -65,17 +69,14 @@ std::shared_future<void> CMDisabledState::Enable(ComponentManagerImpl& cm)
 
   if(succeeded) // succeeded in changing the state
   {
-    auto futObj =
-      std::async(std::launch::async,
-                 [enabledState, transition = std::move(task)]() mutable {
-                   std::exception_ptr ptr;
-                   transition(enabledState, ptr);
-                   if (ptr) {
-                     std::rethrow_exception(ptr);
-                   }
-                 })
-        .share();
-    return futObj;
+    auto transition = std::make_shared<decltype(task)>(std::move(task));
+    return cm.GetExecutor()->Submit([enabledState, transition]() {
+      std::exception_ptr ptr;
+      (*transition)(enabledState, ptr);
+      if (ptr) {
+        std::rethrow_exception(ptr);
+      }
+    });
   }
   // return the stored future in the current enabled state object
   return currentState->GetFuture();
@@ -39,8 +39,10 @@ std::shared_future<void> CMEnabledState::Disable(ComponentManagerImpl& cm)
 {
   auto currentState = shared_from_this(); // assume this object is the current state object
 
-  std::packaged_task<void(std::shared_ptr<CMEnabledState>)> task([](std::shared_ptr<CMEnabledState> enabledState) {
-                                                                   enabledState->DeleteConfigurations();
+  // the executor outlives the tasks it runs
+  auto* executor = cm.GetExecutor().get();
+  std::packaged_task<void(std::shared_ptr<CMEnabledState>)> task([executor](std::shared_ptr<CMEnabledState> enabledState) {
+                                                                   enabledState->DeleteConfigurations(*executor);
                                                                  });
 
   auto disabledState = std::make_shared<CMDisabledState>(task.get_future().share());
@@ -55,9 +57,10 @@ std::shared_future<void> CMEnabledState::Disable(ComponentManagerImpl& cm)
   if(succeeded) // succeeded in changing the state
   {
     std::shared_ptr<CMEnabledState> currEnabledState = std::dynamic_pointer_cast<CMEnabledState>(currentState);
-    auto fut = std::async(std::launch::async, [currEnabledState, transition = std::move(task)]() mutable {
-                                                transition(currEnabledState);
-                                              }).share();
+    auto transition = std::make_shared<decltype(task)>(std::move(task));
+    auto fut = cm.GetExecutor()->Submit([currEnabledState, transition]() {
+                                          (*transition)(currEnabledState);
+                                        });
     cm.AccumulateFuture(fut);
     return fut;
   }
@@ -68,14 +71,16 @@ std::shared_future<void> CMEnabledState::Disable(ComponentManagerImpl& cm)
 void CMEnabledState::CreateConfigurations(std::shared_ptr<const metadata::ComponentMetadata> compDesc,
                                           const cppmicroservices::Bundle& bundle,
                                           std::shared_ptr<const ComponentRegistry> registry,
-                                          std::shared_ptr<logservice::LogService> logger)
+                                          std::shared_ptr<logservice::LogService> logger,
+                                          const ComponentRuntimeContext& runtime)
 {
   try
   {
     auto cc = ComponentConfigurationFactory::CreateConfigurationManager(compDesc,
                                                                         bundle,
                                                                         registry,
-                                                                        logger);
+                                                                        logger,
+                                                                        runtime);
     configurations.push_back(cc);
   } catch (const cppmicroservices::SharedLibraryException&) {
     throw;
@@ -85,8 +90,9 @@ void CMEnabledState::CreateConfigurations(std::shared_ptr<const metadata::Compon
 }
 
 // wait for the task to finish creating configurations and return them
-std::vector<std::shared_ptr<ComponentConfiguration>> CMEnabledState::GetConfigurations(const ComponentManagerImpl& /*cm*/) const
+std::vector<std::shared_ptr<ComponentConfiguration>> CMEnabledState::GetConfigurations(const ComponentManagerImpl& cm) const
 {
+  cm.GetExecutor()->Wait(GetFuture());
   GetFuture().get(); // wait for the task created in #CreateConfigurationsAsync
   // Note: Exceptions from the task associated with the future are captured and
   // logged on the other thread. See #CreateConfigurations.
@@ -94,11 +100,12 @@ std::vector<std::shared_ptr<ComponentConfiguration>> CMEnabledState::GetConfigur
   return retVec;
 }
 
-void CMEnabledState::DeleteConfigurations()
+void CMEnabledState::DeleteConfigurations(TransitionExecutor& executor)
 {
   auto fut = GetFuture();
   if(fut.valid())
   {
+    executor.Wait(fut);
     fut.get(); // wait for the configurations to become available
     // No exceptions are expected from the future. Exceptions are
     // logged on the otherside of the thread boundary. See #CreateConfigurations
@@ -25,6 +25,8 @@
 
 #include "gtest/gtest_prod.h"
 #include "cppmicroservices/logservice/LogService.hpp"
+#include "../ComponentRuntimeContext.hpp"
+#include "../TransitionExecutor.hpp"
 #include "ComponentManagerState.hpp"
 #include "../../ComponentRegistry.hpp"
 #include "../../metadata/ComponentMetadata.hpp"
@@ -104,16 +106,20 @@ public:
    * \param bundle which contains the component
    * \param registry is the runtime's component registry
    * \param logger is the runtime's logger
+   * \param runtime holds the runtime's collaborators of the configurations
    */
   void CreateConfigurations(std::shared_ptr<const metadata::ComponentMetadata> compDesc,
                             const cppmicroservices::Bundle& bundle,
                             std::shared_ptr<const ComponentRegistry> registry,
-                            std::shared_ptr<logservice::LogService> logger);
+                            std::shared_ptr<logservice::LogService> logger,
+                            const ComponentRuntimeContext& runtime = {});
 
   /**
    * Helper function used to remove all the configuration objects created by this state.
+   *
+   * \param executor is the executor running the task which creates the configurations
    */
-  void DeleteConfigurations();
+  void DeleteConfigurations(TransitionExecutor& executor);
 
   FRIEND_TEST(CMEnabledStateTest, TestCtor);
   FRIEND_TEST(CMEnabledStateTest, TestEnable);
@@ -75,6 +75,16 @@ public:
    */
   virtual void Deactivate(ComponentConfigurationImpl& mgr) = 0;
 
+  /**
+   * Implementation must handle the transition from \c ACTIVE to \c SATISFIED
+   * when the component instance of a delayed component is no longer used.
+   * The default implementation does nothing, because only an active
+   * configuration has a component instance.
+   *
+   * \param mgr is the {@link ComponentConfigurationImpl} object whose state needs to change
+   */
+  virtual void DeactivateIdle(ComponentConfigurationImpl& /*mgr*/) {}
+
   /**
    * Returns the state as a {@link ComponentState} enum value
    */
@@ -23,6 +23,7 @@
 #ifndef COMPONENTMETADATA_HPP
 #define COMPONENTMETADATA_HPP
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -49,6 +50,7 @@ struct ComponentMetadata
   std::string name;
   bool enabled{true};
   bool immediate{false};
+  std::chrono::milliseconds idleTimeout{0}; ///< time after which an unused delayed component instance is deactivated, zero if it is never deactivated
   std::string implClassName;
   std::string activateMethodName;
   std::string deactivateMethodName;
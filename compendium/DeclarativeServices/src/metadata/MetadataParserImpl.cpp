@@ -112,6 +112,9 @@ MetadataParserImplV1::CreateComponentMetadata(const AnyMap& metadata) const
   }
   compMetadata->immediate = (!serviceSpecified || (serviceSpecified && isImmediate));
 
+  // component.idle-timeout
+  compMetadata->idleTimeout = ParseIdleTimeout(metadata, compMetadata->immediate);
+
   // component.enabled
   ObjectValidator(metadata, "enabled", /*isOptional=*/true).AssignValueTo(compMetadata->enabled);
 
@@ -149,6 +152,23 @@ MetadataParserImplV1::CreateComponentMetadata(const AnyMap& metadata) const
   return compMetadata;
 }
 
+std::chrono::milliseconds ParseIdleTimeout(const AnyMap& metadata, bool immediate)
+{
+  auto object = ObjectValidator(metadata, "idle-timeout", /*isOptional=*/true);
+  if (!object.KeyExists())
+  {
+    return std::chrono::milliseconds(0);
+  }
+  // only the instances of delayed components are created on demand and can
+  // be deactivated when they are no longer used
+  const auto timeout = object.GetValue<int>();
+  if (timeout < 0 || (immediate && timeout > 0))
+  {
+    throw std::runtime_error("Invalid value specified for the name 'idle-timeout'.");
+  }
+  return std::chrono::milliseconds(timeout);
+}
+
 std::vector<std::shared_ptr<ComponentMetadata>>
 MetadataParserImplV1::ParseAndGetComponentsMetadata(const AnyMap& scrmap) const
 {
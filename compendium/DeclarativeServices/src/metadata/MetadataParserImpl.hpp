@@ -23,6 +23,8 @@
 #ifndef METADATAPARSERIMPL_HPP
 #define METADATAPARSERIMPL_HPP
 
+#include <chrono>
+
 #include "MetadataParser.hpp"
 #include "cppmicroservices/logservice/LogService.hpp"
 
@@ -88,6 +90,16 @@ public:
 private:
   std::shared_ptr<cppmicroservices::logservice::LogService> logger;
 };
+
+/*
+ * @brief Parse and return the idle timeout of a component
+ * @param metadata An element in the array of the key "components" in the manifest
+ * @param immediate Whether the component is immediate
+ * @returns the value of the optional key "idle-timeout" in milliseconds, or
+ *          zero if the key does not exist
+ * @throws std::runtime_error if the value is negative or the component is immediate
+ */
+std::chrono::milliseconds ParseIdleTimeout(const AnyMap& metadata, bool immediate);
 }
 }
 }
@@ -0,0 +1,180 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "MetadataTableReader.hpp"
+#include "MetadataParserImpl.hpp"
+#include "ReferenceMetadata.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace cppmicroservices {
+namespace scrimpl {
+namespace metadata {
+
+const std::string COMPONENT_METADATA_RESOURCE = "scr_metadata.bin";
+
+namespace {
+/// The version of the serialized metadata written by SCRCodeGen
+const uint32_t COMPONENT_METADATA_VERSION = 1;
+
+/*
+ * Reads the serialized component metadata. The format must be kept in sync
+ * with compendium/tools/SCRCodeGen/ComponentMetadataWriter.hpp
+ */
+class TableReader
+{
+public:
+  explicit TableReader(std::istream& in)
+    : in(in)
+  {}
+
+  uint32_t ReadUInt32()
+  {
+    unsigned char bytes[4];
+    Read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+    return static_cast<uint32_t>(bytes[0]) |
+           (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) |
+           (static_cast<uint32_t>(bytes[3]) << 24);
+  }
+
+  bool ReadBool()
+  {
+    char value = 0;
+    Read(&value, 1);
+    return value != 0;
+  }
+
+  std::string ReadString()
+  {
+    // read in chunks, so that a corrupted length does not allocate
+    // more memory than the stream holds
+    auto length = ReadUInt32();
+    std::string value;
+    char buffer[256];
+    while (length > 0) {
+      auto chunk = (std::min)(length, static_cast<uint32_t>(sizeof(buffer)));
+      Read(buffer, chunk);
+      value.append(buffer, chunk);
+      length -= chunk;
+    }
+    return value;
+  }
+
+  void Read(char* buffer, std::size_t size)
+  {
+    if (!in.read(buffer, size)) {
+      throw std::runtime_error("The component metadata table is truncated.");
+    }
+  }
+
+private:
+  std::istream& in;
+};
+
+ReferenceMetadata ReadReferenceMetadata(TableReader& reader)
+{
+  ReferenceMetadata refMetadata{};
+  refMetadata.name = reader.ReadString();
+  refMetadata.interfaceName = reader.ReadString();
+  refMetadata.target = reader.ReadString();
+  refMetadata.cardinality = reader.ReadString();
+  std::tie(refMetadata.minCardinality, refMetadata.maxCardinality) =
+    GetReferenceCardinalityExtents(refMetadata.cardinality);
+  refMetadata.policy = reader.ReadString();
+  refMetadata.policyOption = reader.ReadString();
+  refMetadata.scope = reader.ReadString();
+  return refMetadata;
+}
+
+std::shared_ptr<ComponentMetadata> ReadComponentMetadata(
+  TableReader& reader,
+  const AnyMap& component)
+{
+  auto compMetadata = std::make_shared<ComponentMetadata>();
+  compMetadata->name = reader.ReadString();
+  compMetadata->implClassName = reader.ReadString();
+  if (ref_any_cast<std::string>(component.at("implementation-class")) !=
+      compMetadata->implClassName) {
+    throw std::runtime_error(
+      "The component metadata table does not match the manifest.");
+  }
+  compMetadata->enabled = reader.ReadBool();
+  compMetadata->immediate = reader.ReadBool();
+  compMetadata->idleTimeout =
+    ParseIdleTimeout(component, compMetadata->immediate);
+
+  auto props = component.find("properties");
+  if (props != component.end()) {
+    for (const auto& prop : ref_any_cast<AnyMap>(props->second)) {
+      compMetadata->properties.insert(prop);
+    }
+  }
+
+  compMetadata->serviceMetadata.scope = reader.ReadString();
+  for (auto count = reader.ReadUInt32(); count > 0; --count) {
+    compMetadata->serviceMetadata.interfaces.push_back(reader.ReadString());
+  }
+  for (auto count = reader.ReadUInt32(); count > 0; --count) {
+    compMetadata->refsMetadata.push_back(ReadReferenceMetadata(reader));
+  }
+  return compMetadata;
+}
+}
+
+std::vector<std::shared_ptr<ComponentMetadata>> CreateComponentsMetadata(
+  std::istream& table,
+  const AnyMap& scrmap)
+{
+  TableReader reader(table);
+  char magic[4];
+  reader.Read(magic, sizeof(magic));
+  if (std::string(magic, sizeof(magic)) != "USCM") {
+    throw std::runtime_error("The component metadata table is malformed.");
+  }
+  // tables written by other versions of SCRCodeGen are not read
+  if (reader.ReadUInt32() != COMPONENT_METADATA_VERSION) {
+    throw std::runtime_error(
+      "The component metadata table has an unknown version.");
+  }
+
+  const auto& components =
+    ref_any_cast<std::vector<Any>>(scrmap.at("components"));
+  if (components.size() != reader.ReadUInt32()) {
+    throw std::runtime_error(
+      "The component metadata table does not match the manifest.");
+  }
+
+  std::vector<std::shared_ptr<ComponentMetadata>> componentsMetadata;
+  componentsMetadata.reserve(components.size());
+  for (const auto& component : components) {
+    componentsMetadata.emplace_back(
+      ReadComponentMetadata(reader, ref_any_cast<AnyMap>(component)));
+  }
+  return componentsMetadata;
+}
+}
+}
+}
@@ -0,0 +1,62 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef METADATATABLEREADER_HPP
+#define METADATATABLEREADER_HPP
+
+#include "ComponentMetadata.hpp"
+#include "cppmicroservices/AnyMap.h"
+
+#include <istream>
+#include <memory>
+#include <vector>
+
+namespace cppmicroservices {
+namespace scrimpl {
+namespace metadata {
+
+/// The name of the bundle resource which holds the component metadata
+/// serialized by SCRCodeGen
+extern const std::string COMPONENT_METADATA_RESOURCE;
+
+/*
+ * @brief Create the metadata of all components in a bundle from the
+ *        metadata serialized by SCRCodeGen into the bundle resource
+ *        @c COMPONENT_METADATA_RESOURCE. The metadata is validated at build
+ *        time, so only its consistency with the manifest is checked.
+ * @param table The stream to read the serialized metadata from
+ * @param scrmap The value of the key "scr" in the manifest of the bundle. The
+ *        component properties and idle timeouts are read from it.
+ * @returns a vector of @c ComponentMetadata objects, in the order of the
+ *          components in the manifest
+ * @throws std::runtime_error if the metadata is malformed or of an unknown
+ *         version, if it does not describe the components of the manifest,
+ *         or if an idle timeout is invalid
+ */
+std::vector<std::shared_ptr<ComponentMetadata>> CreateComponentsMetadata(
+  std::istream& table,
+  const AnyMap& scrmap);
+}
+}
+}
+
+#endif //METADATATABLEREADER_HPP
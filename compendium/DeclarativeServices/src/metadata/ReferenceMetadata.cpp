@@ -22,6 +22,7 @@
 
 #include "ReferenceMetadata.hpp"
 #include "Util.hpp"
+#include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 
 namespace cppmicroservices {
 namespace scrimpl {
@@ -73,6 +74,26 @@ std::tuple<std::size_t, std::size_t> GetReferenceCardinalityExtents(const std::s
   }
   return std::make_tuple(maxCardinality, minCardinality);
 }
+
+ReferencePolicyOption ParseReferencePolicyOption(const std::string& policyOption)
+{
+  return (policyOption == "greedy") ? ReferencePolicyOption::Greedy
+                                    : ReferencePolicyOption::Reluctant;
+}
+
+ReferenceScope ParseReferenceScope(const std::string& scope)
+{
+  using cppmicroservices::service::component::ComponentConstants::REFERENCE_SCOPE_PROTOTYPE_REQUIRED;
+  if(scope == cppmicroservices::Constants::SCOPE_BUNDLE)
+  {
+    return ReferenceScope::Bundle;
+  }
+  if(scope == REFERENCE_SCOPE_PROTOTYPE_REQUIRED)
+  {
+    return ReferenceScope::PrototypeRequired;
+  }
+  return ReferenceScope::Prototype;
+}
 }
 }
 }
@@ -38,6 +38,27 @@ namespace cppmicroservices {
 namespace scrimpl {
 namespace metadata {
 
+/**
+ * The policy option of a reference, used instead of the policy option
+ * string on the hot paths of the runtime
+ */
+enum class ReferencePolicyOption
+{
+  Reluctant,
+  Greedy
+};
+
+/**
+ * The scope of a reference, used instead of the scope string on the
+ * hot paths of the runtime
+ */
+enum class ReferenceScope
+{
+  Bundle,
+  Prototype,
+  PrototypeRequired
+};
+
 /**
  * Stores the reference metadata information parsed from the Service Component
  * Runtime description.
@@ -80,6 +101,24 @@ struct ReferenceMetadata
  */
 std::tuple<std::size_t, std::size_t> GetReferenceCardinalityExtents(const std::string& cardinality);
 
+/**
+ * @brief Returns the policy option given a string representing the reference
+ *        policy option
+ * @param policyOption the reference policy option string
+ * @returns @c ReferencePolicyOption::Greedy if @p policyOption is "greedy",
+ *          @c ReferencePolicyOption::Reluctant otherwise
+ */
+ReferencePolicyOption ParseReferencePolicyOption(const std::string& policyOption);
+
+/**
+ * @brief Returns the scope given a string representing the reference scope
+ * @param scope the reference scope string
+ * @returns @c ReferenceScope::Bundle if @p scope is "bundle",
+ *          @c ReferenceScope::PrototypeRequired if @p scope is
+ *          "prototype_required", @c ReferenceScope::Prototype otherwise
+ */
+ReferenceScope ParseReferenceScope(const std::string& scope);
+
 }
 }
 }
@@ -4,8 +4,10 @@
 #define ConcurrencyTestUtil_hpp
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <future>
+#include <thread>
 #include <vector>
 
 /**
@@ -44,4 +46,21 @@ std::vector<R> ConcurrentInvoke(std::function<R(Args...)> func)
   return returnVals;
 }
 
+/**
+ * Utility method for waiting until a condition holds. Returns \c false if the
+ * condition does not hold within ten seconds.
+ */
+template<class Condition>
+bool WaitFor(Condition cond)
+{
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!cond()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
 #endif /* ConcurrencyTestUtil_hpp */
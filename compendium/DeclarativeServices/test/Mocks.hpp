@@ -106,6 +106,8 @@ public:
   MOCK_CONST_METHOD2(GetComponentManager, std::shared_ptr<ComponentManager>(unsigned long, const std::string&));
   MOCK_METHOD1(AddComponentManager, bool(const std::shared_ptr<ComponentManager>&));
   MOCK_METHOD1(RemoveComponentManager, void(const std::shared_ptr<ComponentManager>&));
+  MOCK_METHOD1(AddComponentManagers, std::vector<std::shared_ptr<ComponentManager>>(const std::vector<std::shared_ptr<ComponentManager>>&));
+  MOCK_METHOD1(RemoveComponentManagers, void(const std::vector<std::shared_ptr<ComponentManager>>&));
 };
 
 class MockComponentManagerState
@@ -124,7 +126,7 @@ class MockReferenceManager
 {
 public:
   MOCK_CONST_METHOD0(GetReferenceName, std::string(void));
-  MOCK_CONST_METHOD0(GetReferenceScope, std::string(void));
+  MOCK_CONST_METHOD0(GetReferenceScope, metadata::ReferenceScope(void));
   MOCK_CONST_METHOD0(GetLDAPString, std::string(void));
   MOCK_CONST_METHOD0(IsSatisfied, bool(void));
   MOCK_CONST_METHOD0(IsOptional, bool(void));
@@ -0,0 +1,107 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "../src/manager/ActivationTracker.hpp"
+#include "ConcurrencyTestUtil.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+TEST(ActivationTrackerTest, TestScheduledTaskRuns)
+{
+  ActivationTracker tracker(std::chrono::milliseconds(5));
+  std::atomic<int> count{0};
+  tracker.Schedule(std::chrono::milliseconds(10), [&count]() { ++count; });
+  EXPECT_EQ(tracker.GetScheduledCount(), 1u);
+  EXPECT_TRUE(WaitFor([&count]() { return count.load() == 1; }));
+  EXPECT_EQ(tracker.GetScheduledCount(), 0u);
+}
+
+TEST(ActivationTrackerTest, TestNeverExpiresEarly)
+{
+  // a small wheel forces the timers to wait for several rounds
+  ActivationTracker tracker(std::chrono::milliseconds(2), 4);
+  std::atomic<int> count{0};
+  const auto delays = { 0, 3, 7, 20, 45 };
+  for(auto delay : delays)
+  {
+    const auto scheduled = std::chrono::steady_clock::now();
+    const auto expected = std::chrono::milliseconds(delay);
+    tracker.Schedule(expected, [&count, scheduled, expected]() {
+      EXPECT_GE(std::chrono::steady_clock::now() - scheduled, expected);
+      ++count;
+    });
+  }
+  EXPECT_TRUE(WaitFor([&count]() { return count.load() == 5; }));
+}
+
+TEST(ActivationTrackerTest, TestCancel)
+{
+  ActivationTracker tracker(std::chrono::milliseconds(2));
+  std::atomic<int> count{0};
+  auto cancelled = tracker.Schedule(std::chrono::milliseconds(20), [&count]() { count += 100; });
+  tracker.Schedule(std::chrono::milliseconds(40), [&count]() { ++count; });
+  EXPECT_TRUE(tracker.Cancel(cancelled));
+  EXPECT_FALSE(tracker.Cancel(cancelled));
+  EXPECT_EQ(tracker.GetScheduledCount(), 1u);
+  EXPECT_TRUE(WaitFor([&count]() { return count.load() != 0; }));
+  EXPECT_EQ(count.load(), 1);
+}
+
+TEST(ActivationTrackerTest, TestTaskException)
+{
+  ActivationTracker tracker(std::chrono::milliseconds(2));
+  std::atomic<int> count{0};
+  tracker.Schedule(std::chrono::milliseconds(1), []() { throw std::runtime_error("failure"); });
+  tracker.Schedule(std::chrono::milliseconds(1), [&count]() { ++count; });
+  EXPECT_TRUE(WaitFor([&count]() { return count.load() == 1; }));
+}
+
+TEST(ActivationTrackerTest, TestDestructorDiscardsPendingTasks)
+{
+  std::atomic<int> count{0};
+  {
+    ActivationTracker tracker(std::chrono::milliseconds(2));
+    tracker.Schedule(std::chrono::seconds(60), [&count]() { ++count; });
+  }
+  EXPECT_EQ(count.load(), 0);
+}
+
+TEST(ActivationTrackerTest, TestCounters)
+{
+  ActivationTracker tracker;
+  tracker.CountActivation();
+  tracker.CountActivation();
+  tracker.CountDeactivation(false);
+  tracker.CountDeactivation(true);
+  EXPECT_EQ(tracker.GetActivationCount(), 2u);
+  EXPECT_EQ(tracker.GetDeactivationCount(), 2u);
+  EXPECT_EQ(tracker.GetIdleDeactivationCount(), 1u);
+}
+}
+}
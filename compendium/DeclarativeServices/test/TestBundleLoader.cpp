@@ -0,0 +1,106 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+
+#include "../src/manager/BundleLoader.hpp"
+
+#include "TestUtils.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+class BundleLoaderTest : public ::testing::Test
+{
+protected:
+  BundleLoaderTest()
+    : framework(cppmicroservices::FrameworkFactory().NewFramework())
+  {}
+
+  void SetUp() override
+  {
+    framework.Start();
+    auto context = framework.GetBundleContext();
+    test::InstallLib(context, "TestBundleDSTOI1");
+    for (auto const& b : context.GetBundles()) {
+      if (b.GetSymbolicName() == "TestBundleDSTOI1") {
+        bundle = b;
+      }
+    }
+    ASSERT_TRUE(bundle);
+    bundle.Start();
+  }
+
+  void TearDown() override
+  {
+    bundle = cppmicroservices::Bundle();
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  cppmicroservices::Framework framework;
+  cppmicroservices::Bundle bundle;
+};
+
+TEST_F(BundleLoaderTest, GetComponentFactoryTable)
+{
+  auto table = GetComponentFactoryTable(bundle);
+  ASSERT_NE(table, nullptr);
+  // all callers share the table of a bundle
+  EXPECT_EQ(table, GetComponentFactoryTable(bundle));
+  EXPECT_NE(table, GetComponentFactoryTable(framework));
+}
+
+TEST_F(BundleLoaderTest, GetCreatorDeletors)
+{
+  auto table = GetComponentFactoryTable(bundle);
+  std::function<ComponentInstance*(void)> newInstance;
+  std::function<void(ComponentInstance*)> deleteInstance;
+  std::tie(newInstance, deleteInstance) =
+    table->GetCreatorDeletors("sample::ServiceComponent", bundle);
+  ASSERT_TRUE(newInstance);
+  ASSERT_TRUE(deleteInstance);
+  auto instance = newInstance();
+  ASSERT_NE(instance, nullptr);
+  deleteInstance(instance);
+
+  // the free function resolves the same entry points
+  auto creatorDeletors =
+    GetComponentCreatorDeletors("sample::ServiceComponent", bundle);
+  EXPECT_EQ(*std::get<0>(creatorDeletors).target<ComponentInstance* (*)()>(),
+            *newInstance.target<ComponentInstance* (*)()>());
+}
+
+TEST_F(BundleLoaderTest, GetCreatorDeletorsUnknownComponent)
+{
+  auto table = GetComponentFactoryTable(bundle);
+  EXPECT_THROW(table->GetCreatorDeletors("sample::UnknownComponent", bundle),
+               std::runtime_error);
+}
+}
+}
@@ -26,6 +26,7 @@
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/ServiceInterface.h"
+#include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "../src/manager/ComponentConfigurationImpl.hpp"
 #include "Mocks.hpp"
 #include "ConcurrencyTestUtil.hpp"
@@ -126,6 +127,7 @@ TEST_F(ComponentConfigurationImplTest, VerifyRefSatisfied)
   // When Dependency2 becomes available, Dependency3 is still unavailable so
   // the component must not trigger a state change. When Dependency3 becomes
   // available, all the dependencies are now available which results in a state change.
+  // Each notification only queries the reference manager which sent it.
   auto mockMetadata = std::make_shared<metadata::ComponentMetadata>();
   auto mockRegistry = std::make_shared<MockComponentRegistry>();
   auto fakeLogger = std::make_shared<FakeLogger>();
@@ -134,13 +136,14 @@ TEST_F(ComponentConfigurationImplTest, VerifyRefSatisfied)
   auto refMgr2 = std::make_shared<MockReferenceManager>();
   auto refMgr3 = std::make_shared<MockReferenceManager>();
   EXPECT_CALL(*refMgr1, IsSatisfied())
-    .WillRepeatedly(testing::Return(true)); // simulate pre-existing reference
+    .Times(1)
+    .WillOnce(testing::Return(true));
   EXPECT_CALL(*refMgr2, IsSatisfied())
     .Times(1)
-    .WillOnce(testing::Return(true));       // simulate reference that becomes available
+    .WillOnce(testing::Return(true));
   EXPECT_CALL(*refMgr3, IsSatisfied())
     .Times(1)
-    .WillOnce(testing::Return(false));      // simulate reference that is unavailable when ref2 is satisfied
+    .WillOnce(testing::Return(true));
   auto mockFactory = std::make_shared<MockFactory>();
   auto mockCompInstance = std::make_shared<MockComponentInstance>();
   auto bc = GetFramework().GetBundleContext();
@@ -156,7 +159,11 @@ TEST_F(ComponentConfigurationImplTest, VerifyRefSatisfied)
   fakeCompConfig->referenceManagers.insert(std::make_pair("ref2", refMgr2));
   fakeCompConfig->referenceManagers.insert(std::make_pair("ref3", refMgr3));
   EXPECT_EQ(fakeCompConfig->GetConfigState(), ComponentState::UNSATISFIED_REFERENCE);
-  // callback from refMgr2
+  // callback from refMgr1, simulate pre-existing reference
+  fakeCompConfig->RefSatisfied("ref1");
+  EXPECT_EQ(fakeCompConfig->GetConfigState(), ComponentState::UNSATISFIED_REFERENCE);
+  // callback from refMgr2, notifications are idempotent
+  fakeCompConfig->RefSatisfied("ref2");
   fakeCompConfig->RefSatisfied("ref2");
   EXPECT_EQ(fakeCompConfig->GetConfigState(), ComponentState::UNSATISFIED_REFERENCE);
   // callback from refMgr3
@@ -167,6 +174,47 @@ TEST_F(ComponentConfigurationImplTest, VerifyRefSatisfied)
   fakeCompConfig->referenceManagers.clear(); // remove the mock reference managers
 }
 
+TEST_F(ComponentConfigurationImplTest, VerifyStaleRefSatisfied)
+{
+  // test case: Dependency1 became unsatisfied, but its earlier notification
+  // that it is satisfied arrives late. The configuration must not be
+  // satisfied until Dependency1 notifies again.
+  auto mockMetadata = std::make_shared<metadata::ComponentMetadata>();
+  auto mockRegistry = std::make_shared<MockComponentRegistry>();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  mockMetadata->serviceMetadata.interfaces = { us_service_interface_iid<dummy::ServiceImpl>() };
+  auto refMgr1 = std::make_shared<MockReferenceManager>();
+  auto refMgr2 = std::make_shared<MockReferenceManager>();
+  EXPECT_CALL(*refMgr1, IsSatisfied())
+    .WillOnce(testing::Return(false))
+    .WillOnce(testing::Return(true));
+  EXPECT_CALL(*refMgr2, IsSatisfied())
+    .Times(1)
+    .WillOnce(testing::Return(true));
+  auto mockFactory = std::make_shared<MockFactory>();
+  auto  fakeCompConfig = std::make_shared<MockComponentConfigurationImpl>(mockMetadata,
+                                                                          GetFramework(),
+                                                                          mockRegistry,
+                                                                          fakeLogger);
+  EXPECT_CALL(*fakeCompConfig, GetFactory())
+    .Times(1)
+    .WillOnce(testing::Return(mockFactory));
+  fakeCompConfig->referenceManagers.insert(std::make_pair("ref1", refMgr1));
+  fakeCompConfig->referenceManagers.insert(std::make_pair("ref2", refMgr2));
+  // late notification from refMgr1
+  fakeCompConfig->RefSatisfied("ref1");
+  fakeCompConfig->RefSatisfied("ref2");
+  EXPECT_EQ(fakeCompConfig->GetConfigState(), ComponentState::UNSATISFIED_REFERENCE);
+  // refMgr2 is already counted as satisfied, further notifications from it
+  // do not query the reference managers again
+  fakeCompConfig->RefSatisfied("ref2");
+  EXPECT_EQ(fakeCompConfig->GetConfigState(), ComponentState::UNSATISFIED_REFERENCE);
+  // refMgr1 becomes satisfied again
+  fakeCompConfig->RefSatisfied("ref1");
+  EXPECT_EQ(fakeCompConfig->GetConfigState(), ComponentState::SATISFIED);
+  fakeCompConfig->referenceManagers.clear(); // remove the mock reference managers
+}
+
 TEST_F(ComponentConfigurationImplTest, VerifyRefUnsatisfied)
 {
   auto mockMetadata = std::make_shared<metadata::ComponentMetadata>();
@@ -599,6 +647,40 @@ TEST_F(ComponentConfigurationImplTest, TestGetDependencyManagers)
   EXPECT_NE(fakeCompConfig->GetDependencyManager("Bar"), nullptr);
 }
 
+TEST_F(ComponentConfigurationImplTest, TestGetProperties)
+{
+  using cppmicroservices::service::component::ComponentConstants::COMPONENT_ID;
+  using cppmicroservices::service::component::ComponentConstants::COMPONENT_NAME;
+  auto mockMetadata = std::make_shared<metadata::ComponentMetadata>();
+  mockMetadata->name = "sample::Component";
+  mockMetadata->properties.emplace("foo", Any(std::string("bar")));
+  mockMetadata->serviceMetadata.interfaces = { us_service_interface_iid<dummy::ServiceImpl>() };
+  auto mockFactory = std::make_shared<MockFactory>();
+  auto fakeCompConfig = std::make_shared<MockComponentConfigurationImpl>(mockMetadata,
+                                                                         GetFramework(),
+                                                                         std::make_shared<MockComponentRegistry>(),
+                                                                         std::make_shared<FakeLogger>());
+  EXPECT_CALL(*fakeCompConfig, GetFactory())
+    .WillRepeatedly(testing::Return(mockFactory));
+  auto props = fakeCompConfig->GetProperties();
+  EXPECT_EQ(props.size(), 3ul);
+  EXPECT_EQ(props.at("foo").ToString(), "bar");
+  EXPECT_EQ(props.at(COMPONENT_NAME).ToString(), "sample::Component");
+  EXPECT_EQ(any_cast<unsigned long>(props.at(COMPONENT_ID)), fakeCompConfig->GetId());
+
+  // the service is registered with the same properties each time the
+  // component is satisfied
+  for(int i = 0; i < 2; ++i)
+  {
+    EXPECT_TRUE(fakeCompConfig->RegisterService());
+    auto sRef = fakeCompConfig->GetServiceReference();
+    EXPECT_EQ(sRef.GetProperty("foo").ToString(), "bar");
+    EXPECT_EQ(any_cast<unsigned long>(sRef.GetProperty(COMPONENT_ID)), fakeCompConfig->GetId());
+    EXPECT_EQ(sRef.GetProperty(cppmicroservices::Constants::SERVICE_SCOPE).ToString(), cppmicroservices::Constants::SCOPE_SINGLETON);
+    fakeCompConfig->UnregisterService();
+  }
+}
+
 TEST_F(ComponentConfigurationImplTest, TestComponentWithUniqueName)
 {
 #if defined(US_BUILD_SHARED_LIBS)
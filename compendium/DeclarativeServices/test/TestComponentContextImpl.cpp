@@ -127,7 +127,7 @@ TEST_F(ComponentContextImplTest, VerifyLocateService)
     .WillRepeatedly(testing::Return("foo"));
   EXPECT_CALL(*mockRefMgrFoo, GetReferenceScope())
     .Times(1)
-    .WillRepeatedly(testing::Return(cppmicroservices::Constants::SCOPE_BUNDLE));
+    .WillRepeatedly(testing::Return(metadata::ReferenceScope::Bundle));
   EXPECT_CALL(*mockConfig, GetBundle())
     .WillRepeatedly(testing::Return(GetFramework()));
   std::vector<std::shared_ptr<ReferenceManager>> depMgrs{mockRefMgrFoo};
@@ -311,7 +311,7 @@ TEST_F(ComponentContextImplTest, VerifyLocateServiceWithHighestRank)
     .WillRepeatedly(testing::Return("foo"));
   EXPECT_CALL(*mockRefMgrFoo, GetReferenceScope())
     .Times(1)
-    .WillRepeatedly(testing::Return(cppmicroservices::Constants::SCOPE_BUNDLE));
+    .WillRepeatedly(testing::Return(metadata::ReferenceScope::Bundle));
   EXPECT_CALL(*mockConfig, GetBundle())
     .WillRepeatedly(testing::Return(GetFramework()));
   std::vector<std::shared_ptr<ReferenceManager>> depMgrs{mockRefMgrFoo};
@@ -348,7 +348,7 @@ TEST_F(ComponentContextImplTest, VerifyLocateServiceWithLowestId)
     .WillRepeatedly(testing::Return("foo"));
   EXPECT_CALL(*mockRefMgrFoo, GetReferenceScope())
     .Times(1)
-    .WillRepeatedly(testing::Return(cppmicroservices::Constants::SCOPE_BUNDLE));
+    .WillRepeatedly(testing::Return(metadata::ReferenceScope::Bundle));
   EXPECT_CALL(*mockConfig, GetBundle())
     .WillRepeatedly(testing::Return(GetFramework()));
   std::vector<std::shared_ptr<ReferenceManager>> depMgrs{mockRefMgrFoo};
@@ -383,7 +383,7 @@ TEST_F(ComponentContextImplTest, VerifyLocateServices)
     .WillRepeatedly(testing::Return("foo"));
   EXPECT_CALL(*mockRefMgrFoo, GetReferenceScope())
     .Times(1)
-    .WillRepeatedly(testing::Return(cppmicroservices::Constants::SCOPE_BUNDLE));
+    .WillRepeatedly(testing::Return(metadata::ReferenceScope::Bundle));
   EXPECT_CALL(*mockConfig, GetBundle())
     .WillRepeatedly(testing::Return(GetFramework()));
   std::vector<std::shared_ptr<ReferenceManager>> depMgrs{mockRefMgrFoo};
@@ -20,7 +20,11 @@
 
   =============================================================================*/
 
+#include <atomic>
 #include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
 #include <algorithm>
 #include <vector>
 #include <memory>
@@ -254,5 +258,97 @@ TEST_F(ComponentRegistryTest, VerifyConcurrentAddsRemoves)
     }
   }
 }
+TEST_F(ComponentRegistryTest, VerifyAddRemoveComponentManagers)
+{
+  auto registry = GetRegistry();
+  std::vector<std::shared_ptr<ComponentManager>> managers;
+  for(auto name : { "Foo", "Bar", "Foo" })
+  {
+    auto mockCompMgr = std::make_shared<MockComponentManager>();
+    EXPECT_CALL(*mockCompMgr, GetBundleId()).WillRepeatedly(testing::Return(121));
+    EXPECT_CALL(*mockCompMgr, GetName()).WillRepeatedly(testing::Return(std::string(name)));
+    managers.push_back(mockCompMgr);
+  }
+  auto other = std::make_shared<MockComponentManager>();
+  EXPECT_CALL(*other, GetBundleId()).WillRepeatedly(testing::Return(122));
+  EXPECT_CALL(*other, GetName()).WillRepeatedly(testing::Return(std::string("Foo")));
+  registry->AddComponentManager(other);
+
+  // the second component named Foo is not inserted
+  auto inserted = registry->AddComponentManagers(managers);
+  ASSERT_EQ(inserted.size(), 2ul);
+  EXPECT_EQ(inserted[0], managers[0]);
+  EXPECT_EQ(inserted[1], managers[1]);
+  EXPECT_EQ(registry->Count(), 3ul);
+  EXPECT_EQ(registry->GetComponentManagers(121), inserted);
+  EXPECT_EQ(registry->GetComponentManager(121, "Bar"), managers[1]);
+  EXPECT_THROW(registry->GetComponentManager(123, "Bar"), std::out_of_range);
+  EXPECT_THROW(registry->GetComponentManager(122, "Bar"), std::out_of_range);
+
+  registry->RemoveComponentManagers(inserted);
+  EXPECT_EQ(registry->Count(), 1ul);
+  EXPECT_TRUE(registry->GetComponentManagers(121).empty());
+  EXPECT_EQ(registry->GetComponentManager(122, "Foo"), other);
+  registry->Clear();
+  EXPECT_EQ(registry->Count(), 0ul);
+  EXPECT_TRUE(registry->GetComponentManagers().empty());
+}
+
+TEST_F(ComponentRegistryTest, VerifyAddComponentManagersAllOrNothing)
+{
+  // a failure while adding the components of a bundle inserts none of them
+  auto registry = GetRegistry();
+  auto good = std::make_shared<MockComponentManager>();
+  EXPECT_CALL(*good, GetBundleId()).WillRepeatedly(testing::Return(121));
+  EXPECT_CALL(*good, GetName()).WillRepeatedly(testing::Return(std::string("Foo")));
+  auto bad = std::make_shared<MockComponentManager>();
+  EXPECT_CALL(*bad, GetBundleId()).WillRepeatedly(testing::Return(121));
+  EXPECT_CALL(*bad, GetName()).WillRepeatedly(testing::Throw(std::runtime_error("no name")));
+  EXPECT_THROW(registry->AddComponentManagers({ good, bad }), std::runtime_error);
+  EXPECT_EQ(registry->Count(), 0ul);
+  EXPECT_TRUE(registry->GetComponentManagers(121).empty());
+}
+
+TEST_F(ComponentRegistryTest, VerifyReadsDuringBundleLoads)
+{
+  // the components of a bundle are either all visible to a reader or none of them
+  auto registry = GetRegistry();
+  const std::size_t compsPerBundle = 10;
+  std::vector<std::vector<std::shared_ptr<ComponentManager>>> bundles(20);
+  for(std::size_t i = 0; i < bundles.size(); ++i)
+  {
+    for(std::size_t j = 0; j < compsPerBundle; ++j)
+    {
+      auto mockCompMgr = std::make_shared<MockComponentManager>();
+      EXPECT_CALL(*mockCompMgr, GetBundleId()).WillRepeatedly(testing::Return(static_cast<unsigned long>(i)));
+      EXPECT_CALL(*mockCompMgr, GetName()).WillRepeatedly(testing::Return("comp" + std::to_string(j)));
+      bundles[i].push_back(mockCompMgr);
+    }
+  }
+  std::atomic<bool> done{false};
+  auto reader = std::async(std::launch::async, [registry, &done, compsPerBundle]() {
+    bool consistent = true;
+    while(!done)
+    {
+      consistent = consistent && (registry->GetComponentManagers().size() % compsPerBundle == 0);
+    }
+    return consistent;
+  });
+  for(int round = 0; round < 10; ++round)
+  {
+    for(auto& bundle : bundles)
+    {
+      EXPECT_EQ(registry->AddComponentManagers(bundle).size(), compsPerBundle);
+    }
+    EXPECT_EQ(registry->Count(), bundles.size() * compsPerBundle);
+    for(auto& bundle : bundles)
+    {
+      registry->RemoveComponentManagers(bundle);
+    }
+  }
+  done = true;
+  EXPECT_TRUE(reader.get());
+  EXPECT_EQ(registry->Count(), 0ul);
+}
 } //scrimpl
 } // cppmicroservices
@@ -0,0 +1,170 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gmock/gmock.h"
+#include "../src/DependencyGraph.hpp"
+#include "../src/metadata/ComponentMetadata.hpp"
+#include "Mocks.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+namespace {
+struct Reference
+{
+  std::string interfaceName;
+  std::string cardinality;
+};
+
+/**
+ * Returns a component manager whose component provides the service
+ * interface named after the component and has the given references.
+ */
+std::shared_ptr<MockComponentManager> CreateComponent(const std::string& name,
+                                                      const std::vector<Reference>& references)
+{
+  auto compMetadata = std::make_shared<metadata::ComponentMetadata>();
+  compMetadata->name = name;
+  compMetadata->serviceMetadata.interfaces = { name };
+  for (const auto& reference : references)
+  {
+    metadata::ReferenceMetadata refMetadata;
+    refMetadata.name = reference.interfaceName;
+    refMetadata.interfaceName = reference.interfaceName;
+    refMetadata.cardinality = reference.cardinality;
+    compMetadata->refsMetadata.push_back(refMetadata);
+  }
+  auto manager = std::make_shared<MockComponentManager>();
+  EXPECT_CALL(*manager, GetMetadata())
+    .WillRepeatedly(testing::Return(compMetadata));
+  EXPECT_CALL(*manager, GetName())
+    .WillRepeatedly(testing::Return(name));
+  return manager;
+}
+
+std::vector<std::string> GetNames(const std::vector<std::shared_ptr<ComponentManager>>& cycle)
+{
+  std::vector<std::string> names;
+  for (const auto& manager : cycle)
+  {
+    names.push_back(manager->GetName());
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+}
+
+TEST(DependencyGraphTest, NoCycles)
+{
+  auto a = CreateComponent("A", {});
+  auto b = CreateComponent("B", { { "A", "1..1" } });
+  auto c = CreateComponent("C", { { "A", "1..n" }, { "B", "1..1" } });
+  DependencyGraph graph({ a, b, c });
+  EXPECT_TRUE(graph.FindCycles({ a, b, c }).empty());
+}
+
+TEST(DependencyGraphTest, FindCycles)
+{
+  // A -> B -> C -> A is a cycle, D depends on the cycle but is not part of it
+  auto a = CreateComponent("A", { { "B", "1..1" } });
+  auto b = CreateComponent("B", { { "C", "1..n" } });
+  auto c = CreateComponent("C", { { "A", "1..1" } });
+  auto d = CreateComponent("D", { { "A", "1..1" } });
+  DependencyGraph graph({ a, b, c, d });
+
+  // cycles are only returned if they contain one of the given components
+  EXPECT_TRUE(graph.FindCycles({ d }).empty());
+
+  auto cycles = graph.FindCycles({ b, d });
+  ASSERT_EQ(cycles.size(), 1u);
+  EXPECT_EQ(GetNames(cycles[0]), (std::vector<std::string>{ "A", "B", "C" }));
+}
+
+TEST(DependencyGraphTest, OptionalReferencesAndSelfReferences)
+{
+  // optional references and references to the component's own service can
+  // be satisfied and do not form cycles
+  auto a = CreateComponent("A", { { "B", "0..1" }, { "A", "1..1" } });
+  auto b = CreateComponent("B", { { "A", "1..1" } });
+  auto c = CreateComponent("C", { { "D", "0..n" } });
+  auto d = CreateComponent("D", { { "C", "1..n" } });
+  DependencyGraph graph({ a, b, c, d });
+  EXPECT_TRUE(graph.FindCycles({ a, b, c, d }).empty());
+}
+
+TEST(DependencyGraphTest, DeepGraph)
+{
+  // a long chain of components, closed to a cycle by its first component
+  const std::size_t count = 1000;
+  std::vector<std::shared_ptr<ComponentManager>> managers;
+  managers.push_back(CreateComponent("Node0", { { "Node" + std::to_string(count - 1), "1..1" } }));
+  for (std::size_t i = 1; i < count; ++i)
+  {
+    managers.push_back(CreateComponent("Node" + std::to_string(i),
+                                       { { "Node" + std::to_string(i - 1), "1..1" } }));
+  }
+  DependencyGraph graph(managers);
+  auto cycles = graph.FindCycles({ managers.back() });
+  ASSERT_EQ(cycles.size(), 1u);
+  EXPECT_EQ(cycles[0].size(), count);
+}
+
+TEST(DependencyGraphTest, AddAndRemove)
+{
+  // the cycle A -> B -> C -> A is closed when the bundle of C is loaded and
+  // opened again when it is unloaded
+  auto a = CreateComponent("A", { { "B", "1..1" } });
+  auto b = CreateComponent("B", { { "C", "1..1" } });
+  auto c = CreateComponent("C", { { "A", "1..1" } });
+  DependencyGraph graph;
+  graph.Add({ a, b });
+  EXPECT_TRUE(graph.FindCycles({ a, b }).empty());
+
+  graph.Add({ c });
+  auto cycles = graph.FindCycles({ c });
+  ASSERT_EQ(cycles.size(), 1u);
+  EXPECT_EQ(GetNames(cycles[0]), (std::vector<std::string>{ "A", "B", "C" }));
+
+  graph.Remove({ c });
+  EXPECT_TRUE(graph.FindCycles({ a, b }).empty());
+}
+
+TEST(DependencyGraphTest, FindCyclesOnlyVisitsReachableComponents)
+{
+  // A -> B -> A is a cycle, C and D are not reachable from it
+  auto a = CreateComponent("A", { { "B", "1..1" } });
+  auto b = CreateComponent("B", { { "A", "1..1" } });
+  auto c = CreateComponent("C", { { "D", "1..1" } });
+  auto d = CreateComponent("D", {});
+  DependencyGraph graph({ a, b, c, d });
+  EXPECT_CALL(*c, GetMetadata()).Times(0);
+  EXPECT_CALL(*d, GetMetadata()).Times(0);
+  auto cycles = graph.FindCycles({ a });
+  ASSERT_EQ(cycles.size(), 1u);
+  EXPECT_EQ(GetNames(cycles[0]), (std::vector<std::string>{ "A", "B" }));
+}
+}
+}
@@ -135,6 +135,20 @@ TEST_F(MetadataParserImplV1Test, ParseDynManifest)
             42);
 }
 
+TEST_F(MetadataParserImplV1Test, ParseIdleTimeout)
+{
+  auto metadataparser = MetadataParserFactory::Create(1, GetLogger());
+  auto components = metadataparser->ParseAndGetComponentsMetadata(
+    ManifestHelper::GetTestManifest("manifest_idle_timeout"));
+  ASSERT_EQ(components.size(), 1ul);
+  ASSERT_EQ(components[0]->immediate, false);
+  ASSERT_EQ(components[0]->idleTimeout, std::chrono::milliseconds(5000));
+
+  components = metadataparser->ParseAndGetComponentsMetadata(
+    ManifestHelper::GetTestManifest("manifest_json"));
+  ASSERT_EQ(components[0]->idleTimeout, std::chrono::milliseconds(0));
+}
+
 TEST_F(MetadataParserImplV1Test, ParseMultComps)
 {
   auto metadataparser = MetadataParserFactory::Create(1, GetLogger());
@@ -298,6 +312,14 @@ INSTANTIATE_TEST_SUITE_P(
       "manifest_illegal_immediate",
       "Invalid value specified for the name 'immediate'. Could not load the "
       "component with index: 0"),
+    MetadataInvalidManifestState(
+      "manifest_negative_idle_timeout",
+      "Invalid value specified for the name 'idle-timeout'. Could not load the "
+      "component with index: 0"),
+    MetadataInvalidManifestState(
+      "manifest_immediate_idle_timeout",
+      "Invalid value specified for the name 'idle-timeout'. Could not load the "
+      "component with index: 0"),
     MetadataInvalidManifestState(
       "manifest_no_impl_class",
       "Missing key 'implementation-class' in the manifest. Could not load the "
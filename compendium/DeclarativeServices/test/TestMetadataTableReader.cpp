@@ -0,0 +1,267 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "Mocks.hpp"
+#include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
+#include "../src/metadata/MetadataParserImpl.hpp"
+#include "../src/metadata/MetadataTableReader.hpp"
+#include "gtest/gtest.h"
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/BundleResourceStream.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "TestUtils.hpp"
+
+#include <sstream>
+
+using cppmicroservices::Any;
+using cppmicroservices::AnyMap;
+using cppmicroservices::service::component::ComponentConstants::
+  SERVICE_COMPONENT;
+
+namespace cppmicroservices {
+namespace scrimpl {
+namespace metadata {
+
+namespace {
+AnyMap CreateSCRMap(const std::vector<std::string>& implClassNames)
+{
+  std::vector<Any> components;
+  for (const auto& implClassName : implClassNames) {
+    AnyMap component(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    component["implementation-class"] = implClassName;
+    components.push_back(component);
+  }
+  AnyMap scrmap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  scrmap["version"] = 1;
+  scrmap["components"] = components;
+  return scrmap;
+}
+
+// Serializes component metadata in the format written by SCRCodeGen
+class TableWriter
+{
+public:
+  TableWriter& UInt32(uint32_t value)
+  {
+    for (int i = 0; i < 4; ++i) {
+      data += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+    return *this;
+  }
+
+  TableWriter& Bool(bool value)
+  {
+    data += value ? '\1' : '\0';
+    return *this;
+  }
+
+  TableWriter& String(const std::string& value)
+  {
+    UInt32(static_cast<uint32_t>(value.size()));
+    data += value;
+    return *this;
+  }
+
+  std::string data{ "USCM" };
+};
+
+std::string CreateTable()
+{
+  TableWriter writer;
+  writer.UInt32(1).UInt32(2);
+  writer.String("comp1").String("sample::Impl").Bool(false).Bool(true);
+  writer.String("prototype").UInt32(2).String("test::Interface1").String("test::Interface2");
+  writer.UInt32(1).String("ref").String("test::Interface3").String("(foo=bar)");
+  writer.String("0..n").String("dynamic").String("greedy").String("bundle");
+  writer.String("sample::Impl2").String("sample::Impl2").Bool(true).Bool(false);
+  writer.String("singleton").UInt32(0).UInt32(0);
+  return writer.data;
+}
+
+std::vector<std::shared_ptr<ComponentMetadata>> CreateComponentsMetadata(
+  const std::string& table,
+  const AnyMap& scrmap)
+{
+  std::istringstream in(table);
+  return metadata::CreateComponentsMetadata(in, scrmap);
+}
+}
+
+TEST(MetadataTableReaderTest, CreateComponentsMetadata)
+{
+  auto scrmap = CreateSCRMap({ "sample::Impl", "sample::Impl2" });
+  AnyMap props(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  props["foo"] = std::string("bar");
+  ref_any_cast<AnyMap>(ref_any_cast<std::vector<Any>>(scrmap["components"])[0])["properties"] = props;
+
+  auto componentsMetadata = CreateComponentsMetadata(CreateTable(), scrmap);
+  ASSERT_EQ(componentsMetadata.size(), 2u);
+
+  const auto& comp1 = *componentsMetadata[0];
+  EXPECT_EQ(comp1.name, "comp1");
+  EXPECT_EQ(comp1.implClassName, "sample::Impl");
+  EXPECT_FALSE(comp1.enabled);
+  EXPECT_TRUE(comp1.immediate);
+  EXPECT_EQ(comp1.serviceMetadata.scope, "prototype");
+  EXPECT_EQ(comp1.serviceMetadata.interfaces,
+            (std::vector<std::string>{ "test::Interface1", "test::Interface2" }));
+  ASSERT_EQ(comp1.properties.size(), 1u);
+  EXPECT_EQ(any_cast<std::string>(comp1.properties.at("foo")), "bar");
+  ASSERT_EQ(comp1.refsMetadata.size(), 1u);
+  const auto& ref = comp1.refsMetadata[0];
+  EXPECT_EQ(ref.name, "ref");
+  EXPECT_EQ(ref.interfaceName, "test::Interface3");
+  EXPECT_EQ(ref.target, "(foo=bar)");
+  EXPECT_EQ(ref.cardinality, "0..n");
+  EXPECT_EQ(ref.policy, "dynamic");
+  EXPECT_EQ(ref.policyOption, "greedy");
+  EXPECT_EQ(ref.scope, "bundle");
+
+  const auto& comp2 = *componentsMetadata[1];
+  EXPECT_EQ(comp2.name, "sample::Impl2");
+  EXPECT_TRUE(comp2.enabled);
+  EXPECT_FALSE(comp2.immediate);
+  EXPECT_TRUE(comp2.serviceMetadata.interfaces.empty());
+  EXPECT_TRUE(comp2.refsMetadata.empty());
+  EXPECT_TRUE(comp2.properties.empty());
+}
+
+TEST(MetadataTableReaderTest, CreateComponentsMetadataMismatch)
+{
+  const auto table = CreateTable();
+  // different number of components
+  EXPECT_THROW(CreateComponentsMetadata(table, CreateSCRMap({ "sample::Impl" })),
+               std::runtime_error);
+  // different implementation class
+  EXPECT_THROW(CreateComponentsMetadata(
+                 table, CreateSCRMap({ "sample::Impl", "sample::Other" })),
+               std::runtime_error);
+}
+
+TEST(MetadataTableReaderTest, CreateComponentsMetadataMalformed)
+{
+  const auto table = CreateTable();
+  const auto scrmap = CreateSCRMap({ "sample::Impl", "sample::Impl2" });
+  // truncated
+  EXPECT_THROW(CreateComponentsMetadata(table.substr(0, table.size() - 1), scrmap),
+               std::runtime_error);
+  EXPECT_THROW(CreateComponentsMetadata("", scrmap), std::runtime_error);
+  // wrong magic
+  EXPECT_THROW(CreateComponentsMetadata("XSCM" + table.substr(4), scrmap),
+               std::runtime_error);
+  // unknown version
+  auto unknownVersion = table;
+  unknownVersion[4] = 2;
+  EXPECT_THROW(CreateComponentsMetadata(unknownVersion, scrmap),
+               std::runtime_error);
+  // string length beyond the end of the table
+  auto bogusLength = table;
+  bogusLength[15] = '\x7f';
+  EXPECT_THROW(CreateComponentsMetadata(bogusLength, scrmap),
+               std::runtime_error);
+}
+
+class MetadataTableReaderBundleTest
+  : public ::testing::TestWithParam<std::string>
+{
+protected:
+  MetadataTableReaderBundleTest()
+    : framework(cppmicroservices::FrameworkFactory().NewFramework())
+  {}
+
+  void SetUp() override { framework.Start(); }
+
+  void TearDown() override
+  {
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  cppmicroservices::Framework framework;
+};
+
+// The metadata generated by SCRCodeGen must be equal to the metadata
+// parsed from the manifest of the bundle
+TEST_P(MetadataTableReaderBundleTest, TableMatchesManifest)
+{
+  auto context = framework.GetBundleContext();
+  test::InstallLib(context, GetParam());
+  cppmicroservices::Bundle bundle;
+  for (auto const& b : context.GetBundles()) {
+    if (b.GetSymbolicName() == GetParam()) {
+      bundle = b;
+    }
+  }
+  ASSERT_TRUE(bundle);
+  auto const& scrmap =
+    ref_any_cast<AnyMap>(bundle.GetHeaders().at(SERVICE_COMPONENT));
+
+  MetadataParserImplV1 parser(std::make_shared<FakeLogger>());
+  auto fromManifest = parser.ParseAndGetComponentsMetadata(scrmap);
+  ASSERT_FALSE(fromManifest.empty());
+
+  auto tableResource = bundle.GetResource(COMPONENT_METADATA_RESOURCE);
+  ASSERT_TRUE(tableResource.IsValid());
+  BundleResourceStream table(tableResource, std::ios_base::binary);
+  auto fromTable = metadata::CreateComponentsMetadata(table, scrmap);
+
+  ASSERT_EQ(fromTable.size(), fromManifest.size());
+  for (std::size_t i = 0; i < fromTable.size(); ++i) {
+    const auto& expected = *fromManifest[i];
+    const auto& actual = *fromTable[i];
+    EXPECT_EQ(actual.name, expected.name);
+    EXPECT_EQ(actual.implClassName, expected.implClassName);
+    EXPECT_EQ(actual.enabled, expected.enabled);
+    EXPECT_EQ(actual.immediate, expected.immediate);
+    EXPECT_EQ(actual.serviceMetadata.scope, expected.serviceMetadata.scope);
+    EXPECT_EQ(actual.serviceMetadata.interfaces,
+              expected.serviceMetadata.interfaces);
+    EXPECT_EQ(actual.properties.size(), expected.properties.size());
+    ASSERT_EQ(actual.refsMetadata.size(), expected.refsMetadata.size());
+    for (std::size_t j = 0; j < actual.refsMetadata.size(); ++j) {
+      const auto& expectedRef = expected.refsMetadata[j];
+      const auto& actualRef = actual.refsMetadata[j];
+      EXPECT_EQ(actualRef.name, expectedRef.name);
+      EXPECT_EQ(actualRef.interfaceName, expectedRef.interfaceName);
+      EXPECT_EQ(actualRef.target, expectedRef.target);
+      EXPECT_EQ(actualRef.cardinality, expectedRef.cardinality);
+      EXPECT_EQ(actualRef.minCardinality, expectedRef.minCardinality);
+      EXPECT_EQ(actualRef.maxCardinality, expectedRef.maxCardinality);
+      EXPECT_EQ(actualRef.policy, expectedRef.policy);
+      EXPECT_EQ(actualRef.policyOption, expectedRef.policyOption);
+      EXPECT_EQ(actualRef.scope, expectedRef.scope);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(GeneratedBundles,
+                         MetadataTableReaderBundleTest,
+                         testing::Values("TestBundleDSTOI1",
+                                         "TestBundleDSTOI5",
+                                         "DSSpellChecker",
+                                         "DSGraph01"));
+}
+}
+}
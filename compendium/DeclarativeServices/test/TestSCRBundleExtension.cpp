@@ -25,10 +25,17 @@
 #include <cppmicroservices/FrameworkFactory.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
 #include "cppmicroservices/servicecomponent/ComponentConstants.hpp"
 #include "../src/SCRBundleExtension.hpp"
 #include "Mocks.hpp"
 #include "../src/metadata/Util.hpp"
+#include "../src/metadata/ComponentMetadata.hpp"
+#include "TestUtils.hpp"
+
+#if !defined(_WIN32)
+#  include <dlfcn.h>
+#endif
 
 #define str(s) #s
 #define xstr(s) str(s)
@@ -105,11 +112,16 @@ TEST_F(SCRBundleExtensionTest, CtorWithValidArgs)
   auto const& scr = ref_any_cast<cppmicroservices::AnyMap>(thisBundle.GetHeaders().at("scr_test_0"));
 
   auto mockRegistry = std::make_shared<MockComponentRegistry>();
+  // a failing batch falls back to adding each component, so that only the
+  // failing component is dropped
+  EXPECT_CALL(*mockRegistry, AddComponentManagers(testing::_))
+    .Times(2)
+    .WillRepeatedly(testing::Throw(std::runtime_error("Failed to add components")));
   EXPECT_CALL(*mockRegistry, AddComponentManager(testing::_))
     .Times(2)
     .WillOnce(testing::Throw(std::runtime_error("Failed to add component")))
     .WillOnce(testing::Return(true));
-  EXPECT_CALL(*mockRegistry, RemoveComponentManager(testing::_))
+  EXPECT_CALL(*mockRegistry, RemoveComponentManagers(testing::SizeIs(1)))
     .Times(1);
   auto fakeLogger = std::make_shared<FakeLogger>();
   EXPECT_NO_THROW({
@@ -127,5 +139,46 @@ TEST_F(SCRBundleExtensionTest, CtorWithValidArgs)
       EXPECT_EQ(bundleExt.managers.size(), 1u);
     });
 }
+
+// The metadata of a bundle generated by SCRCodeGen is read from its
+// resources, without parsing the manifest or loading the bundle binary
+TEST_F(SCRBundleExtensionTest, CtorReadsMetadataFromBundleResource)
+{
+  auto bundle = test::InstallAndStartBundle(GetFramework().GetBundleContext(),
+                                            "TestBundleDSTOI2");
+  ASSERT_TRUE(static_cast<bool>(bundle));
+  ASSERT_TRUE(bundle.GetResource("scr_metadata.bin").IsValid());
+
+  // the component is disabled in the serialized metadata. Enable it in the
+  // manifest, so that only the manifest parser would enable it.
+  auto scr = ref_any_cast<cppmicroservices::AnyMap>(bundle.GetHeaders().at(SERVICE_COMPONENT));
+  auto& components = ref_any_cast<std::vector<Any>>(scr.at("components"));
+  ref_any_cast<cppmicroservices::AnyMap>(components.at(0))["enabled"] = true;
+
+  auto mockRegistry = std::make_shared<MockComponentRegistry>();
+  std::vector<std::shared_ptr<ComponentManager>> added;
+  EXPECT_CALL(*mockRegistry, AddComponentManagers(testing::_))
+    .WillOnce(testing::DoAll(testing::SaveArg<0>(&added), testing::ReturnArg<0>()));
+  EXPECT_CALL(*mockRegistry, RemoveComponentManagers(testing::SizeIs(1)))
+    .Times(1);
+  {
+    SCRBundleExtension bundleExt(bundle.GetBundleContext(),
+                                 scr,
+                                 mockRegistry,
+                                 std::make_shared<FakeLogger>());
+    ASSERT_EQ(added.size(), 1u);
+    auto compMetadata = added[0]->GetMetadata();
+    EXPECT_EQ(compMetadata->implClassName, "sample::ServiceComponent2");
+    EXPECT_FALSE(compMetadata->enabled);
+    EXPECT_TRUE(compMetadata->immediate);
+  }
+#if !defined(_WIN32)
+  void* handle = dlopen(bundle.GetLocation().c_str(), RTLD_LAZY | RTLD_LOCAL | RTLD_NOLOAD);
+  EXPECT_EQ(handle, nullptr) << "The bundle binary was loaded";
+  if (handle != nullptr) {
+    dlclose(handle);
+  }
+#endif
+}
 }
 }
@@ -368,5 +368,73 @@ TEST_F(ServiceComponentRuntimeImplTest, TestServiceReferenceDTO)
   EXPECT_EQ(sRefDTO.properties.size(), sRef.GetPropertyKeys().size());
   EXPECT_EQ(sRefDTO.usingBundles.size(), sRef.GetUsingBundles().size());
 }
+
+TEST_F(ServiceComponentRuntimeImplTest, Validate_GetTransitionStatistics)
+{
+  auto mockRegistry = std::make_shared<MockComponentRegistry>();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  {
+    ServiceComponentRuntimeImpl service(GetFramework().GetBundleContext(),
+                                        mockRegistry,
+                                        fakeLogger);
+    auto stats = service.GetTransitionStatistics();
+    EXPECT_EQ(stats.queued, 0u);
+    EXPECT_EQ(stats.running, 0u);
+    EXPECT_EQ(stats.threads, 0u);
+  }
+  auto executor = std::make_shared<TransitionExecutor>(1);
+  ComponentRuntimeContext runtime;
+  runtime.executor = executor;
+  ServiceComponentRuntimeImpl service(GetFramework().GetBundleContext(),
+                                      mockRegistry,
+                                      fakeLogger,
+                                      runtime);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  auto first = executor->Submit([released]() { released.wait(); });
+  auto second = executor->Submit([]() {});
+  while(executor->GetRunningCount() == 0u)
+  {
+    std::this_thread::yield();
+  }
+  auto stats = service.GetTransitionStatistics();
+  EXPECT_EQ(stats.queued, 1u);
+  EXPECT_EQ(stats.running, 1u);
+  EXPECT_EQ(stats.threads, 1u);
+  release.set_value();
+  second.get();
+  stats = service.GetTransitionStatistics();
+  EXPECT_EQ(stats.queued, 0u);
+}
+
+TEST_F(ServiceComponentRuntimeImplTest, Validate_GetActivationStatistics)
+{
+  auto mockRegistry = std::make_shared<MockComponentRegistry>();
+  auto fakeLogger = std::make_shared<FakeLogger>();
+  {
+    ServiceComponentRuntimeImpl service(GetFramework().GetBundleContext(),
+                                        mockRegistry,
+                                        fakeLogger);
+    auto stats = service.GetActivationStatistics();
+    EXPECT_EQ(stats.activations, 0u);
+    EXPECT_EQ(stats.pendingIdleDeactivations, 0u);
+  }
+  auto tracker = std::make_shared<ActivationTracker>();
+  ComponentRuntimeContext runtime;
+  runtime.activationTracker = tracker;
+  ServiceComponentRuntimeImpl service(GetFramework().GetBundleContext(),
+                                      mockRegistry,
+                                      fakeLogger,
+                                      runtime);
+  tracker->CountActivation();
+  tracker->CountActivation();
+  tracker->CountDeactivation(true);
+  tracker->Schedule(std::chrono::seconds(60), []() {});
+  auto stats = service.GetActivationStatistics();
+  EXPECT_EQ(stats.activations, 2u);
+  EXPECT_EQ(stats.deactivations, 1u);
+  EXPECT_EQ(stats.idleDeactivations, 1u);
+  EXPECT_EQ(stats.pendingIdleDeactivations, 1u);
+}
 }
 }
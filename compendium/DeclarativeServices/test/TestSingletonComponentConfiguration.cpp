@@ -206,6 +206,67 @@ TEST_F(SingletonComponentConfigurationTest, TestDestroyComponentInstances_Deacti
   EXPECT_EQ(obj->GetComponentContext(), nullptr);
   EXPECT_EQ(obj->GetState()->GetValue(), ComponentState::UNSATISFIED_REFERENCE);
 }
+TEST_F(SingletonComponentConfigurationTest, TestIdleDeactivation)
+{
+  // the instance of a delayed component is deactivated once it was not used
+  // for its idle timeout, and activated again by the next GetService call
+  auto metadata = std::make_shared<metadata::ComponentMetadata>();
+  metadata->idleTimeout = std::chrono::milliseconds(20);
+  auto tracker = std::make_shared<ActivationTracker>(std::chrono::milliseconds(2));
+  ComponentRuntimeContext runtime;
+  runtime.activationTracker = tracker;
+  auto config = std::make_shared<SingletonComponentConfigurationImpl>(metadata,
+                                                                      framework,
+                                                                      std::make_shared<MockComponentRegistry>(),
+                                                                      std::make_shared<FakeLogger>(),
+                                                                      runtime);
+  MockComponentInstanceFactory mockCompFactory;
+  auto mockInstance1 = new MockComponentInstance();
+  auto mockInstance2 = new MockComponentInstance();
+  config->SetState(std::make_shared<CCRegisteredState>());
+  config->SetComponentInstanceCreateDeleteMethods(std::bind(&MockComponentInstanceFactory::CreateComponentInstance, &mockCompFactory), std::bind(&MockComponentInstanceFactory::DeleteComponentInstance, &mockCompFactory, std::placeholders::_1));
+  EXPECT_CALL(mockCompFactory, CreateComponentInstance())
+    .Times(2)
+    .WillOnce(testing::Return(mockInstance1))
+    .WillOnce(testing::Return(mockInstance2));
+  EXPECT_CALL(mockCompFactory, DeleteComponentInstance(testing::_))
+    .Times(2)
+    .WillRepeatedly(testing::Invoke([](ComponentInstance* inst) {
+                                      delete inst;
+                                    }));
+  cppmicroservices::InterfaceMapPtr iMap;
+  for(auto inst : { mockInstance1, mockInstance2 })
+  {
+    EXPECT_CALL(*inst, CreateInstanceAndBindReferences(testing::_)).Times(1);
+    EXPECT_CALL(*inst, Activate()).Times(1);
+    EXPECT_CALL(*inst, GetInterfaceMap()).WillRepeatedly(testing::Return(iMap));
+    EXPECT_CALL(*inst, Deactivate()).Times(1);
+    EXPECT_CALL(*inst, UnbindReferences()).Times(1);
+  }
+
+  config->GetService(framework, ServiceRegistrationU());
+  EXPECT_EQ(config->GetState()->GetValue(), ComponentState::ACTIVE);
+  config->UngetService(framework, ServiceRegistrationU(), iMap);
+  EXPECT_EQ(tracker->GetScheduledCount(), 1u);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while(tracker->GetIdleDeactivationCount() == 0 && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(tracker->GetIdleDeactivationCount(), 1u);
+  EXPECT_EQ(config->GetState()->GetValue(), ComponentState::SATISFIED);
+  EXPECT_EQ(config->GetComponentInstance(), nullptr);
+
+  // a service which is in use is never deactivated
+  config->GetService(framework, ServiceRegistrationU());
+  EXPECT_EQ(config->GetState()->GetValue(), ComponentState::ACTIVE);
+  EXPECT_NE(config->GetComponentInstance(), nullptr);
+  EXPECT_EQ(tracker->GetScheduledCount(), 0u);
+  EXPECT_EQ(tracker->GetActivationCount(), 2u);
+  config.reset();
+  EXPECT_EQ(tracker->GetDeactivationCount(), 2u);
+  EXPECT_EQ(tracker->GetIdleDeactivationCount(), 1u);
+}
 }
 }
 
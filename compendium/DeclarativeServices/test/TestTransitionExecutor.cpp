@@ -0,0 +1,206 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "../src/manager/TransitionExecutor.hpp"
+#include "ConcurrencyTestUtil.hpp"
+
+namespace cppmicroservices {
+namespace scrimpl {
+
+TEST(TransitionExecutorTest, TestThreadCount)
+{
+  TransitionExecutor executor(3);
+  EXPECT_EQ(executor.GetThreadCount(), 3u);
+  TransitionExecutor defaultExecutor;
+  EXPECT_GE(defaultExecutor.GetThreadCount(), 1u);
+}
+
+TEST(TransitionExecutorTest, TestRunsAllTasks)
+{
+  std::atomic<int> count{0};
+  TransitionExecutor executor(4);
+  std::vector<std::shared_future<void>> futures;
+  for(int i = 0; i < 200; ++i)
+  {
+    futures.push_back(executor.Submit([&count]() { ++count; }));
+  }
+  for(auto& fut : futures)
+  {
+    fut.get();
+  }
+  EXPECT_EQ(count.load(), 200);
+  EXPECT_EQ(executor.GetQueuedCount(), 0u);
+}
+
+TEST(TransitionExecutorTest, TestDestructorRunsQueuedTasks)
+{
+  std::atomic<int> count{0};
+  std::vector<std::shared_future<void>> futures;
+  {
+    TransitionExecutor executor(2);
+    for(int i = 0; i < 50; ++i)
+    {
+      futures.push_back(executor.Submit([&count]() {
+                                          std::this_thread::sleep_for(std::chrono::microseconds(100));
+                                          ++count;
+                                        }));
+    }
+  }
+  EXPECT_EQ(count.load(), 50);
+  for(auto& fut : futures)
+  {
+    EXPECT_NO_THROW(fut.get());
+  }
+}
+
+TEST(TransitionExecutorTest, TestExceptionIsStoredInFuture)
+{
+  TransitionExecutor executor(1);
+  auto fut = executor.Submit([]() { throw std::runtime_error("transition failed"); });
+  EXPECT_THROW(fut.get(), std::runtime_error);
+  // the worker thread survives the exception
+  EXPECT_NO_THROW(executor.Submit([]() {}).get());
+}
+
+TEST(TransitionExecutorTest, TestBoundedNumberOfRunningTasks)
+{
+  TransitionExecutor executor(2);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> maxRunning{0};
+  std::atomic<int> running{0};
+  std::vector<std::shared_future<void>> futures;
+  for(int i = 0; i < 8; ++i)
+  {
+    futures.push_back(executor.Submit([&, released]() {
+                                        auto now = ++running;
+                                        auto prev = maxRunning.load();
+                                        while(prev < now && !maxRunning.compare_exchange_weak(prev, now)) {}
+                                        released.wait();
+                                        --running;
+                                      }));
+  }
+  EXPECT_TRUE(WaitFor([&]() { return executor.GetRunningCount() == 2u; }));
+  EXPECT_EQ(executor.GetQueuedCount(), 6u);
+  release.set_value();
+  for(auto& fut : futures)
+  {
+    fut.get();
+  }
+  EXPECT_EQ(maxRunning.load(), 2);
+  EXPECT_TRUE(WaitFor([&]() { return executor.GetRunningCount() == 0u; }));
+  EXPECT_EQ(executor.GetQueuedCount(), 0u);
+}
+
+TEST(TransitionExecutorTest, TestNestedTransitionDoesNotDeadlock)
+{
+  // a transition waiting for a transition it submitted must not block the
+  // only worker thread forever
+  TransitionExecutor executor(1);
+  std::atomic<bool> innerRan{false};
+  auto fut = executor.Submit([&]() {
+                               executor.Submit([&innerRan]() { innerRan = true; }).get();
+                             });
+  ASSERT_EQ(fut.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  EXPECT_TRUE(innerRan.load());
+}
+
+TEST(TransitionExecutorTest, TestWaitingWorkerRunsQueuedTasks)
+{
+  // the only worker waits for a task which was queued from outside of the
+  // executor after the waiting task
+  TransitionExecutor executor(1);
+  std::promise<std::shared_future<void>> queuedLater;
+  auto queuedFuture = queuedLater.get_future().share();
+  auto fut = executor.Submit([&]() {
+                               auto inner = queuedFuture.get();
+                               executor.Wait(inner);
+                               inner.get();
+                             });
+  std::atomic<bool> innerRan{false};
+  queuedLater.set_value(executor.Submit([&innerRan]() { innerRan = true; }));
+  ASSERT_EQ(fut.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  EXPECT_TRUE(innerRan.load());
+}
+
+TEST(TransitionExecutorTest, TestSubmitAfterShutdown)
+{
+  TransitionExecutor executor(2);
+  std::atomic<int> count{0};
+  executor.Submit([&count]() { ++count; });
+  executor.Shutdown();
+  EXPECT_EQ(count.load(), 1);
+  // tasks submitted after the shutdown run on the calling thread
+  auto fut = executor.Submit([&count]() { ++count; });
+  EXPECT_EQ(fut.wait_for(std::chrono::seconds::zero()), std::future_status::ready);
+  EXPECT_EQ(count.load(), 2);
+}
+TEST(TransitionExecutorTest, TestNestedSubmitDuringShutdown)
+{
+  // a task on an overflow thread submits a task after the only worker
+  // thread stopped, which must still run
+  TransitionExecutor executor(1);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<bool> innerRan{false};
+  std::atomic<bool> innerReady{false};
+  executor.Submit([&, released]() {
+                    released.wait();
+                    // the only worker is busy, so this runs on an overflow thread
+                    executor.Submit([&]() {
+                                      WaitFor([&]() { return executor.GetRunningCount() == 1u; });
+                                      auto inner = executor.Submit([&innerRan]() { innerRan = true; });
+                                      innerReady = (inner.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+                                    });
+                  });
+  std::thread shutdown([&executor]() { executor.Shutdown(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  release.set_value();
+  shutdown.join();
+  EXPECT_TRUE(innerReady.load());
+  EXPECT_TRUE(innerRan.load());
+}
+
+TEST(TransitionExecutorTest, TestWaitingWorkerWakesUpWhenTaskFinishes)
+{
+  // a worker waiting for a task running on another worker is woken up
+  // when that task finished
+  TransitionExecutor executor(2);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  auto blocked = executor.Submit([released]() { released.wait(); });
+  auto waiting = executor.Submit([&executor, blocked]() { executor.Wait(blocked); });
+  EXPECT_TRUE(WaitFor([&]() { return executor.GetRunningCount() == 2u; }));
+  EXPECT_EQ(waiting.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+  release.set_value();
+  ASSERT_EQ(waiting.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+}
+}
+}
@@ -0,0 +1,407 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/logservice/LogService.hpp>
+
+#include "../../src/SCRBundleExtension.hpp"
+#include "../../src/ServiceComponentRuntimeImpl.hpp"
+#include "../../src/manager/ComponentRuntimeContext.hpp"
+#include "../../src/manager/ReferenceManagerImpl.hpp"
+#include "../TestUtils.hpp"
+#include "TestInterfaces/Interfaces.hpp"
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using cppmicroservices::Any;
+using cppmicroservices::AnyMap;
+
+namespace {
+
+/// Discards all log messages.
+class NullLogger : public cppmicroservices::logservice::LogService
+{
+public:
+  using SeverityLevel = cppmicroservices::logservice::SeverityLevel;
+  void Log(SeverityLevel, const std::string&) override {}
+  void Log(SeverityLevel, const std::string&, const std::exception_ptr) override
+  {}
+  void Log(const cppmicroservices::ServiceReferenceBase&,
+           SeverityLevel,
+           const std::string&) override
+  {}
+  void Log(const cppmicroservices::ServiceReferenceBase&,
+           SeverityLevel,
+           const std::string&,
+           const std::exception_ptr) override
+  {}
+};
+
+/// Used to satisfy the test::Interface2 references of the components.
+class Interface2Impl : public test::Interface2
+{
+public:
+  std::string ExtendedDescription() override { return "Interface2Impl"; }
+};
+
+/// Returns SCR metadata with the given number of components. All
+/// components use the implementation class of the BenchmarkDS bundle and
+/// provide test::Interface1.
+AnyMap CreateMetadata(std::size_t componentCount,
+                      bool immediate,
+                      bool withReference = false)
+{
+  std::vector<Any> components;
+  components.reserve(componentCount);
+  for (std::size_t i = 0; i < componentCount; ++i) {
+    AnyMap component(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    component["name"] = std::string("benchmark::Component") + std::to_string(i);
+    component["implementation-class"] =
+      std::string("sample::DSBenchmarkComponent");
+    component["immediate"] = immediate;
+    AnyMap service(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    service["interfaces"] =
+      std::vector<Any>{ std::string("test::Interface1") };
+    component["service"] = service;
+    if (withReference) {
+      AnyMap reference(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+      reference["name"] = std::string("dependency");
+      reference["interface"] = std::string("test::Interface2");
+      component["references"] = std::vector<Any>{ reference };
+    }
+    components.push_back(component);
+  }
+  AnyMap metadata(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  metadata["version"] = 1;
+  metadata["components"] = components;
+  return metadata;
+}
+
+/// Returns SCR metadata for a dependency graph with the given number of
+/// components. Component i provides the service benchmark::Node<i> and
+/// has a mandatory reference to the service of component i / 2, which
+/// makes the graph a binary tree. The root component references
+/// test::Interface2, so no component is satisfied until a
+/// test::Interface2 service is registered.
+AnyMap CreateGraphMetadata(std::size_t componentCount, bool immediate)
+{
+  std::vector<Any> components;
+  components.reserve(componentCount);
+  for (std::size_t i = 0; i < componentCount; ++i) {
+    AnyMap component(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    component["name"] = std::string("benchmark::Component") + std::to_string(i);
+    component["implementation-class"] =
+      std::string("sample::DSBenchmarkComponent");
+    component["immediate"] = immediate;
+    AnyMap service(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    service["interfaces"] =
+      std::vector<Any>{ std::string("benchmark::Node") + std::to_string(i) };
+    component["service"] = service;
+    AnyMap reference(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    reference["name"] = std::string("dependency");
+    reference["interface"] =
+      (i == 0) ? std::string("test::Interface2")
+               : std::string("benchmark::Node") + std::to_string(i / 2);
+    component["references"] = std::vector<Any>{ reference };
+    components.push_back(component);
+  }
+  AnyMap metadata(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  metadata["version"] = 1;
+  metadata["components"] = components;
+  return metadata;
+}
+}
+
+/// Starts a framework and the BenchmarkDS bundle without the DS runtime
+/// bundle. The benchmarks drive the SCR implementation directly with
+/// generated metadata, so the number of components can be chosen freely.
+/// The benchmark argument is the number of components. Enabling components
+/// runs on the transition executor threads, so wall clock time is reported.
+class ComponentRuntimeFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State&)
+  {
+    using namespace cppmicroservices;
+
+    framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+    framework->Start();
+    auto context = framework->GetBundleContext();
+    test::InstallLib(context, "BenchmarkDS");
+    for (auto& b : context.GetBundles()) {
+      if (b.GetSymbolicName() == "BenchmarkDS") {
+        bundle = b;
+      }
+    }
+    bundle.Start();
+    registry = std::make_shared<scrimpl::ComponentRegistry>();
+    logger = std::make_shared<NullLogger>();
+    runtime.executor = std::make_shared<scrimpl::TransitionExecutor>();
+  }
+
+  void TearDown(const ::benchmark::State&)
+  {
+    using namespace std::chrono;
+
+    runtime.executor.reset();
+    registry.reset();
+    bundle = cppmicroservices::Bundle();
+    framework->Stop();
+    framework->WaitForStop(milliseconds::zero());
+  }
+
+  ~ComponentRuntimeFixture() { framework.reset(); }
+
+protected:
+  std::unique_ptr<cppmicroservices::scrimpl::SCRBundleExtension>
+  CreateExtension(const AnyMap& metadata)
+  {
+    return std::make_unique<cppmicroservices::scrimpl::SCRBundleExtension>(
+      bundle.GetBundleContext(), metadata, registry, logger, runtime);
+  }
+
+  std::shared_ptr<cppmicroservices::Framework> framework;
+  cppmicroservices::Bundle bundle;
+  std::shared_ptr<cppmicroservices::scrimpl::ComponentRegistry> registry;
+  std::shared_ptr<NullLogger> logger;
+  cppmicroservices::scrimpl::ComponentRuntimeContext runtime;
+};
+
+/// Benchmark loading the components of a bundle, from parsing the SCR
+/// metadata until all components are enabled and their services are
+/// registered. The components are delayed, so none is activated.
+BENCHMARK_DEFINE_F(ComponentRuntimeFixture, LoadComponents)
+(benchmark::State& state)
+{
+  auto const metadata =
+    CreateMetadata(static_cast<std::size_t>(state.range(0)), false);
+  for (auto _ : state) {
+    auto extension = CreateExtension(metadata);
+    state.PauseTiming();
+    extension.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Benchmark loading immediate components, which are activated as soon as
+/// they are enabled.
+BENCHMARK_DEFINE_F(ComponentRuntimeFixture, ActivateImmediateComponents)
+(benchmark::State& state)
+{
+  auto const metadata =
+    CreateMetadata(static_cast<std::size_t>(state.range(0)), true);
+  for (auto _ : state) {
+    auto extension = CreateExtension(metadata);
+    state.PauseTiming();
+    extension.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Benchmark the activation of delayed components, which is triggered by
+/// the first GetService call for each component's service.
+BENCHMARK_DEFINE_F(ComponentRuntimeFixture, ActivateDelayedComponents)
+(benchmark::State& state)
+{
+  auto const metadata =
+    CreateMetadata(static_cast<std::size_t>(state.range(0)), false);
+  auto context = framework->GetBundleContext();
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto extension = CreateExtension(metadata);
+    auto refs = context.GetServiceReferences<test::Interface1>();
+    state.ResumeTiming();
+    for (auto const& ref : refs) {
+      benchmark::DoNotOptimize(context.GetService(ref));
+    }
+    state.PauseTiming();
+    extension.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Benchmark binding and unbinding immediate components with a mandatory
+/// static reference while the referenced service is registered and
+/// unregistered. Each registration activates all components and each
+/// unregistration deactivates them.
+BENCHMARK_DEFINE_F(ComponentRuntimeFixture, RebindUnderServiceChurn)
+(benchmark::State& state)
+{
+  auto const metadata =
+    CreateMetadata(static_cast<std::size_t>(state.range(0)), true, true);
+  auto context = framework->GetBundleContext();
+  auto extension = CreateExtension(metadata);
+  auto service = std::make_shared<Interface2Impl>();
+  for (auto _ : state) {
+    auto reg = context.RegisterService<test::Interface2>(service);
+    reg.Unregister();
+  }
+  extension.reset();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Benchmark querying the description and configuration DTOs of all
+/// components through ServiceComponentRuntime.
+BENCHMARK_DEFINE_F(ComponentRuntimeFixture, QueryComponentDTOs)
+(benchmark::State& state)
+{
+  using cppmicroservices::scrimpl::ServiceComponentRuntimeImpl;
+
+  auto const metadata =
+    CreateMetadata(static_cast<std::size_t>(state.range(0)), true);
+  auto extension = CreateExtension(metadata);
+  ServiceComponentRuntimeImpl scr(
+    framework->GetBundleContext(), registry, logger, runtime);
+  for (auto _ : state) {
+    auto descriptions = scr.GetComponentDescriptionDTOs({ bundle });
+    for (auto const& description : descriptions) {
+      benchmark::DoNotOptimize(
+        scr.GetComponentConfigurationDTOs(description));
+    }
+  }
+  extension.reset();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Benchmark the service event path of the reference managers. The
+/// benchmark argument is the number of reference managers tracking
+/// test::Interface2. All managers are satisfied by a service registered up
+/// front, so each iteration delivers an add and a remove event of a
+/// matching service to every manager without changing its state.
+BENCHMARK_DEFINE_F(ComponentRuntimeFixture, ReferenceManagerServiceChurn)
+(benchmark::State& state)
+{
+  using cppmicroservices::scrimpl::ReferenceManagerImpl;
+  using cppmicroservices::scrimpl::metadata::ReferenceMetadata;
+
+  auto context = framework->GetBundleContext();
+  auto service = std::make_shared<Interface2Impl>();
+  auto boundReg = context.RegisterService<test::Interface2>(service);
+  ReferenceMetadata refMetadata;
+  refMetadata.name = "dependency";
+  refMetadata.interfaceName = us_service_interface_iid<test::Interface2>();
+  refMetadata.policyOption = "greedy";
+  std::vector<std::unique_ptr<ReferenceManagerImpl>> refManagers;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    refManagers.push_back(std::make_unique<ReferenceManagerImpl>(
+      refMetadata,
+      context,
+      logger,
+      std::string("benchmark::Component") + std::to_string(i)));
+  }
+  for (auto _ : state) {
+    auto reg = context.RegisterService<test::Interface2>(service);
+    reg.Unregister();
+  }
+  refManagers.clear();
+  boundReg.Unregister();
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+/// Benchmark the propagation of satisfaction through a component graph.
+/// Each iteration registers the service the root of the graph depends on,
+/// which satisfies and registers all components, and unregisters it again.
+/// The first benchmark argument is the number of components, the second
+/// one is 1 if the components are immediate and activated when satisfied.
+BENCHMARK_DEFINE_F(ComponentRuntimeFixture, SatisfyComponentGraph)
+(benchmark::State& state)
+{
+  using namespace std::chrono;
+
+  auto const componentCount = static_cast<std::size_t>(state.range(0));
+  auto const metadata =
+    CreateGraphMetadata(componentCount, state.range(1) != 0);
+  auto context = framework->GetBundleContext();
+  auto extension = CreateExtension(metadata);
+  auto service = std::make_shared<Interface2Impl>();
+  duration<double> unsatisfyTime{ 0 };
+  for (auto _ : state) {
+    auto start = high_resolution_clock::now();
+    auto reg = context.RegisterService<test::Interface2>(service);
+    auto satisfied = high_resolution_clock::now();
+    if (!context.GetServiceReference(std::string("benchmark::Node") +
+                                     std::to_string(componentCount - 1))) {
+      state.SkipWithError("component graph was not satisfied");
+    }
+    reg.Unregister();
+    auto unsatisfied = high_resolution_clock::now();
+    state.SetIterationTime(
+      duration_cast<duration<double>>(satisfied - start).count());
+    unsatisfyTime += unsatisfied - satisfied;
+  }
+  extension.reset();
+  state.counters["UnsatisfyTime"] = benchmark::Counter(
+    unsatisfyTime.count(), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(ComponentRuntimeFixture, LoadComponents)
+  ->RangeMultiplier(10)
+  ->Range(10, 10000)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ComponentRuntimeFixture, ActivateImmediateComponents)
+  ->RangeMultiplier(10)
+  ->Range(10, 10000)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ComponentRuntimeFixture, ActivateDelayedComponents)
+  ->RangeMultiplier(10)
+  ->Range(10, 10000)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ComponentRuntimeFixture, RebindUnderServiceChurn)
+  ->RangeMultiplier(10)
+  ->Range(10, 10000)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ComponentRuntimeFixture, QueryComponentDTOs)
+  ->RangeMultiplier(10)
+  ->Range(10, 10000)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ComponentRuntimeFixture, ReferenceManagerServiceChurn)
+  ->Arg(1000)
+  ->Iterations(5000)
+  ->Unit(benchmark::kMicrosecond)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(ComponentRuntimeFixture, SatisfyComponentGraph)
+  ->Args({ 1000, 0 })
+  ->Args({ 2000, 0 })
+  ->Args({ 5000, 0 })
+  ->Args({ 5000, 1 })
+  ->Unit(benchmark::kMillisecond)
+  ->UseManualTime();
@@ -0,0 +1,136 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/servicecomponent/ComponentConstants.hpp>
+
+#include "../TestUtils.hpp"
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Installs the bundle with the given symbolic name from the test bundle
+/// directory and returns it.
+cppmicroservices::Bundle InstallBundle(cppmicroservices::BundleContext context,
+                                       const std::string& name)
+{
+  test::InstallLib(context, name);
+  for (auto const& bundle : context.GetBundles()) {
+    if (bundle.GetSymbolicName() == name) {
+      return bundle;
+    }
+  }
+  return {};
+}
+}
+
+/// Starts a framework with the DS runtime and installs the BenchmarkDS and
+/// DSGraph0x bundles. The benchmark argument is the number of threads used
+/// by SCR to enable and disable components.
+class SCRBundleExtensionFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State& state)
+  {
+    using namespace cppmicroservices;
+    using service::component::ComponentConstants::TRANSITION_THREADS;
+
+    FrameworkConfiguration config{ { TRANSITION_THREADS,
+                                     static_cast<int>(state.range(0)) } };
+    framework =
+      std::make_shared<Framework>(FrameworkFactory().NewFramework(config));
+    framework->Start();
+    auto context = framework->GetBundleContext();
+    for (auto& dsBundle :
+         context.InstallBundles(test::GetDSRuntimePluginFilePath())) {
+      dsBundle.Start();
+    }
+
+    const std::vector<std::string> bundleNames = {
+      "BenchmarkDS", "DSGraph01", "DSGraph02", "DSGraph03",
+      "DSGraph04",   "DSGraph05", "DSGraph06", "DSGraph07"
+    };
+    bundles.clear();
+    for (auto const& name : bundleNames) {
+      bundles.push_back(InstallBundle(context, name));
+    }
+  }
+
+  void TearDown(const ::benchmark::State&)
+  {
+    using namespace std::chrono;
+
+    bundles.clear();
+    framework->Stop();
+    framework->WaitForStop(milliseconds::zero());
+  }
+
+  ~SCRBundleExtensionFixture() { framework.reset(); }
+
+protected:
+  std::shared_ptr<cppmicroservices::Framework> framework;
+  std::vector<cppmicroservices::Bundle> bundles;
+};
+
+/// Benchmark starting the DS test bundles, which creates and enables the
+/// components of each bundle, and stopping them again, which disables the
+/// components. Start and stop times are reported separately.
+BENCHMARK_DEFINE_F(SCRBundleExtensionFixture, StartStopDSBundles)
+(benchmark::State& state)
+{
+  using namespace std::chrono;
+
+  duration<double> stopTime{ 0 };
+  for (auto _ : state) {
+    auto start = high_resolution_clock::now();
+    for (auto& bundle : bundles) {
+      bundle.Start();
+    }
+    auto started = high_resolution_clock::now();
+    for (auto& bundle : bundles) {
+      bundle.Stop();
+    }
+    auto stopped = high_resolution_clock::now();
+    state.SetIterationTime(
+      duration_cast<duration<double>>(started - start).count());
+    stopTime += stopped - started;
+  }
+  state.counters["StopTime"] =
+    benchmark::Counter(stopTime.count(), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_REGISTER_F(SCRBundleExtensionFixture, StartStopDSBundles)
+  ->Arg(1)
+  ->Arg(4)
+  ->UseManualTime();
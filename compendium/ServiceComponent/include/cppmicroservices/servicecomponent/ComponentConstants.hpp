@@ -75,6 +75,14 @@ US_ServiceComponent_EXPORT extern const std::string REFERENCE_TARGET_SUFFIX;
  * instance receives a distinct service object.
  */
 US_ServiceComponent_EXPORT extern const std::string REFERENCE_SCOPE_PROTOTYPE_REQUIRED;
+
+/**
+ * Framework launching property specifying the maximum number of threads
+ * Service Component Runtime uses to enable and disable components.
+ * The value of this property must be of type {@code int}. The default
+ * is the number of hardware threads.
+ */
+US_ServiceComponent_EXPORT extern const std::string TRANSITION_THREADS;
 }
 
 }}} // namespaces
@@ -84,6 +84,25 @@ class US_ServiceComponent_EXPORT ComponentInstance {
   virtual cppmicroservices::InterfaceMapPtr GetInterfaceMap() = 0;
 };
 
+/**
+ * An entry of the table of component factory functions generated for a
+ * bundle. The table is terminated by an entry with a null {@code name}.
+ */
+struct ComponentInstanceFactory {
+  const char* name; ///< the component name, or the implementation class name if the component has no name
+  ComponentInstance* (*newInstance)(); ///< creates an instance of the component
+  void (*deleteInstance)(ComponentInstance*); ///< deletes an instance created by newInstance
+};
+
 }}}} // namespaces
 
+/**
+ * Name of the function exported from a bundle which returns the table of
+ * {@code ComponentInstanceFactory} entries of all components in the bundle.
+ * The declarative services runtime uses the table to resolve the factory
+ * functions of a bundle with a single symbol lookup.
+ */
+#define US_SCR_COMPONENT_FACTORIES_PREFIX _us_scr_component_factories_
+#define US_SCR_COMPONENT_FACTORIES_FUNC(bsn) US_CONCAT(US_SCR_COMPONENT_FACTORIES_PREFIX, bsn)
+
 #endif /* ComponentInstance_hpp */
@@ -30,6 +30,8 @@
 
 #include "dto/ComponentDescriptionDTO.hpp"
 #include "dto/ComponentConfigurationDTO.hpp"
+#include "dto/ActivationStatisticsDTO.hpp"
+#include "dto/TransitionStatisticsDTO.hpp"
 #include "cppmicroservices/servicecomponent/ServiceComponentExport.h"
 
 namespace cppmicroservices { namespace service { namespace component { namespace runtime {
@@ -158,6 +160,41 @@ class US_ServiceComponent_EXPORT ServiceComponentRuntime {
    * @see #IsComponentEnabled(ComponentDescriptionDTO)
    */
   virtual std::shared_future<void> DisableComponent(const dto::ComponentDescriptionDTO& description) = 0;
+
+  /**
+   * Returns a snapshot of the enable and disable transitions which are
+   * currently queued or running.
+   *
+   * <p>
+   * Service Component Runtime performs the actions resulting from a change
+   * of the enabled state of a component description on a bounded set of
+   * threads. The number of threads is configured by the
+   * {@link ComponentConstants#TRANSITION_THREADS} framework property.
+   *
+   * <p>
+   * The default implementation returns a DTO with all counts set to zero.
+   *
+   * @return The current transition statistics.
+   */
+  virtual dto::TransitionStatisticsDTO GetTransitionStatistics() const;
+
+  /**
+   * Returns the number of component instances activated and deactivated by
+   * Service Component Runtime since it was started.
+   *
+   * <p>
+   * An instance of a delayed component is created when its service is
+   * requested. If the component description specifies an
+   * {@code idle-timeout} in milliseconds, the instance is deactivated once
+   * no bundle used the service for the duration of the timeout, and
+   * activated again on the next request.
+   *
+   * <p>
+   * The default implementation returns a DTO with all counts set to zero.
+   *
+   * @return The current activation statistics.
+   */
+  virtual dto::ActivationStatisticsDTO GetActivationStatistics() const;
 };
 
 }}}} // namespaces
@@ -0,0 +1,73 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef ActivationStatisticsDTO_hpp
+#define ActivationStatisticsDTO_hpp
+
+#include <cstddef>
+
+#include <cppmicroservices/servicecomponent/ServiceComponentExport.h>
+
+namespace cppmicroservices {
+namespace service {
+namespace component {
+namespace runtime {
+namespace dto {
+
+/**
+ * A representation of the activations and deactivations of component
+ * instances performed by Service Component Runtime since it was started.
+ *
+ * @see ServiceComponentRuntime#GetActivationStatistics()
+ */
+struct US_ServiceComponent_EXPORT ActivationStatisticsDTO
+{
+  /**
+   * The number of component instances which were activated.
+   */
+  std::size_t activations;
+
+  /**
+   * The number of component instances which were deactivated, including
+   * the idle deactivations.
+   */
+  std::size_t deactivations;
+
+  /**
+   * The number of instances of delayed components which were deactivated
+   * because they were not used for the duration of their idle timeout.
+   */
+  std::size_t idleDeactivations;
+
+  /**
+   * The number of unused instances of delayed components whose idle
+   * timeout has not expired yet.
+   */
+  std::size_t pendingIdleDeactivations;
+};
+}
+}
+}
+}
+}
+
+#endif /* ActivationStatisticsDTO_hpp */
@@ -0,0 +1,68 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef TransitionStatisticsDTO_hpp
+#define TransitionStatisticsDTO_hpp
+
+#include <cstddef>
+
+#include <cppmicroservices/servicecomponent/ServiceComponentExport.h>
+
+namespace cppmicroservices {
+namespace service {
+namespace component {
+namespace runtime {
+namespace dto {
+
+/**
+ * A representation of the enable and disable transitions of component
+ * descriptions which are performed asynchronously by Service Component
+ * Runtime.
+ *
+ * @see ServiceComponentRuntime#GetTransitionStatistics()
+ */
+struct US_ServiceComponent_EXPORT TransitionStatisticsDTO
+{
+  /**
+   * The number of transitions waiting for a thread.
+   */
+  std::size_t queued;
+
+  /**
+   * The number of transitions currently running.
+   */
+  std::size_t running;
+
+  /**
+   * The number of threads used to run transitions.
+   *
+   * @see ComponentConstants#TRANSITION_THREADS
+   */
+  std::size_t threads;
+};
+}
+}
+}
+}
+}
+
+#endif /* TransitionStatisticsDTO_hpp */
@@ -80,6 +80,12 @@ const std::string REFERENCE_TARGET_SUFFIX = ".target";
  * Scope to indicate the reference must be a servcie registered with PROTOTYPE scope.
  */
 const std::string REFERENCE_SCOPE_PROTOTYPE_REQUIRED = "prototype_required";
+
+/**
+ * Framework launching property specifying the maximum number of threads
+ * used to enable and disable components.
+ */
+const std::string TRANSITION_THREADS = "org.cppmicroservices.scr.transition.threads";
 }
 }
 }
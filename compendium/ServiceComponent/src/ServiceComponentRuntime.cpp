@@ -31,6 +31,16 @@ ServiceComponentRuntime::~ServiceComponentRuntime() noexcept
 {
 }
 
+dto::TransitionStatisticsDTO ServiceComponentRuntime::GetTransitionStatistics() const
+{
+  return dto::TransitionStatisticsDTO{};
+}
+
+dto::ActivationStatisticsDTO ServiceComponentRuntime::GetActivationStatistics() const
+{
+  return dto::ActivationStatisticsDTO{};
+}
+
 }
 }
 }
@@ -145,6 +145,30 @@ private:
                  << "}" << std::endl
                  << std::endl;
     }
+    SubstituteFactoryTable();
+  }
+
+  // Generate the table of factory functions of all components, which lets
+  // the runtime resolve them with a single symbol lookup per bundle.
+  void SubstituteFactoryTable()
+  {
+    mStrStream << "static const scd::ComponentInstanceFactory componentInstanceFactories[] = {" << std::endl;
+    for (const auto& componentInfo : mComponentInfos)
+    {
+      const auto compName = datamodel::GetComponentNameStr(componentInfo);
+      mStrStream << util::Substitute(R"(  { "{0}", &NewInstance_{1}, &DeleteInstance_{1} },)"
+                                     , componentInfo.name.empty() ? componentInfo.implClassName : componentInfo.name
+                                     , compName) << std::endl;
+    }
+    mStrStream << "  { nullptr, nullptr, nullptr }" << std::endl
+               << "};" << std::endl
+               << std::endl
+               << "#if defined(US_BUNDLE_NAME)" << std::endl
+               << R"(extern "C" US_ABI_EXPORT const scd::ComponentInstanceFactory* US_SCR_COMPONENT_FACTORIES_FUNC(US_BUNDLE_NAME)())" << std::endl
+               << "{" << std::endl
+               << "  return componentInstanceFactories;" << std::endl
+               << "}" << std::endl
+               << "#endif" << std::endl;
   }
 
   const std::vector<std::string> mHeaderIncludes;
@@ -50,6 +50,8 @@ struct ComponentInfo
   std::string name;
   std::string implClassName;
   bool injectReferences;
+  bool enabled;
+  bool immediate;
   ServiceInfo service;
   std::vector<ReferenceInfo> references;
 };
@@ -0,0 +1,142 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+#ifndef COMPONENTMETADATAWRITER_HPP
+#define COMPONENTMETADATAWRITER_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <sstream>
+
+#include "ComponentInfo.hpp"
+
+using codegen::datamodel::ComponentInfo;
+
+namespace codegen {
+
+/*
+ * Serializes the validated metadata of all components of a bundle. The
+ * result is embedded as the resource "scr_metadata.bin" in the bundle, so
+ * that the declarative services runtime does not have to parse and validate
+ * the manifest, nor load the bundle binary, when the bundle is started.
+ *
+ * The format is:
+ *   char[4]  magic "USCM"
+ *   uint32   format version
+ *   uint32   number of components, followed by each component:
+ *     string   name, or the implementation class name if the component has no name
+ *     string   implementation class name
+ *     uint8    enabled
+ *     uint8    immediate
+ *     string   service scope
+ *     uint32   number of service interfaces, followed by each interface as string
+ *     uint32   number of references, followed by each reference:
+ *       string   name, interface, target, cardinality, policy, policy option, scope
+ *
+ * Integers are little-endian and strings are written as a uint32 length
+ * followed by the characters. The component properties are not part of the
+ * metadata and are read from the manifest.
+ *
+ * The format must be kept in sync with the reader in
+ * compendium/DeclarativeServices/src/metadata/MetadataTableReader.cpp
+ */
+class ComponentMetadataWriter
+{
+public:
+  static constexpr uint32_t Version = 1;
+
+  explicit ComponentMetadataWriter(const std::vector<ComponentInfo>& componentInfos)
+    : mStrStream(std::ios_base::out | std::ios_base::binary)
+  {
+    const char magic[4] = { 'U', 'S', 'C', 'M' };
+    mStrStream.write(magic, sizeof(magic));
+    WriteUInt32(Version);
+    WriteUInt32(static_cast<uint32_t>(componentInfos.size()));
+    for (const auto& componentInfo : componentInfos)
+    {
+      WriteComponent(componentInfo);
+    }
+  }
+
+  std::string GetString() const
+  {
+    return mStrStream.str();
+  }
+
+private:
+  void WriteComponent(const ComponentInfo& componentInfo)
+  {
+    WriteString(componentInfo.name.empty() ? componentInfo.implClassName : componentInfo.name);
+    WriteString(componentInfo.implClassName);
+    WriteBool(componentInfo.enabled);
+    WriteBool(componentInfo.immediate);
+    WriteString(ToLower(componentInfo.service.scope));
+    WriteUInt32(static_cast<uint32_t>(componentInfo.service.interfaces.size()));
+    for (const auto& interface : componentInfo.service.interfaces)
+    {
+      WriteString(interface);
+    }
+    WriteUInt32(static_cast<uint32_t>(componentInfo.references.size()));
+    for (const auto& ref : componentInfo.references)
+    {
+      WriteString(ref.name);
+      WriteString(ref.interface);
+      WriteString(ref.target);
+      WriteString(ToLower(ref.cardinality));
+      WriteString(ToLower(ref.policy));
+      WriteString(ToLower(ref.policy_option));
+      WriteString("bundle");
+    }
+  }
+
+  void WriteUInt32(uint32_t value)
+  {
+    const char bytes[4] = { static_cast<char>(value & 0xff)
+                            , static_cast<char>((value >> 8) & 0xff)
+                            , static_cast<char>((value >> 16) & 0xff)
+                            , static_cast<char>((value >> 24) & 0xff) };
+    mStrStream.write(bytes, sizeof(bytes));
+  }
+
+  void WriteBool(bool value)
+  {
+    mStrStream.put(value ? 1 : 0);
+  }
+
+  void WriteString(const std::string& value)
+  {
+    WriteUInt32(static_cast<uint32_t>(value.size()));
+    mStrStream.write(value.data(), value.size());
+  }
+
+  static std::string ToLower(std::string value)
+  {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+      return static_cast<char>(std::tolower(c)); });
+    return value;
+  }
+
+  std::ostringstream mStrStream;
+};
+
+} // namespace codegen
+#endif
@@ -38,7 +38,9 @@
 #include "ComponentInfo.hpp"
 #include "Util.hpp"
 #include "ComponentCallbackGenerator.hpp"
+#include "ComponentMetadataWriter.hpp"
 using codegen::ComponentCallbackGenerator;
+using codegen::ComponentMetadataWriter;
 using codegen::util::JsonValueValidator;
 using codegen::util::ParseManifestOrThrow;
 using codegen::util::WriteToFile;
@@ -107,6 +109,13 @@ int main(int argc, const char **argv, char**)
     const auto componentInfos = manifestParser->ParseAndGetComponentInfos(scr);
     ComponentCallbackGenerator compGen(includeHeaderPaths, componentInfos);
     WriteToFile(outFilePath, compGen.GetString());
+    // --metadata-file is optional. The serialized component metadata is
+    // embedded as a bundle resource.
+    if (std::find(std::begin(args), std::end(args), "--metadata-file") != args.end())
+    {
+      ComponentMetadataWriter metadataWriter(componentInfos);
+      WriteToFile(*findOrThrow("--metadata-file"), metadataWriter.GetString());
+    }
   }
   catch (const std::exception& ex)
   {
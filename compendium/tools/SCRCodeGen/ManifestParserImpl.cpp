@@ -55,8 +55,28 @@ std::vector<ComponentInfo> ManifestParserImplV1::ParseAndGetComponentInfos(
       componentInfo.injectReferences = injectReferences.asBool();
     }
 
+    // enabled
+    componentInfo.enabled = true;
+    if (jsonComponent.isMember("enabled")) {
+      componentInfo.enabled = JsonValueValidator(
+        jsonComponent, "enabled", Json::ValueType::booleanValue)().asBool();
+    }
+
+    // immediate. A component which does not provide a service must be immediate.
+    const bool serviceSpecified = jsonComponent.isMember("service");
+    componentInfo.immediate = !serviceSpecified;
+    if (jsonComponent.isMember("immediate")) {
+      componentInfo.immediate = JsonValueValidator(
+        jsonComponent, "immediate", Json::ValueType::booleanValue)().asBool();
+      if (!serviceSpecified && !componentInfo.immediate) {
+        throw std::runtime_error(
+          "Invalid value specified for the name 'immediate'.");
+      }
+    }
+
     // service
-    if (jsonComponent.isMember("service")) {
+    componentInfo.service.scope = "singleton";
+    if (serviceSpecified) {
       const auto jsonServiceInfo = JsonValueValidator(
         jsonComponent, "service", Json::ValueType::objectValue)();
       JsonValueValidator::ValidChoices<3> scopeChoices = {
@@ -53,6 +53,17 @@ extern "C" US_ABI_EXPORT void DeleteInstance_DSSpellCheck_SpellCheckImpl(Compone
   delete componentInstance;
 }
 
+static const scd::ComponentInstanceFactory componentInstanceFactories[] = {
+  { "DSSpellCheck::SpellCheckImpl", &NewInstance_DSSpellCheck_SpellCheckImpl, &DeleteInstance_DSSpellCheck_SpellCheckImpl },
+  { nullptr, nullptr, nullptr }
+};
+
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentInstanceFactory* US_SCR_COMPONENT_FACTORIES_FUNC(US_BUNDLE_NAME)()
+{
+  return componentInstanceFactories;
+}
+#endif
 )manifestsrc";
 #else
 const std::string REF_SRC = R"manifestsrc(
@@ -82,6 +93,17 @@ extern "C" US_ABI_EXPORT void DeleteInstance_DSSpellCheck_SpellCheckImpl(Compone
   delete componentInstance;
 }
 
+static const scd::ComponentInstanceFactory componentInstanceFactories[] = {
+  { "DSSpellCheck::SpellCheckImpl", &NewInstance_DSSpellCheck_SpellCheckImpl, &DeleteInstance_DSSpellCheck_SpellCheckImpl },
+  { nullptr, nullptr, nullptr }
+};
+
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentInstanceFactory* US_SCR_COMPONENT_FACTORIES_FUNC(US_BUNDLE_NAME)()
+{
+  return componentInstanceFactories;
+}
+#endif
 )manifestsrc";
 #endif
 
@@ -113,6 +135,17 @@ extern "C" US_ABI_EXPORT void DeleteInstance_DSSpellCheck_SpellCheckImpl(Compone
   delete componentInstance;
 }
 
+static const scd::ComponentInstanceFactory componentInstanceFactories[] = {
+  { "DSSpellCheck::SpellCheckImpl", &NewInstance_DSSpellCheck_SpellCheckImpl, &DeleteInstance_DSSpellCheck_SpellCheckImpl },
+  { nullptr, nullptr, nullptr }
+};
+
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentInstanceFactory* US_SCR_COMPONENT_FACTORIES_FUNC(US_BUNDLE_NAME)()
+{
+  return componentInstanceFactories;
+}
+#endif
 )manifestsrc";
 
 const std::string REF_MULT_COMPS = R"manifestsrc(
@@ -156,6 +189,18 @@ extern "C" US_ABI_EXPORT void DeleteInstance_Foo_Impl2(ComponentInstance* compon
   delete componentInstance;
 }
 
+static const scd::ComponentInstanceFactory componentInstanceFactories[] = {
+  { "Foo::Impl1", &NewInstance_Foo_Impl1, &DeleteInstance_Foo_Impl1 },
+  { "Foo::Impl2", &NewInstance_Foo_Impl2, &DeleteInstance_Foo_Impl2 },
+  { nullptr, nullptr, nullptr }
+};
+
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentInstanceFactory* US_SCR_COMPONENT_FACTORIES_FUNC(US_BUNDLE_NAME)()
+{
+  return componentInstanceFactories;
+}
+#endif
 )manifestsrc";
 
 const std::string REF_MULT_COMPS_SAME_IMPL = R"manifestsrc(
@@ -199,6 +244,18 @@ extern "C" US_ABI_EXPORT void DeleteInstance_FooImpl2(ComponentInstance* compone
   delete componentInstance;
 }
 
+static const scd::ComponentInstanceFactory componentInstanceFactories[] = {
+  { "FooImpl1", &NewInstance_FooImpl1, &DeleteInstance_FooImpl1 },
+  { "FooImpl2", &NewInstance_FooImpl2, &DeleteInstance_FooImpl2 },
+  { nullptr, nullptr, nullptr }
+};
+
+#if defined(US_BUNDLE_NAME)
+extern "C" US_ABI_EXPORT const scd::ComponentInstanceFactory* US_SCR_COMPONENT_FACTORIES_FUNC(US_BUNDLE_NAME)()
+{
+  return componentInstanceFactories;
+}
+#endif
 )manifestsrc";
 
 } // namespace codegen
@@ -23,6 +23,7 @@
 #include <regex>
 
 #include "../ComponentCallbackGenerator.hpp"
+#include "../ComponentMetadataWriter.hpp"
 #include "../ManifestParser.hpp"
 #include "../ManifestParserFactory.hpp"
 #include "ReferenceAutogenFiles.hpp"
@@ -465,6 +466,42 @@ const std::string manifest_empty_interfaces_string = R"manifest(
   }
   )manifest";
 
+const std::string manifest_illegal_immediate = R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                      "implementation-class": "Foo::Impl1",
+                      "immediate": "true"
+                       }
+                       ]
+            }
+  }
+  )manifest";
+
+const std::string manifest_delayed_without_service = R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                      "implementation-class": "Foo::Impl1",
+                      "immediate": false
+                       }
+                       ]
+            }
+  }
+  )manifest";
+
+const std::string manifest_illegal_enabled = R"manifest(
+  {
+    "scr" : { "version" : 1,
+              "components": [{
+                      "implementation-class": "Foo::Impl1",
+                      "enabled": 1
+                       }
+                       ]
+            }
+  }
+  )manifest";
+
 auto GetManifestSCRData(const std::string& content)
 {
   std::istringstream istrstream(content);
@@ -537,6 +574,44 @@ INSTANTIATE_TEST_SUITE_P(
                               { "A.hpp", "B.hpp", "C.hpp" },
                               REF_MULT_COMPS_SAME_IMPL)));
 
+TEST(CodeGenTest, TestMetadataWriter)
+{
+  auto scr = GetManifestSCRData(manifest_dyn);
+  auto manifestParser = ManifestParserFactory::Create(1);
+  ComponentMetadataWriter writer(manifestParser->ParseAndGetComponentInfos(scr));
+
+  std::string expected("USCM");
+  auto appendUInt32 = [&expected](uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+    {
+      expected += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+  };
+  auto appendString = [&](const std::string& value) {
+    appendUInt32(static_cast<uint32_t>(value.size()));
+    expected += value;
+  };
+  appendUInt32(ComponentMetadataWriter::Version);
+  appendUInt32(1);
+  appendString("DSSpellCheck::SpellCheckImpl");
+  appendString("DSSpellCheck::SpellCheckImpl");
+  expected += '\1'; // enabled
+  expected += '\0'; // immediate
+  appendString("singleton");
+  appendUInt32(1);
+  appendString("SpellCheck::ISpellCheckService");
+  appendUInt32(1);
+  appendString("dictionary");
+  appendString("DictionaryService::IDictionaryService");
+  appendString("");
+  appendString("1..1");
+  appendString("dynamic");
+  appendString("reluctant");
+  appendString("bundle");
+
+  EXPECT_EQ(writer.GetString(), expected);
+}
+
 // For the manifest specified in the member manifest, we expect the exception message
 // output by the code-generator to be exactly errorOutput.
 // Instead, if we expect the errorOutput to be contained in the generated error message,
@@ -679,6 +754,15 @@ INSTANTIATE_TEST_SUITE_P(
     CodegenInvalidManifestState(
       manifest_illegal_inject_refs,
       "Invalid value for the name 'inject-references'. Expected boolean"),
+    CodegenInvalidManifestState(
+      manifest_illegal_immediate,
+      "Invalid value for the name 'immediate'. Expected boolean"),
+    CodegenInvalidManifestState(
+      manifest_delayed_without_service,
+      "Invalid value specified for the name 'immediate'."),
+    CodegenInvalidManifestState(
+      manifest_illegal_enabled,
+      "Invalid value for the name 'enabled'. Expected boolean"),
     CodegenInvalidManifestState(
       manifest_illegal_inject_refs2,
       "Invalid value for the name 'inject-references'. Expected boolean"),
@@ -217,7 +217,6 @@ public:
      *
      * @see Constants#BUNDLE_ACTIVATIONPOLICY
      * @see #Start(uint32_t)
-     * @note This option is reserved for future use and not supported yet.
      */
     START_ACTIVATION_POLICY = 0x00000002
   };
@@ -378,6 +377,9 @@ public:
 
   /**
     * Retrieves the resolved symbol from bundle shared library and returns a function pointer associated with it
+    *
+    * If this bundle is waiting for its {@link Constants#ACTIVATION_LAZY lazy
+    * activation}, it is activated first.
     * 
     * @param handle  Handle to the Bundle's shared library
     * @param symname Name of the symbol
@@ -37,6 +37,7 @@ class AnyMap;
 class Bundle;
 class BundleContext;
 class BundleContextPrivate;
+struct BundleStartResult;
 class ServiceFactory;
 namespace detail {
 class LogSink;
@@ -1076,6 +1077,75 @@ public:
    */
   std::vector<Bundle> InstallBundles(const std::string& location);
 
+  /**
+   * Installs all bundles from the bundle libraries at the specified locations.
+   *
+   * This is equivalent to calling InstallBundles(const std::string&) for each
+   * location in turn, except that the bundle libraries are read and their
+   * manifests parsed concurrently. The maximum number of threads used for this
+   * is controlled by the Constants::FRAMEWORK_BUNDLE_INSTALL_THREADS framework
+   * property.
+   *
+   * The bundles are registered, and their <code>BundleEvent::BUNDLE_INSTALLED</code>
+   * events fired, on the calling thread in the order of the given locations.
+   * Bundle identifiers are therefore assigned as if the locations had been
+   * installed one after another. Locations which are concurrently being
+   * installed by another thread are waited for only after the other
+   * locations have been registered, their bundles are still returned at
+   * their position in the location order.
+   *
+   * If the installation of a location fails, the bundles of all preceding
+   * locations stay installed, the remaining locations are not installed and
+   * a std::runtime_error is thrown.
+   *
+   * @param locations The locations of the bundle libraries to install.
+   * @return The Bundle objects of the installed bundle libraries, in location order.
+   * @throws std::runtime_error If the BundleContext is no longer valid, or if the installation failed.
+   * @throws std::logic_error If the framework instance is no longer active
+   * @throws std::invalid_argument If a location is not a valid UTF8 string
+   *
+   * @see InstallBundles(const std::string&)
+   */
+  std::vector<Bundle> InstallBundles(const std::vector<std::string>& locations);
+
+  /**
+   * Starts the specified bundles concurrently.
+   *
+   * Each bundle is started by calling Bundle::Start(uint32_t) with the given
+   * options, so the semantics of starting an individual bundle are unchanged.
+   * Up to Constants::FRAMEWORK_BUNDLE_START_THREADS bundles are started at
+   * the same time.
+   *
+   * The order in which the bundles are started is controlled by their
+   * manifest headers:
+   * - Bundles are started in ascending order of their
+   *   Constants::BUNDLE_STARTLEVEL header. All bundles of a start level
+   *   have been started before any bundle of the next start level is started.
+   * - A bundle is not started before all bundles listed in its
+   *   Constants::BUNDLE_STARTDEPENDENCIES header have been started.
+   *   Dependencies on bundles which are not contained in <code>bundles</code>
+   *   are ignored.
+   *
+   * A failure to start a bundle does not stop the remaining bundles from being
+   * started, except for the bundles which (transitively) depend on it. These
+   * are not started and their result reports the failed dependency.
+   * Cyclic start dependencies and start dependencies on a bundle with a higher
+   * start level are reported as failures of the involved bundles.
+   *
+   * @param bundles The bundles to start.
+   * @param options The options passed to Bundle::Start(uint32_t).
+   * @return A BundleStartResult for each bundle, in the order of
+   *         <code>bundles</code>, containing the time spent starting the
+   *         bundle and the exception thrown, if any.
+   * @throws std::runtime_error If this BundleContext is no longer valid.
+   * @throws std::invalid_argument If one of the bundles is invalid.
+   *
+   * @see Bundle::Start(uint32_t)
+   */
+  std::vector<BundleStartResult> StartBundles(
+    const std::vector<Bundle>& bundles,
+    uint32_t options = 0);
+
 private:
   friend US_Framework_EXPORT BundleContext
   MakeBundleContext(BundleContextPrivate*);
@@ -0,0 +1,59 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLELOADSTATISTICS_H
+#define CPPMICROSERVICES_BUNDLELOADSTATISTICS_H
+
+#include <chrono>
+
+namespace cppmicroservices {
+
+/**
+ * \ingroup MicroServices
+ *
+ * Timings for reading and loading the shared library of a bundle.
+ *
+ * @see Constants::FRAMEWORK_BUNDLE_PREFETCH
+ * @see Framework::GetBundleLoadStatistics()
+ */
+struct BundleLoadStatistics
+{
+  /**
+   * Whether the bundle library was read ahead in the background after
+   * the bundle was installed.
+   */
+  bool prefetched = false;
+
+  /**
+   * The time spent reading the bundle library ahead.
+   */
+  std::chrono::nanoseconds prefetchTime{ 0 };
+
+  /**
+   * The time spent loading the bundle library when the bundle was
+   * started. Zero if the library has not been loaded by the framework.
+   */
+  std::chrono::nanoseconds loadTime{ 0 };
+};
+}
+
+#endif // CPPMICROSERVICES_BUNDLELOADSTATISTICS_H
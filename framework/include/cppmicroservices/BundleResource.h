@@ -297,6 +297,29 @@ public:
    */
   uint32_t GetCrc32() const;
 
+  /**
+   * Returns a read-only view of the resource data for this %BundleResource object.
+   *
+   * If the resource is stored without compression and the bundle's resources
+   * are memory mapped, the returned pointer refers directly into the mapped
+   * bundle archive and no data is copied. Otherwise, the resource data is
+   * uncompressed into a newly allocated buffer. In both cases the returned
+   * pointer keeps the data alive and the data size is GetSize().
+   *
+   * If the framework caches resource data (see
+   * Constants#FRAMEWORK_RESOURCE_CACHE_SIZE), compressed resources read
+   * again are served from the cache and share the same buffer.
+   *
+   * @note The CRC-32 checksum of resource data which is not copied is not
+   * verified.
+   *
+   * @return A pointer to the resource data or \c nullptr if this resource is
+   *         invalid or its data could not be read.
+   *
+   * @see BundleResourceStream
+   */
+  std::shared_ptr<const void> GetDataView() const;
+
 private:
   BundleResource(const std::string& file,
                  const std::shared_ptr<const BundleArchive>& archive);
@@ -318,6 +341,11 @@ private:
 
   std::unique_ptr<void, void (*)(void*)> GetData() const;
 
+  /// Returns a function reading the resource data incrementally, see
+  /// BundleResourceStream. Returns an empty function if the resource
+  /// is invalid or its data cannot be read.
+  std::function<std::size_t(char*, std::size_t)> GetDataReader() const;
+
   BundleResourcePrivate* d;
 };
 
@@ -0,0 +1,69 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLERESOURCECACHESTATISTICS_H
+#define CPPMICROSERVICES_BUNDLERESOURCECACHESTATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cppmicroservices {
+
+/**
+ * \ingroup MicroServices
+ *
+ * Usage counters of the framework's cache for decompressed bundle
+ * resource data.
+ *
+ * @see Constants::FRAMEWORK_RESOURCE_CACHE_SIZE
+ * @see Framework::GetResourceCacheStatistics()
+ */
+struct BundleResourceCacheStatistics
+{
+  /**
+   * The number of resource reads served from the cache.
+   */
+  uint64_t hits = 0;
+
+  /**
+   * The number of resource reads which had to decompress the data.
+   */
+  uint64_t misses = 0;
+
+  /**
+   * The number of cache entries removed to stay within the capacity.
+   */
+  uint64_t evictions = 0;
+
+  /**
+   * The number of bytes of resource data currently held by the cache.
+   */
+  std::size_t size = 0;
+
+  /**
+   * The maximum number of bytes of resource data held by the cache.
+   */
+  std::size_t capacity = 0;
+};
+}
+
+#endif // CPPMICROSERVICES_BUNDLERESOURCECACHESTATISTICS_H
@@ -67,6 +67,27 @@ public:
    */
   BundleResourceStream(const BundleResource& resource,
                        std::ios_base::openmode mode = std::ios_base::in);
+
+  /**
+   * Construct a %BundleResourceStream object which decompresses the
+   * resource data incrementally.
+   *
+   * Other streams decompress the whole resource before the first character
+   * can be read. This stream inflates the data on demand and holds at most
+   * \c windowSize bytes of uncompressed data in memory, which bounds the
+   * memory use and the time to the first byte for large resources.
+   * Seeking forward decompresses and discards the skipped data. Seeking
+   * backwards only succeeds within the current window.
+   *
+   * @param resource The BundleResource object for which an input stream
+   * should be constructed.
+   * @param mode The open mode of the stream, see above.
+   * @param windowSize The maximum number of uncompressed bytes held in
+   * memory.
+   */
+  BundleResourceStream(const BundleResource& resource,
+                       std::ios_base::openmode mode,
+                       std::size_t windowSize);
 };
 }
 
@@ -0,0 +1,63 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CPPMICROSERVICES_BUNDLESTARTRESULT_H
+#define CPPMICROSERVICES_BUNDLESTARTRESULT_H
+
+#include "cppmicroservices/Bundle.h"
+
+#include <chrono>
+#include <exception>
+
+namespace cppmicroservices {
+
+/**
+ * \ingroup MicroServices
+ *
+ * The outcome of starting a single bundle with
+ * BundleContext::StartBundles(const std::vector<Bundle>&, uint32_t).
+ */
+struct BundleStartResult
+{
+  /**
+   * The bundle this result belongs to.
+   */
+  Bundle bundle;
+
+  /**
+   * The time spent in Bundle::Start for this bundle. This is zero
+   * if the bundle was not started because one of its start
+   * dependencies failed.
+   */
+  std::chrono::nanoseconds duration;
+
+  /**
+   * The exception thrown while starting the bundle, or a null
+   * <code>std::exception_ptr</code> if the bundle was started
+   * successfully.
+   */
+  std::exception_ptr exception;
+};
+}
+
+#endif // CPPMICROSERVICES_BUNDLESTARTRESULT_H
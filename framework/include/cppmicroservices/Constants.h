@@ -159,6 +159,42 @@ US_Framework_EXPORT extern const std::string
 US_Framework_EXPORT extern const std::string
   BUNDLE_SYMBOLICNAME; // = "bundle.symbolic_name";
 
+/**
+ * Manifest header identifying the bundle's start level.
+ *
+ * The header value must be an <code>int</code>. It is only used by
+ * BundleContext::StartBundles, which starts all bundles of a lower start
+ * level before any bundle of a higher start level. If the header is not
+ * present, the start level is 1.
+ *
+ * The header value may be retrieved from the \c AnyMap object
+ * returned by the \c Bundle::GetHeaders() method.
+ *
+ * @see #BUNDLE_STARTDEPENDENCIES
+ */
+US_Framework_EXPORT extern const std::string
+  BUNDLE_STARTLEVEL; // = "bundle.start_level";
+
+/**
+ * Manifest header identifying the bundles which must be started before
+ * this bundle.
+ *
+ * The header value is an array of bundle symbolic names (or a single
+ * symbolic name). It is only used by BundleContext::StartBundles, and
+ * only for bundles which are started by the same call.
+ *
+ * <pre>
+ *       bundle: { start_dependencies: [ "org.example.core" ] }
+ * </pre>
+ *
+ * The header value may be retrieved from the \c AnyMap object
+ * returned by the \c Bundle::GetHeaders() method.
+ *
+ * @see #BUNDLE_STARTLEVEL
+ */
+US_Framework_EXPORT extern const std::string
+  BUNDLE_STARTDEPENDENCIES; // = "bundle.start_dependencies";
+
 /**
  * Manifest header identifying the base name of the bundle's localization
  * entries.
@@ -197,7 +233,11 @@ US_Framework_EXPORT extern const std::string
  * A bundle with the lazy activation policy that is started with the
  * {@link Bundle#START_ACTIVATION_POLICY START_ACTIVATION_POLICY} option
  * will wait in the {@link Bundle#STATE_STARTING STATE_STARTING} state until its
- * library is loaded. The bundle will then be activated.
+ * activation is triggered. Its shared library is not loaded before that.
+ * The activation is triggered by the first request for one of the services
+ * declared in the #BUNDLE_LAZYSERVICES manifest header, by a call to
+ * Bundle::GetSymbol, or by starting the bundle without the
+ * {@link Bundle#START_ACTIVATION_POLICY START_ACTIVATION_POLICY} option.
  *
  * The activation policy value is specified as in the
  * bundle.activation_policy manifest header like:
@@ -212,6 +252,36 @@ US_Framework_EXPORT extern const std::string
  */
 US_Framework_EXPORT extern const std::string ACTIVATION_LAZY; // = "lazy";
 
+/**
+ * Manifest header declaring the services a bundle with the
+ * {@link #ACTIVATION_LAZY lazy activation policy} registers when activated.
+ *
+ * While the bundle waits for its activation, the framework registers a
+ * placeholder service for each entry, using the declared interfaces and
+ * properties. Getting a placeholder service activates the bundle and returns
+ * the highest ranked service registered by the bundle's activator for the
+ * first declared interface. The placeholders are unregistered as soon as the
+ * bundle is active.
+ *
+ * The header value is an array of objects, each containing an
+ * \c interfaces member (a string or an array of strings) and an optional
+ * \c properties object:
+ *
+ * <pre>
+ *       bundle: {
+ *         activation_policy: "lazy",
+ *         lazy_services: [
+ *           { interfaces: [ "mynamespace::MyService" ],
+ *             properties: { "service.ranking": 1 } }
+ *         ]
+ *       }
+ * </pre>
+ *
+ * @see #ACTIVATION_LAZY
+ */
+US_Framework_EXPORT extern const std::string
+  BUNDLE_LAZYSERVICES; // = "bundle.lazy_services";
+
 /**
  * Framework environment property identifying the Framework version.
  *
@@ -263,6 +333,100 @@ US_Framework_EXPORT extern const std::string
 US_Framework_EXPORT extern const std::string
   FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT; // = "onFirstInit";
 
+/**
+ * Framework launching property specifying the bundle storage used by the
+ * framework. Valid values are #FRAMEWORK_STORAGE_TYPE_MEMORY and
+ * #FRAMEWORK_STORAGE_TYPE_FILE. If this property is not set, the
+ * framework uses the memory bundle storage.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_STORAGE_TYPE; // = "org.cppmicroservices.framework.storage.type";
+
+/**
+ * Specifies that the framework keeps all bundle meta-data in main memory.
+ * Each launch of the framework reads all bundle libraries and their
+ * manifests again.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_STORAGE_TYPE_MEMORY; // = "memory";
+
+/**
+ * Specifies that the framework caches bundle meta-data, like the resource
+ * index and the parsed manifest of each bundle, in a file inside the
+ * persistent storage area (see #FRAMEWORK_STORAGE). Installing an unchanged
+ * bundle library during a later launch of the framework uses the cached
+ * meta-data instead of reading the library. A bundle library is considered
+ * unchanged if its location, modification time and size are unchanged. The
+ * modification time is compared with the resolution of the file system,
+ * which is below one second on common file systems.
+ *
+ * The cache file is written to the "bundles" directory of the persistent
+ * storage area. If #FRAMEWORK_STORAGE is set to an empty string, or the
+ * storage area cannot be created, the meta-data is kept in memory, like
+ * with #FRAMEWORK_STORAGE_TYPE_MEMORY, and a diagnostic message is logged.
+ *
+ * The cache is discarded if #FRAMEWORK_STORAGE_CLEAN is set to
+ * #FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_STORAGE_TYPE_FILE; // = "file";
+
+/**
+ * Framework launching property specifying the maximum number of threads
+ * used by BundleContext::InstallBundles(const std::vector<std::string>&)
+ * to read bundle libraries concurrently. The value must be a positive
+ * <code>int</code>. If this property is not set, the number of hardware
+ * threads is used.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_BUNDLE_INSTALL_THREADS; // = "org.cppmicroservices.framework.install.threads";
+
+/**
+ * Framework launching property specifying the maximum number of threads
+ * used by BundleContext::StartBundles to start bundles concurrently. The
+ * value must be a positive <code>int</code>. If this property is not set,
+ * the number of hardware threads is used.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_BUNDLE_START_THREADS; // = "org.cppmicroservices.framework.start.threads";
+
+/**
+ * Framework launching property specifying the number of idle threads the
+ * framework keeps for calling bundle activators and bundle listeners. More
+ * threads are created when more bundle operations run at the same time,
+ * for example when an activator starts another bundle; these exit as soon
+ * as more than this number of threads are idle. The value must be a positive
+ * <code>int</code>. If this property is not set, the number of hardware
+ * threads is used.
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_BUNDLE_THREADS; // = "org.cppmicroservices.framework.bundle.threads";
+
+/**
+ * Framework launching property specifying whether the shared libraries of
+ * installed bundles with an activator are read ahead on a background
+ * thread, so that starting the bundles later does not wait for the file
+ * system. The value must be a <code>bool</code>. Prefetching is disabled
+ * if this property is not set.
+ *
+ * @see Framework::GetBundleLoadStatistics()
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_BUNDLE_PREFETCH; // = "org.cppmicroservices.framework.bundle.prefetch";
+
+/**
+ * Framework launching property specifying the maximum number of bytes of
+ * decompressed bundle resource data the framework keeps in memory. Resources
+ * which are read again are then served from memory instead of being
+ * decompressed again. When the limit is reached, the least recently used
+ * data is evicted. The value must be a non-negative <code>int</code>. If this
+ * property is not set or is 0, resource data is not cached.
+ *
+ * @see Framework::GetResourceCacheStatistics()
+ */
+US_Framework_EXPORT extern const std::string
+  FRAMEWORK_RESOURCE_CACHE_SIZE; // = "org.cppmicroservices.framework.resource_cache.size";
+
 /**
  * The framework's threading support property key name.
  * This property's default value is "single".
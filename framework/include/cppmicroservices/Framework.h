@@ -24,6 +24,8 @@
 #define CPPMICROSERVICES_FRAMEWORK_H
 
 #include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleLoadStatistics.h"
+#include "cppmicroservices/BundleResourceCacheStatistics.h"
 #include "cppmicroservices/FrameworkConfig.h"
 
 #include <chrono>
@@ -133,6 +135,29 @@ public:
      */
   FrameworkEvent WaitForStop(const std::chrono::milliseconds& timeout);
 
+  /**
+     * Returns the usage counters of this Framework's cache for decompressed
+     * bundle resource data. The counters are reset when the Framework is
+     * initialized.
+     *
+     * @return The resource cache statistics. All values are zero if this
+     *         Framework has not been initialized.
+     *
+     * @see Constants#FRAMEWORK_RESOURCE_CACHE_SIZE
+     */
+  BundleResourceCacheStatistics GetResourceCacheStatistics() const;
+
+  /**
+     * Returns how long reading ahead and loading the shared libraries of
+     * the installed bundles took.
+     *
+     * @return The load statistics of all installed bundles, by bundle id.
+     *         Empty if this Framework has not been initialized.
+     *
+     * @see Constants#FRAMEWORK_BUNDLE_PREFETCH
+     */
+  std::map<long, BundleLoadStatistics> GetBundleLoadStatistics() const;
+
   /**
      * Start this Framework.
      *
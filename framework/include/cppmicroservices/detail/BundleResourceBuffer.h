@@ -25,6 +25,7 @@
 
 #include "cppmicroservices/FrameworkExport.h"
 
+#include <functional>
 #include <memory>
 #include <streambuf>
 
@@ -45,9 +46,31 @@ public:
                                 std::size_t size,
                                 std::ios_base::openmode mode);
 
+  explicit BundleResourceBuffer(std::shared_ptr<const void> data,
+                                std::size_t size,
+                                std::ios_base::openmode mode);
+
+  /// Reads the next chunk of resource data into buffer and returns the
+  /// number of bytes read, or 0 after the last byte has been read.
+  using ReadFunction =
+    std::function<std::size_t(char* buffer, std::size_t size)>;
+
+  /// Creates a buffer which pulls the resource data through read into a
+  /// window of windowSize bytes. Only the window is kept in memory, so
+  /// seeking backwards is limited to the current window.
+  explicit BundleResourceBuffer(ReadFunction read,
+                                std::size_t size,
+                                std::size_t windowSize,
+                                std::ios_base::openmode mode);
+
   ~BundleResourceBuffer() override;
 
 private:
+  /// Replaces the window with the next chunk of resource data.
+  void FillWindow();
+
+  pos_type SeekWindow(off_type off, std::ios_base::seekdir way);
+
   int_type underflow() override;
 
   int_type uflow() override;
@@ -322,6 +322,12 @@ void* Bundle::GetSymbol(void * handle, const std::string& symname) const
       throw std::invalid_argument("Error : Either bundle or inputs supplied are invalid!");
   }
 
+  // Accessing the library of a bundle waiting for its lazy activation
+  // triggers the activation.
+  if (STATE_STARTING == GetState()) {
+    d->ActivateLazily();
+  }
+
   if(STATE_ACTIVE != GetState()) {
     throw std::runtime_error("Bundle is not started and active!");
   }
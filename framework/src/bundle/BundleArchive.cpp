@@ -44,12 +44,15 @@ BundleArchive::BundleArchive(BundleStorage* storage,
                              std::unique_ptr<Data>&& data,
                              std::shared_ptr<BundleResourceContainer>  resourceContainer,
                              std::string  resourcePrefix,
-                             std::string  location)
+                             std::string  location,
+                             std::shared_ptr<const AnyMap> manifestHeaders)
   : storage(storage)
   , data(std::move(data))
   , resourceContainer(std::move(resourceContainer))
   , resourcePrefix(std::move(resourcePrefix))
   , location(std::move(location))
+  , manifestHeaders(std::move(manifestHeaders))
+  , resourceCache(storage ? storage->GetResourceCache() : nullptr)
 {}
 
 bool BundleArchive::IsValid() const
@@ -59,6 +62,9 @@ bool BundleArchive::IsValid() const
 
 void BundleArchive::Purge()
 {
+  if (resourceCache) {
+    resourceCache->Remove(GetBundleId());
+  }
   storage->RemoveArchive(this);
 }
 
@@ -141,4 +147,14 @@ BundleArchive::GetResourceContainer() const
 {
   return resourceContainer;
 }
+
+std::shared_ptr<BundleResourceCache> BundleArchive::GetResourceCache() const
+{
+  return resourceCache;
+}
+
+std::shared_ptr<const AnyMap> BundleArchive::GetManifestHeaders() const
+{
+  return manifestHeaders;
+}
 }
@@ -23,6 +23,8 @@
 #ifndef CPPMICROSERVICES_BUNDLEARCHIVE_H
 #define CPPMICROSERVICES_BUNDLEARCHIVE_H
 
+#include "cppmicroservices/AnyMap.h"
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +33,7 @@
 namespace cppmicroservices {
 
 class BundleResource;
+class BundleResourceCache;
 class BundleResourceContainer;
 struct BundleStorage;
 
@@ -57,7 +60,8 @@ struct BundleArchive : std::enable_shared_from_this<BundleArchive>
                 std::unique_ptr<Data>&& data,
                 std::shared_ptr<BundleResourceContainer>  resourceContainer,
                 std::string  resourcePrefix,
-                std::string  location);
+                std::string  location,
+                std::shared_ptr<const AnyMap> manifestHeaders = nullptr);
 
   /**
    * Autostart setting stopped.
@@ -156,12 +160,28 @@ struct BundleArchive : std::enable_shared_from_this<BundleArchive>
 
   std::shared_ptr<BundleResourceContainer> GetResourceContainer() const;
 
+  /**
+   * Returns the cache for decompressed resource data of this archive,
+   * or nullptr if resource data is not cached.
+   */
+  std::shared_ptr<BundleResourceCache> GetResourceCache() const;
+
+  /**
+   * Get the manifest headers provided by the bundle storage.
+   *
+   * @return The already parsed manifest headers, or nullptr if the
+   *         manifest must be read from the bundle resources.
+   */
+  std::shared_ptr<const AnyMap> GetManifestHeaders() const;
+
 private:
   BundleStorage* const storage;
   const std::unique_ptr<Data> data;
   const std::shared_ptr<BundleResourceContainer> resourceContainer;
   const std::string resourcePrefix;
   const std::string location;
+  const std::shared_ptr<const AnyMap> manifestHeaders;
+  const std::shared_ptr<BundleResourceCache> resourceCache;
 };
 }
 
@@ -23,6 +23,7 @@
 #include "cppmicroservices/BundleContext.h"
 
 #include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleStartResult.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/FileSystem.h"
@@ -30,12 +31,14 @@
 #include "BundleContextPrivate.h"
 #include "BundlePrivate.h"
 #include "BundleRegistry.h"
+#include "BundleStarter.h"
 #include "CoreBundleContext.h"
 #include "ServiceReferenceBasePrivate.h"
 #include "ServiceRegistry.h"
 
 #include <cstdio>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
 namespace cppmicroservices {
@@ -482,4 +485,29 @@ std::vector<Bundle> BundleContext::InstallBundles(const std::string& location)
 
   return b->coreCtx->bundleRegistry.Install(location, b);
 }
+
+std::vector<Bundle> BundleContext::InstallBundles(
+  const std::vector<std::string>& locations)
+{
+  d->CheckValid();
+  auto b = (d->Lock(), d->bundle);
+
+  return b->coreCtx->bundleRegistry.Install(locations, b);
+}
+
+std::vector<BundleStartResult> BundleContext::StartBundles(
+  const std::vector<Bundle>& bundles,
+  uint32_t options)
+{
+  d->CheckValid();
+  auto b = (d->Lock(), d->bundle);
+
+  for (auto const& bundle : bundles) {
+    if (!bundle) {
+      throw std::invalid_argument("Cannot start an invalid bundle");
+    }
+  }
+
+  return StartBundlesConcurrently(bundles, options, b->coreCtx->startThreads);
+}
 }
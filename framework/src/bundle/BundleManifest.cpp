@@ -22,10 +22,18 @@
 
 #include "BundleManifest.h"
 
+#include "cppmicroservices/detail/BundleResourceBuffer.h"
+
+#include "BinaryIO.h"
+#include "BundleResourceContainer.h"
+
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/istreamwrapper.h>
 
+#include <cstdint>
+#include <cstring>
+#include <istream>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -135,6 +143,119 @@ void ParseJsonArray(const rapidjson::Value& jsonArray, AnyVector& anyVector, boo
   }
 }
 
+const char BINARY_MANIFEST_MAGIC[4] = { 'U', 'S', 'M', 'F' };
+const uint32_t BINARY_MANIFEST_VERSION = 1;
+
+enum BinaryValueTag : uint8_t
+{
+  TAG_OBJECT = 0,
+  TAG_ORDERED_OBJECT = 1,
+  TAG_ARRAY = 2,
+  TAG_STRING = 3,
+  TAG_BOOL = 4,
+  TAG_INT = 5,
+  TAG_DOUBLE = 6
+};
+
+void WriteBinaryValue(std::string& out, const Any& value);
+
+template<class Map>
+void WriteBinaryObject(std::string& out, uint8_t tag, const Map& map)
+{
+  out.push_back(static_cast<char>(tag));
+  WriteUInt32(out, static_cast<uint32_t>(map.size()));
+  for (auto const& kv : map) {
+    WriteString(out, kv.first);
+    WriteBinaryValue(out, kv.second);
+  }
+}
+
+void WriteBinaryValue(std::string& out, const Any& value)
+{
+  const auto& type = value.Type();
+  if (type == typeid(AnyMap)) {
+    WriteBinaryObject(out, TAG_OBJECT, ref_any_cast<AnyMap>(value));
+  } else if (type == typeid(AnyOrderedMap)) {
+    WriteBinaryObject(
+      out, TAG_ORDERED_OBJECT, ref_any_cast<AnyOrderedMap>(value));
+  } else if (type == typeid(AnyVector)) {
+    const auto& vec = ref_any_cast<AnyVector>(value);
+    out.push_back(static_cast<char>(TAG_ARRAY));
+    WriteUInt32(out, static_cast<uint32_t>(vec.size()));
+    for (auto const& v : vec) {
+      WriteBinaryValue(out, v);
+    }
+  } else if (type == typeid(std::string)) {
+    out.push_back(static_cast<char>(TAG_STRING));
+    WriteString(out, ref_any_cast<std::string>(value));
+  } else if (type == typeid(bool)) {
+    out.push_back(static_cast<char>(TAG_BOOL));
+    out.push_back(ref_any_cast<bool>(value) ? 1 : 0);
+  } else if (type == typeid(int)) {
+    out.push_back(static_cast<char>(TAG_INT));
+    WriteUInt32(out, static_cast<uint32_t>(ref_any_cast<int>(value)));
+  } else if (type == typeid(double)) {
+    uint64_t bits = 0;
+    double d = ref_any_cast<double>(value);
+    std::memcpy(&bits, &d, sizeof(bits));
+    out.push_back(static_cast<char>(TAG_DOUBLE));
+    WriteUInt64(out, bits);
+  } else {
+    throw std::runtime_error(std::string("Unsupported manifest value type ") +
+                             value.Type().name());
+  }
+}
+
+Any ReadBinaryValue(BinaryReader& reader);
+
+template<class Map>
+void ReadBinaryObject(BinaryReader& reader, Map& map)
+{
+  for (auto count = reader.ReadUInt32(); count > 0; --count) {
+    auto key = reader.ReadString();
+    map.emplace(std::move(key), ReadBinaryValue(reader));
+  }
+}
+
+Any ReadBinaryValue(BinaryReader& reader)
+{
+  switch (reader.ReadUInt8()) {
+    case TAG_OBJECT: {
+      Any any = AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+      ReadBinaryObject(reader, ref_any_cast<AnyMap>(any));
+      return any;
+    }
+    case TAG_ORDERED_OBJECT: {
+      Any any = AnyOrderedMap();
+      ReadBinaryObject(reader, ref_any_cast<AnyOrderedMap>(any));
+      return any;
+    }
+    case TAG_ARRAY: {
+      Any any = AnyVector();
+      auto& vec = ref_any_cast<AnyVector>(any);
+      auto count = reader.ReadUInt32();
+      for (uint32_t i = 0; i < count; ++i) {
+        vec.emplace_back(ReadBinaryValue(reader));
+      }
+      return any;
+    }
+    case TAG_STRING:
+      return Any(reader.ReadString());
+    case TAG_BOOL:
+      return Any(reader.ReadUInt8() != 0);
+    case TAG_INT:
+      return Any(static_cast<int>(reader.ReadUInt32()));
+    case TAG_DOUBLE: {
+      uint64_t bits = reader.ReadUInt64();
+      double d = 0;
+      std::memcpy(&d, &bits, sizeof(d));
+      return Any(d);
+    }
+    default:
+      throw std::runtime_error("Invalid value tag in binary manifest");
+  }
+}
+
 }
 
 BundleManifest::BundleManifest()
@@ -157,6 +278,44 @@ void BundleManifest::Parse(std::istream& is)
   ParseJsonObject(root, m_Headers);
 }
 
+void BundleManifest::ParseBinary(const void* data, std::size_t size)
+{
+  BinaryReader reader(static_cast<const char*>(data), size);
+  if (std::memcmp(reader.Read(sizeof(BINARY_MANIFEST_MAGIC)),
+                  BINARY_MANIFEST_MAGIC,
+                  sizeof(BINARY_MANIFEST_MAGIC)) != 0) {
+    throw std::runtime_error("Not a binary manifest.");
+  }
+  auto version = reader.ReadUInt32();
+  if (version != BINARY_MANIFEST_VERSION) {
+    throw std::runtime_error("Unsupported binary manifest version " +
+                             std::to_string(version));
+  }
+  if (reader.ReadUInt8() != TAG_OBJECT) {
+    throw std::runtime_error("The binary manifest root must be an object.");
+  }
+
+  AnyMap headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  ReadBinaryObject(reader, headers);
+  if (!reader.AtEnd()) {
+    throw std::runtime_error("Trailing data after binary manifest.");
+  }
+  m_Headers = std::move(headers);
+}
+
+std::string BundleManifest::SerializeBinary() const
+{
+  std::string out(BINARY_MANIFEST_MAGIC, sizeof(BINARY_MANIFEST_MAGIC));
+  WriteUInt32(out, BINARY_MANIFEST_VERSION);
+  WriteBinaryObject(out, TAG_OBJECT, m_Headers);
+  return out;
+}
+
+void BundleManifest::SetHeaders(const AnyMap& headers)
+{
+  m_Headers = headers;
+}
+
 const AnyMap& BundleManifest::GetHeaders() const
 {
   return m_Headers;
@@ -211,4 +370,60 @@ std::map<std::string, Any> BundleManifest::GetPropertiesDeprecated() const
   return m_PropertiesDeprecated;
 }
 
+std::shared_ptr<const AnyMap> ParseBinaryBundleManifest(
+  BundleResourceContainer& resCont,
+  const std::string& prefix)
+{
+  BundleResourceContainer::Stat stat;
+  stat.filePath = prefix + "/manifest.bin";
+  if (!resCont.GetStat(stat) || stat.isDir) {
+    return nullptr;
+  }
+
+  auto data = resCont.GetDataView(stat.index);
+  if (!data) {
+    return nullptr;
+  }
+
+  try {
+    BundleManifest manifest;
+    manifest.ParseBinary(data.get(), stat.uncompressedSize);
+    return std::make_shared<const AnyMap>(manifest.GetHeaders());
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+std::shared_ptr<const AnyMap> ParseBundleManifest(
+  BundleResourceContainer& resCont,
+  const std::string& prefix)
+{
+  // A compiled manifest is loaded without parsing JSON. If it is missing
+  // or cannot be read, fall back to the JSON manifest.
+  if (auto headers = ParseBinaryBundleManifest(resCont, prefix)) {
+    return headers;
+  }
+
+  BundleResourceContainer::Stat stat;
+  stat.filePath = prefix + "/manifest.json";
+  if (!resCont.GetStat(stat) || stat.isDir) {
+    return nullptr;
+  }
+
+  auto data = resCont.GetData(stat.index);
+  if (!data) {
+    return nullptr;
+  }
+
+  detail::BundleResourceBuffer buffer(
+    std::move(data), stat.uncompressedSize, std::ios_base::in);
+  std::istream manifestStream(&buffer);
+  try {
+    BundleManifest manifest;
+    manifest.Parse(manifestStream);
+    return std::make_shared<const AnyMap>(manifest.GetHeaders());
+  } catch (...) {
+    return nullptr;
+  }
+}
 }
@@ -25,10 +25,14 @@
 
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/AnyMap.h"
+
+#include <memory>
 #include <mutex>
 
 namespace cppmicroservices {
 
+class BundleResourceContainer;
+
 class BundleManifest
 {
 
@@ -37,6 +41,37 @@ public:
 
   void Parse(std::istream& is);
 
+  /**
+   * Reads headers written by SerializeBinary().
+   *
+   * The compact binary manifest format stores a tagged value tree
+   * (integers are little endian):
+   *
+   *   magic "USMF", uint32 format version, root object
+   *
+   * where each value is a uint8 tag followed by its payload: an object
+   * (case-insensitive keys) or ordered object holds a uint32 count of
+   * (string key, value) pairs, an array a uint32 count of values, a
+   * string a uint32 length and its bytes, a bool one byte, an int an
+   * int32 and a double its IEEE 754 bits.
+   *
+   * @throws std::runtime_error if the data is not a valid binary manifest.
+   */
+  void ParseBinary(const void* data, std::size_t size);
+
+  /**
+   * Returns the headers in the compact binary manifest format.
+   *
+   * @throws std::runtime_error if a header value has a type which cannot
+   *         be represented in the binary format.
+   */
+  std::string SerializeBinary() const;
+
+  /**
+   * Replaces the headers with a previously parsed set of headers.
+   */
+  void SetHeaders(const AnyMap& headers);
+
   const AnyMap& GetHeaders() const;
 
   bool Contains(const std::string& key) const;
@@ -63,6 +98,28 @@ private:
   void CopyDeprecatedProperties() const;
 };
 
+/**
+ * Loads the compiled manifest.bin of the bundle at prefix in resCont.
+ *
+ * @return The manifest headers, or nullptr if the bundle has no compiled
+ *         manifest or it cannot be read, e.g. because it was written by
+ *         a newer resource compiler.
+ */
+std::shared_ptr<const AnyMap> ParseBinaryBundleManifest(
+  BundleResourceContainer& resCont,
+  const std::string& prefix);
+
+/**
+ * Parses the manifest of the bundle at prefix in resCont. A compiled
+ * manifest.bin is preferred over the manifest.json file.
+ *
+ * @return The manifest headers, or nullptr if the bundle has no manifest
+ *         or it cannot be parsed. In the latter case, installing the
+ *         bundle reports the actual problem.
+ */
+std::shared_ptr<const AnyMap> ParseBundleManifest(
+  BundleResourceContainer& resCont,
+  const std::string& prefix);
 }
 
 #endif // CPPMICROSERVICES_BUNDLEMANIFEST_H
@@ -0,0 +1,173 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "BundlePrefetcher.h"
+
+#include "cppmicroservices/Constants.h"
+
+#include "cppmicroservices/util/FileSystem.h"
+#include "cppmicroservices/util/String.h"
+
+#include "BundlePrivate.h"
+
+#include <chrono>
+#include <fstream>
+
+#if defined(US_PLATFORM_LINUX)
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace cppmicroservices {
+
+namespace {
+
+/**
+ * Reads the file at path into the file system cache. Returns false if
+ * the file could not be read.
+ */
+bool ReadAhead(const std::string& path)
+{
+#if defined(US_PLATFORM_LINUX)
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat fileStat;
+  bool const success =
+    fstat(fd, &fileStat) == 0 &&
+    readahead(fd, 0, static_cast<std::size_t>(fileStat.st_size)) == 0;
+  close(fd);
+  return success;
+#else
+#  ifdef US_PLATFORM_WINDOWS
+  std::ifstream file(util::ToWString(path), std::ios_base::binary);
+#  else
+  std::ifstream file(path, std::ios_base::binary);
+#  endif
+  std::vector<char> buffer(1024 * 1024);
+  while (file.read(buffer.data(), buffer.size())) {
+  }
+  return file.eof();
+#endif
+}
+
+bool HasActivator(const BundlePrivate& bundle)
+{
+  auto const& headers = bundle.bundleManifest.GetHeaders();
+  auto activator = headers.find(Constants::BUNDLE_ACTIVATOR);
+  if (activator == headers.end()) {
+    return false;
+  }
+  try {
+    return any_cast<bool>(activator->second);
+  } catch (const BadAnyCastException&) {
+    return false;
+  }
+}
+}
+
+BundlePrefetcher::BundlePrefetcher()
+  : stopped(false)
+{}
+
+BundlePrefetcher::~BundlePrefetcher()
+{
+#ifdef US_ENABLE_THREADING_SUPPORT
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    stopped = true;
+    queue.clear();
+  }
+  this->NotifyAll();
+  if (thread.joinable()) {
+    thread.join();
+  }
+#endif
+}
+
+void BundlePrefetcher::Prefetch(
+  const std::vector<std::shared_ptr<BundlePrivate>>& bundles)
+{
+#ifdef US_ENABLE_THREADING_SUPPORT
+  {
+    auto l = this->Lock();
+    US_UNUSED(l);
+    if (stopped) {
+      return;
+    }
+    for (auto const& bundle : bundles) {
+      queue.emplace_back(bundle);
+    }
+    if (!thread.joinable()) {
+      thread = std::thread(&BundlePrefetcher::Run, this);
+    }
+  }
+  this->NotifyAll();
+#else
+  // Reading ahead on the calling thread would only delay the install.
+  US_UNUSED(bundles);
+#endif
+}
+
+void BundlePrefetcher::Run()
+{
+  std::string executablePath;
+  try {
+    executablePath = util::GetExecutablePath();
+  } catch (...) {
+  }
+
+  while (true) {
+    std::shared_ptr<BundlePrivate> bundle;
+    {
+      auto l = this->Lock();
+      this->Wait(l, [this] { return stopped || !queue.empty(); });
+      if (stopped) {
+        return;
+      }
+      bundle = queue.front().lock();
+      queue.pop_front();
+    }
+
+    // The executable is already loaded.
+    if (bundle && bundle->location != executablePath &&
+        bundle->state != Bundle::STATE_UNINSTALLED && HasActivator(*bundle)) {
+      Prefetch(*bundle);
+    }
+  }
+}
+
+void BundlePrefetcher::Prefetch(BundlePrivate& bundle)
+{
+  using namespace std::chrono;
+
+  auto const start = steady_clock::now();
+  if (ReadAhead(bundle.location)) {
+    bundle.libPrefetchTime =
+      duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    bundle.libPrefetched = true;
+  }
+}
+}
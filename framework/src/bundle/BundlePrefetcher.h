@@ -0,0 +1,80 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLEPREFETCHER_H
+#define CPPMICROSERVICES_BUNDLEPREFETCHER_H
+
+#include "cppmicroservices/detail/Threads.h"
+#include "cppmicroservices/detail/WaitCondition.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+#  include <thread>
+#endif
+
+namespace cppmicroservices {
+
+class BundlePrivate;
+
+/**
+ * Reads the shared libraries of installed bundles ahead on a background
+ * thread, so that loading them when the bundles are started does not
+ * have to wait for the file system.
+ */
+class BundlePrefetcher
+  : private detail::MultiThreaded<detail::MutexLockingStrategy<>,
+                                  detail::WaitCondition>
+{
+public:
+  BundlePrefetcher();
+
+  /**
+   * Stops the background thread. Queued bundles are not prefetched.
+   */
+  ~BundlePrefetcher();
+
+  /**
+   * Queues the libraries of the given bundles for reading them ahead.
+   * Bundles without an activator, or which are uninstalled before their
+   * turn, are skipped.
+   */
+  void Prefetch(const std::vector<std::shared_ptr<BundlePrivate>>& bundles);
+
+private:
+  void Run();
+
+  void Prefetch(BundlePrivate& bundle);
+
+  std::deque<std::weak_ptr<BundlePrivate>> queue;
+  bool stopped;
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+  std::thread thread;
+#endif
+};
+}
+
+#endif // CPPMICROSERVICES_BUNDLEPREFETCHER_H
@@ -27,8 +27,11 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/BundleResource.h"
 #include "cppmicroservices/BundleResourceStream.h"
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/ServiceFactory.h"
+#include "cppmicroservices/ServiceReference.h"
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/SharedLibraryException.h"
 
@@ -52,6 +55,81 @@
 
 namespace cppmicroservices {
 
+namespace {
+
+/*
+  Placeholder for a service declared by a bundle with the lazy activation
+  policy. Getting the service activates the bundle and returns the service
+  registered by its activator.
+*/
+class LazyServiceFactory : public ServiceFactory
+{
+public:
+  LazyServiceFactory(const std::shared_ptr<BundlePrivate>& bundle,
+                     std::string interfaceId)
+    : bundle(bundle)
+    , interfaceId(std::move(interfaceId))
+  {}
+
+  InterfaceMapConstPtr GetService(
+    const Bundle& requester,
+    const ServiceRegistrationBase& registration) override
+  {
+    auto b = bundle.lock();
+    if (!b) {
+      throw std::runtime_error("Bundle of lazy service " + interfaceId +
+                               " no longer exists");
+    }
+    // The placeholder is unregistered when the bundle becomes active.
+    auto placeholder = registration.GetReference();
+    b->ActivateLazily();
+
+    if (!b->bundleContext.Load()) {
+      throw std::runtime_error("Bundle#" + util::ToString(b->id) +
+                               " was stopped during lazy activation");
+    }
+
+    // Find the service registered by the activator, ignoring the
+    // placeholders which might still be registered.
+    ServiceReferenceU service;
+    for (auto const& ref : MakeBundle(b).GetRegisteredServices()) {
+      if (ref == placeholder || !ref.IsConvertibleTo(interfaceId)) {
+        continue;
+      }
+      if (!service || service < ref) {
+        service = ref;
+      }
+    }
+    if (!service) {
+      throw std::runtime_error("Bundle#" + util::ToString(b->id) +
+                               " did not register a service for " +
+                               interfaceId + " when activated");
+    }
+    // Get the service on behalf of the requesting bundle, so its scope and
+    // usage count are tracked for the actual consumer.
+    auto requesterContext = requester.GetBundleContext();
+    if (!requesterContext) {
+      throw std::runtime_error("Bundle#" +
+                               util::ToString(requester.GetBundleId()) +
+                               " has no valid bundle context");
+    }
+    return requesterContext.GetService(service);
+  }
+
+  void UngetService(const Bundle&,
+                    const ServiceRegistrationBase&,
+                    const InterfaceMapConstPtr&) override
+  {
+    // The interface map was obtained from the context of the requesting
+    // bundle, releasing it ungets the service for that bundle.
+  }
+
+private:
+  std::weak_ptr<BundlePrivate> bundle;
+  const std::string interfaceId;
+};
+}
+
 Bundle MakeBundle(const std::shared_ptr<BundlePrivate>& d)
 {
   return Bundle(d);
@@ -436,10 +514,166 @@ void BundlePrivate::Start(uint32_t options)
     SetAutostartSetting(options);
   }
 
+  // 5: Lazy activation, the remaining steps are done by ActivateLazily().
+  if ((options & Bundle::START_ACTIVATION_POLICY) != 0 &&
+      HasLazyActivationPolicy()) {
+    if (state == Bundle::STATE_STARTING) {
+      return;
+    }
+    if (GetUpdatedState(l) == Bundle::STATE_RESOLVED) {
+      auto services = GetLazyServices();
+      state = Bundle::STATE_STARTING;
+      operation = OP_ACTIVATING;
+      std::shared_ptr<BundleContextPrivate> null_expected;
+      std::shared_ptr<BundleContextPrivate> ctx(new BundleContextPrivate(this));
+      bundleContext.CompareExchange(null_expected, ctx);
+      GetBundleThread()->BundleChanged(
+        { BundleEvent::BUNDLE_LAZY_ACTIVATION, this->shared_from_this() }, l);
+      operation = OP_IDLE;
+      coreCtx->resolver.NotifyAll();
+      l.UnLock();
+
+      RegisterLazyServices(services);
+      return;
+    }
+  }
+
   FinalizeActivation(l);
   return;
 }
 
+bool BundlePrivate::HasLazyActivationPolicy() const
+{
+  auto const& headers = bundleManifest.GetHeaders();
+  auto policy = headers.find(Constants::BUNDLE_ACTIVATIONPOLICY);
+  return policy != headers.end() &&
+         policy->second.Type() == typeid(std::string) &&
+         ref_any_cast<std::string>(policy->second) == Constants::ACTIVATION_LAZY;
+}
+
+void BundlePrivate::ActivateLazily()
+{
+  auto l = coreCtx->resolver.Lock();
+
+  // Getting a declared service from within the activator must not wait
+  // for the activation to finish.
+  if (operation == OP_ACTIVATING && IsBundleThread(std::this_thread::get_id())) {
+    return;
+  }
+
+  WaitOnOperation(coreCtx->resolver, l, "Lazy activation", true);
+  if (state == Bundle::STATE_STARTING) {
+    FinalizeActivation(l);
+  }
+}
+
+std::vector<BundlePrivate::LazyService> BundlePrivate::GetLazyServices() const
+{
+  std::vector<LazyService> services;
+  auto const& headers = bundleManifest.GetHeaders();
+  auto declared = headers.find(Constants::BUNDLE_LAZYSERVICES);
+  if (declared == headers.end()) {
+    return services;
+  }
+
+  try {
+    for (auto const& entry : ref_any_cast<std::vector<Any>>(declared->second)) {
+      auto const& service = ref_any_cast<AnyMap>(entry);
+      LazyService lazyService;
+      auto const& interfaces = service.at("interfaces");
+      if (interfaces.Type() == typeid(std::vector<Any>)) {
+        for (auto const& interfaceId :
+             ref_any_cast<std::vector<Any>>(interfaces)) {
+          lazyService.interfaces.push_back(any_cast<std::string>(interfaceId));
+        }
+      } else {
+        lazyService.interfaces.push_back(any_cast<std::string>(interfaces));
+      }
+      if (lazyService.interfaces.empty()) {
+        throw std::runtime_error("no interfaces declared");
+      }
+
+      auto properties = service.find("properties");
+      if (properties != service.end()) {
+        for (auto const& property : ref_any_cast<AnyMap>(properties->second)) {
+          lazyService.properties.insert(property);
+        }
+      }
+      services.push_back(std::move(lazyService));
+    }
+  } catch (const std::exception& ex) {
+    throw std::runtime_error("Bundle#" + util::ToString(id) +
+                             ", invalid " + Constants::BUNDLE_LAZYSERVICES +
+                             " manifest header: " + ex.what());
+  }
+  return services;
+}
+
+void BundlePrivate::RegisterLazyServices(
+  const std::vector<LazyService>& services)
+{
+  for (auto const& service : services) {
+    auto ctx = bundleContext.Load();
+    if (!ctx || state != Bundle::STATE_STARTING) {
+      // Stopped or activated in the meantime.
+      return;
+    }
+
+    auto factory = std::make_shared<LazyServiceFactory>(
+      this->shared_from_this(), service.interfaces.front());
+    auto interfaces = std::make_shared<InterfaceMap>();
+    for (auto const& interfaceId : service.interfaces) {
+      interfaces->insert(std::make_pair(interfaceId, factory));
+    }
+    interfaces->insert(
+      std::make_pair(std::string("org.cppmicroservices.factory"), factory));
+
+    ServiceRegistrationU registration;
+    try {
+      registration =
+        MakeBundleContext(ctx).RegisterService(interfaces, service.properties);
+    } catch (const std::logic_error&) {
+      // The bundle context was invalidated by a concurrent stop.
+      return;
+    }
+
+    // The state is changed before UnregisterLazyServices() is called
+    // on activation, so either the registration is added here and
+    // unregistered there, or it is unregistered here.
+    {
+      auto l = lazyServices.Lock();
+      US_UNUSED(l);
+      if (state == Bundle::STATE_STARTING) {
+        lazyServices.v.push_back(registration);
+        continue;
+      }
+    }
+    try {
+      registration.Unregister();
+    } catch (const std::logic_error&) {
+      // Already unregistered when the bundle was stopped.
+    }
+    return;
+  }
+}
+
+void BundlePrivate::UnregisterLazyServices()
+{
+  std::vector<ServiceRegistrationBase> registrations;
+  {
+    auto l = lazyServices.Lock();
+    US_UNUSED(l);
+    registrations.swap(lazyServices.v);
+  }
+  for (auto& registration : registrations) {
+    try {
+      registration.Unregister();
+    } catch (const std::logic_error&) {
+      // Already unregistered when the bundle was stopped.
+    }
+  }
+}
+
 const AnyMap& BundlePrivate::GetHeaders() const
 {
   return bundleManifest.GetHeaders();
@@ -487,7 +721,11 @@ std::exception_ptr BundlePrivate::Start0()
         libHandle = BundleUtils::GetExecutableHandle();
       } else {
         if (!lib.IsLoaded()) {
+          auto const loadStart = std::chrono::steady_clock::now();
           lib.Load(coreCtx->libraryLoadOptions);
+          libLoadTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - loadStart)
+                          .count();
         }
         libHandle = lib.GetHandle();
       }
@@ -575,6 +813,9 @@ std::exception_ptr BundlePrivate::Start0()
   if (res == nullptr) {
     // 10:
     state = Bundle::STATE_ACTIVE;
+    // The services registered by the activator replace the
+    // placeholders registered for lazy activation.
+    UnregisterLazyServices();
     try {
       coreCtx->listeners.BundleChanged(BundleEvent(
         BundleEvent::BUNDLE_STARTED, MakeBundle(this->shared_from_this())));
@@ -668,6 +909,9 @@ BundlePrivate::BundlePrivate(CoreBundleContext* coreCtx)
   , bundleManifest()
   , lib()
   , SetBundleContext(nullptr)
+  , libPrefetched(false)
+  , libPrefetchTime(0)
+  , libLoadTime(0)
 {}
 
 BundlePrivate::BundlePrivate(CoreBundleContext* coreCtx,
@@ -692,18 +936,32 @@ BundlePrivate::BundlePrivate(CoreBundleContext* coreCtx,
   , bundleManifest()
   , lib(location)
   , SetBundleContext(nullptr)
+  , libPrefetched(false)
+  , libPrefetchTime(0)
+  , libLoadTime(0)
 {
-  // Check if the bundle provides a manifest.json file and if yes, parse it.
   if (barchive->IsValid()) {
-    auto manifestRes = barchive->GetResource("/manifest.json");
-    if (manifestRes) {
-      BundleResourceStream manifestStream(manifestRes);
-      try {
-        bundleManifest.Parse(manifestStream);
-      } catch (...) {
-        throw std::runtime_error(
-          std::string("Parsing of manifest.json for bundle ") + symbolicName +
-          " at " + location + " failed: " + util::GetLastExceptionStr());
+    // Use the manifest headers provided by the bundle storage, if any.
+    // Otherwise check if the bundle provides a compiled manifest.bin or
+    // a manifest.json file and if yes, parse it.
+    if (auto headers = barchive->GetManifestHeaders()) {
+      bundleManifest.SetHeaders(*headers);
+    } else if (auto binaryHeaders = ParseBinaryBundleManifest(
+                 *barchive->GetResourceContainer(),
+                 barchive->GetResourcePrefix())) {
+      bundleManifest.SetHeaders(*binaryHeaders);
+    } else {
+      auto manifestRes = barchive->GetResource("/manifest.json");
+      if (manifestRes) {
+        BundleResourceStream manifestStream(manifestRes);
+        try {
+          bundleManifest.Parse(manifestStream);
+        } catch (...) {
+          throw std::runtime_error(
+            std::string("Parsing of manifest.json for bundle ") +
+            symbolicName + " at " + location +
+            " failed: " + util::GetLastExceptionStr());
+        }
       }
     }
     // It is unlikely that clients will access bundle resources
@@ -772,6 +1030,9 @@ void BundlePrivate::CheckUninstalled() const
 
 void BundlePrivate::RemoveBundleResources()
 {
+  // Placeholder services are unregistered below with all other services.
+  (lazyServices.Lock(), lazyServices.v.clear());
+
   coreCtx->listeners.RemoveAllListeners(bundleContext.Load());
 
   std::vector<ServiceRegistrationBase> srs;
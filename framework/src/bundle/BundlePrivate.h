@@ -25,6 +25,7 @@
 
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleVersion.h"
+#include "cppmicroservices/ServiceRegistrationBase.h"
 #include "cppmicroservices/SharedLibrary.h"
 #include "cppmicroservices/detail/Threads.h"
 #include "cppmicroservices/detail/WaitCondition.h"
@@ -32,6 +33,8 @@
 #include "BundleArchive.h"
 #include "BundleManifest.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <thread>
@@ -177,6 +180,47 @@ using WaitConditionType = WaitCondition<MutexHost>;
 
   void StartFailed();
 
+  /**
+   * Check if the manifest declares the lazy activation policy.
+   */
+  bool HasLazyActivationPolicy() const;
+
+  /**
+   * Activate a bundle which waits for its lazy activation. Does nothing
+   * if the bundle is not waiting for its lazy activation or is called
+   * from the bundle's own activator.
+   */
+  void ActivateLazily();
+
+  /**
+   * A service declared in the manifest of a bundle
+   * with the lazy activation policy.
+   */
+  struct LazyService
+  {
+    std::vector<std::string> interfaces;
+    ServiceProperties properties;
+  };
+
+  /**
+   * Read the services declared in the manifest.
+   *
+   * @throws std::runtime_error If the manifest header is invalid.
+   */
+  std::vector<LazyService> GetLazyServices() const;
+
+  /**
+   * Register placeholders for the given services for
+   * a bundle waiting for its lazy activation.
+   */
+  void RegisterLazyServices(const std::vector<LazyService>& services);
+
+  /**
+   * Unregister the placeholder services registered by
+   * RegisterLazyServices().
+   */
+  void UnregisterLazyServices();
+
   std::shared_ptr<BundleThread> GetBundleThread();
 
   bool IsBundleThread(const std::thread::id& id) const;
@@ -296,6 +340,22 @@ using WaitConditionType = WaitCondition<MutexHost>;
 
   using SetBundleContextHook = std::function<void (BundleContextPrivate*)>;
   SetBundleContextHook SetBundleContext;
+
+  /**
+   * Timings for reading ahead and loading lib in nanoseconds,
+   * see BundlePrefetcher and Framework::GetBundleLoadStatistics().
+   */
+  std::atomic<bool> libPrefetched;
+  std::atomic<int64_t> libPrefetchTime;
+  std::atomic<int64_t> libLoadTime;
+
+  /**
+   * Placeholder services registered while waiting for lazy activation.
+   */
+  struct : detail::MultiThreaded<>
+  {
+    std::vector<ServiceRegistrationBase> v;
+  } lazyServices;
 };
 
 Bundle MakeBundle(const std::shared_ptr<BundlePrivate>& d);
@@ -32,13 +32,17 @@
 #include "cppmicroservices/util/String.h"
 
 #include "BundleContextPrivate.h"
+#include "BundlePrefetcher.h"
 #include "BundlePrivate.h"
 #include "BundleResourceContainer.h"
 #include "BundleStorage.h"
+#include "Concurrency.h"
 #include "CoreBundleContext.h"
 #include "FrameworkPrivate.h"
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
 #include <map>
 
 namespace cppmicroservices {
@@ -90,6 +94,22 @@ void BundleRegistry::DecrementInitialBundleMapRef(
   l.UnLock();
 }
 
+void BundleRegistry::FinishInitialBundleInstall(
+  cppmicroservices::detail::MutexLockingStrategy<>::UniqueLock& l,
+  const std::string& location)
+{
+  l.Lock();
+  auto& waitCondition = initialBundleInstallMap[location].second;
+  l.UnLock();
+  {
+    // Notify all waiting threads that it is safe to install the bundle
+    std::lock_guard<std::mutex> lock(*(waitCondition.m));
+    waitCondition.waitFlag = false;
+    waitCondition.cv->notify_all();
+  }
+  DecrementInitialBundleMapRef(l, location);
+}
+
 /*
   This function populates the res and alreadyInstalled vectors with the
   appropriate entries so that they can be used by the Install0 call. This was
@@ -192,13 +212,7 @@ std::vector<Bundle> BundleRegistry::Install(const std::string& location,
       {
         // create instance of clean-up object to ensure RAII
         InitialBundleMapCleanup cleanup([this, &l, &location](){
-          {
-            // Notify all waiting threads that it is safe to install the bundle
-            std::lock_guard<std::mutex> lock(*(initialBundleInstallMap[location].second.m));
-            initialBundleInstallMap[location].second.waitFlag = false;
-            initialBundleInstallMap[location].second.cv->notify_all();
-          }
-          DecrementInitialBundleMapRef(l, location);
+          FinishInitialBundleInstall(l, location);
         });
           
         // Perform the install
@@ -208,27 +222,31 @@ std::vector<Bundle> BundleRegistry::Install(const std::string& location,
       return installedBundles;
     } else {
       initialBundleInstallMap[location].first++;
-      
+      // The reference count keeps the entry alive. Do not hold the registry
+      // lock while waiting, the installing thread needs it to release its
+      // claims, which could deadlock with a batch install holding several
+      // claims.
+      auto& waitCondition = initialBundleInstallMap[location].second;
+      l.UnLock();
+
       {
         // Wait for the install thread to notify this thread that it is safe
         // to install the current bundle
-        std::unique_lock<std::mutex> lock(
-          *(initialBundleInstallMap[location].second.m));
+        std::unique_lock<std::mutex> lock(*(waitCondition.m));
 
         // This while loop exists to prevent a known race condition. If the installing thread notifies before
         // another thread trying to install the same bundle reaches this wait, it will wait indefinitely. To
         // fix this, a wait_for is used intead (which utilizes a timeout to avoid this race) and the wait statement
         // as a whole acts as the while statement's predicate; once the timeout is reached, wait_for exits and the
         // statement is re-evaluated since it would have returned false.
-        while (!initialBundleInstallMap[location].second.cv->wait_for(lock, 0.1ms, [&location, this] {
-          return !initialBundleInstallMap[location].second.waitFlag;
+        while (!waitCondition.cv->wait_for(lock, 0.1ms, [&waitCondition] {
+          return !waitCondition.waitFlag;
           }));
       }
       
       // Re-acquire the range because while this thread was waiting, the installing
       // thread made a modification to bundles.v
       bundlesAtLocationRange = (bundles.Lock(), bundles.v.equal_range(location));
-      l.UnLock();
 
       std::vector<Bundle> resultingBundles;
       std::vector<std::shared_ptr<BundlePrivate>> alreadyInstalled;
@@ -256,15 +274,102 @@ std::vector<Bundle> BundleRegistry::Install(const std::string& location,
   }
 }
 
+std::vector<Bundle> BundleRegistry::Install(
+  const std::vector<std::string>& locations,
+  BundlePrivate* caller)
+{
+  CheckIllegalState();
+
+  // Claim all locations which are neither installed nor being installed
+  // by another thread, exactly like the first installing thread in
+  // Install(const std::string&, BundlePrivate*) does. All other locations
+  // are installed through the single location code path below.
+  std::vector<std::string> claimed;
+  auto l = this->Lock();
+  for (auto const& location : locations) {
+    if ((bundles.Lock(), bundles.v.count(location)) == 0 &&
+        initialBundleInstallMap.count(location) == 0) {
+      initialBundleInstallMap.insert(
+        std::make_pair(location, std::make_pair(uint32_t(1), WaitCondition{})));
+      claimed.push_back(location);
+    }
+  }
+  l.UnLock();
+
+  // Release the claims of all locations which have not been installed
+  // when leaving this function, including on errors.
+  std::size_t nextClaimed = 0;
+  InitialBundleMapCleanup cleanup([this, &l, &claimed, &nextClaimed]() {
+    for (; nextClaimed < claimed.size(); ++nextClaimed) {
+      FinishInitialBundleInstall(l, claimed[nextClaimed]);
+    }
+  });
+
+  // Read the claimed bundle libraries and parse their manifests
+  // concurrently. This is where almost all of the install time is spent.
+  std::vector<BundleStorage::PreparedBundleLib> prepared(claimed.size());
+  std::vector<std::exception_ptr> errors(claimed.size());
+  RunConcurrently(
+    claimed.size(), coreCtx->installThreads, [&](std::size_t i) {
+      try {
+        prepared[i] = coreCtx->storage->PrepareBundleLib(claimed[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+
+  // Register the claimed bundles in location order, so bundle ids and
+  // events do not depend on the thread scheduling. Locations claimed by
+  // another thread are installed afterwards: waiting for them while this
+  // thread still holds claims could deadlock with a concurrent batch
+  // install which waits for one of these claims.
+  std::vector<std::vector<Bundle>> installed(locations.size());
+  std::vector<std::size_t> deferred;
+  for (std::size_t j = 0; j < locations.size(); ++j) {
+    auto const& location = locations[j];
+    if (nextClaimed < claimed.size() && claimed[nextClaimed] == location) {
+      auto i = nextClaimed++;
+      InitialBundleMapCleanup finish(
+        [this, &l, &location]() { FinishInitialBundleInstall(l, location); });
+      if (errors[i]) {
+        try {
+          std::rethrow_exception(errors[i]);
+        } catch (...) {
+          throw std::runtime_error("Failed to install bundle library at " +
+                                   location + ": " +
+                                   util::GetLastExceptionStr());
+        }
+      }
+      installed[j] = Install0(location, {}, caller, &prepared[i]);
+      // Release the parsed data early, the archives keep what they need.
+      prepared[i] = BundleStorage::PreparedBundleLib();
+    } else {
+      deferred.push_back(j);
+    }
+  }
+  for (auto j : deferred) {
+    installed[j] = Install(locations[j], caller);
+  }
+
+  std::vector<Bundle> res;
+  for (auto const& bundlesAtLocation : installed) {
+    res.insert(res.end(), bundlesAtLocation.begin(), bundlesAtLocation.end());
+  }
+  return res;
+}
+
 std::vector<Bundle> BundleRegistry::Install0(
   const std::string& location,
   const std::vector<std::shared_ptr<BundlePrivate>>& exclude,
-  BundlePrivate* /*caller*/)
+  BundlePrivate* /*caller*/,
+  const BundleStorage::PreparedBundleLib* lib)
 {
   std::vector<Bundle> res;
   std::vector<std::shared_ptr<BundleArchive>> barchives;
   try {
-    if (exclude.empty()) {
+    if (lib) {
+      barchives = coreCtx->storage->InsertBundleLib(*lib);
+    } else if (exclude.empty()) {
       barchives = coreCtx->storage->InsertBundleLib(location);
     } else {
       auto resCont =
@@ -292,6 +397,14 @@ std::vector<Bundle> BundleRegistry::Install0(
       }
     }
 
+    if (coreCtx->prefetcher) {
+      std::vector<std::shared_ptr<BundlePrivate>> installed;
+      for (auto& b : res) {
+        installed.push_back(b.d);
+      }
+      coreCtx->prefetcher->Prefetch(installed);
+    }
+
     for (auto& b : res) {
       coreCtx->listeners.BundleChanged(
         BundleEvent(BundleEvent::BUNDLE_INSTALLED, b));
@@ -407,10 +520,12 @@ void BundleRegistry::Load()
   auto l = this->Lock();
   US_UNUSED(l);
   auto bas = coreCtx->storage->GetAllBundleArchives();
+  std::vector<std::shared_ptr<BundlePrivate>> loaded;
   for (auto const& ba : bas) {
     try {
       std::shared_ptr<BundlePrivate> impl(new BundlePrivate(coreCtx, ba));
       bundles.v.insert(std::make_pair(impl->location, impl));
+      loaded.push_back(impl);
     } catch (...) {
       ba->SetAutostartSetting(-1); // Do not start on launch
       std::cerr << "Failed to load bundle " << util::ToString(ba->GetBundleId())
@@ -420,6 +535,9 @@ void BundleRegistry::Load()
                 << std::endl;
     }
   }
+  if (coreCtx->prefetcher) {
+    coreCtx->prefetcher->Prefetch(loaded);
+  }
 }
 
 void BundleRegistry::CheckIllegalState() const
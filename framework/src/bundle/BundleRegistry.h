@@ -25,6 +25,8 @@
 
 #include "cppmicroservices/detail/Threads.h"
 
+#include "BundleStorage.h"
+
 #include <condition_variable>
 #include <map>
 #include <unordered_map>
@@ -67,10 +69,41 @@ public:
   std::vector<Bundle> Install(const std::string& location,
                               BundlePrivate* caller);
 
+  /**
+   * Install several bundle libraries.
+   *
+   * The bundle libraries are read and their manifests parsed concurrently
+   * on up to CoreBundleContext::installThreads threads. The bundles are
+   * then registered, and their BUNDLE_INSTALLED events fired, on the
+   * calling thread in the order of the given locations. Locations which
+   * are already installed, or are being installed by another thread, are
+   * handled as in Install(const std::string&, BundlePrivate*).
+   *
+   * If the installation of a location fails, the bundles of all preceding
+   * locations stay installed and the remaining locations are not installed.
+   *
+   * @param locations The locations to be installed
+   * @param caller The bundle performing the install
+   * @return A vector of bundles installed, in location order
+   */
+  std::vector<Bundle> Install(const std::vector<std::string>& locations,
+                              BundlePrivate* caller);
+
+  /**
+   * Create and register the bundles of a bundle library.
+   *
+   * @param location The location to be installed
+   * @param exclude Already installed bundles at location
+   * @param caller The bundle performing the install
+   * @param lib The bundle library content if it has already been read
+   *        via BundleStorage::PrepareBundleLib, or nullptr
+   * @return A vector of bundles installed
+   */
   std::vector<Bundle> Install0(
     const std::string& location,
     const std::vector<std::shared_ptr<BundlePrivate>>& exclude,
-    BundlePrivate* caller);
+    BundlePrivate* caller,
+    const BundleStorage::PreparedBundleLib* lib = nullptr);
 
   /**
    * Remove bundle registration.
@@ -150,6 +183,15 @@ private:
     cppmicroservices::detail::MutexLockingStrategy<>::UniqueLock& l,
     const std::string& location);
 
+  /*
+    Called by the thread which installed a bundle location for the first
+    time. Notifies all threads waiting to install the same location and
+    releases the initialBundleInstallMap entry.
+  */
+  void FinishInitialBundleInstall(
+    cppmicroservices::detail::MutexLockingStrategy<>::UniqueLock& l,
+    const std::string& location);
+
   /*
     A struct which contains the necessary objects to utilize condition
     variables. A thread will wait on this WaitCondition if the waitFlag
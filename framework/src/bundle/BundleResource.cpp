@@ -26,9 +26,12 @@
 #include "cppmicroservices/detail/Log.h"
 
 #include "BundleArchive.h"
+#include "BundleResourceCache.h"
 #include "BundleResourceContainer.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -305,6 +308,67 @@ std::unique_ptr<void, void (*)(void*)> BundleResource::GetData() const
   return data;
 }
 
+std::function<std::size_t(char*, std::size_t)> BundleResource::GetDataReader()
+  const
+{
+  if (!IsValid())
+    return {};
+
+  auto reader =
+    d->archive->GetResourceContainer()->GetDataReader(d->stat.index);
+  if (reader) {
+    return reader;
+  }
+
+  // Fall back to reading from the uncompressed data.
+  auto data = GetDataView();
+  if (!data) {
+    return {};
+  }
+  auto const size = static_cast<std::size_t>(GetSize());
+  auto pos = std::make_shared<std::size_t>(0);
+  return [data, size, pos](char* buffer, std::size_t n) {
+    n = (std::min)(n, size - *pos);
+    if (n > 0) {
+      std::memcpy(buffer, static_cast<const char*>(data.get()) + *pos, n);
+      *pos += n;
+    }
+    return n;
+  };
+}
+
+std::shared_ptr<const void> BundleResource::GetDataView() const
+{
+  if (!IsValid())
+    return nullptr;
+
+  // Only cache data which needs to be decompressed.
+  auto cache = d->archive->GetResourceCache();
+  if (cache && (!cache->IsEnabled() || !d->stat.isCompressed)) {
+    cache.reset();
+  }
+  const BundleResourceCache::Key key{ d->archive->GetBundleId(),
+                                      d->stat.index,
+                                      d->stat.crc32 };
+  if (cache) {
+    if (auto data = cache->Get(key)) {
+      return data;
+    }
+  }
+
+  auto data = d->archive->GetResourceContainer()->GetDataView(d->stat.index);
+  if (!data) {
+    auto sink = GetBundleContext().GetLogSink();
+    DIAG_LOG(*sink) << "Error uncompressing resource data for "
+                    << this->GetResourcePath() << " from "
+                    << d->archive->GetBundleLocation();
+  } else if (cache) {
+    cache->Put(key, data, GetSize());
+  }
+
+  return data;
+}
+
 std::ostream& operator<<(std::ostream& os, const BundleResource& resource)
 {
   return os << resource.GetResourcePath();
@@ -22,11 +22,13 @@
 
 #include "cppmicroservices/detail/BundleResourceBuffer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <limits>
 #include <memory>
 #include <cstdlib>
+#include <vector>
 
 #ifdef US_PLATFORM_WINDOWS
 #  define DATA_NEEDS_NEWLINE_CONVERSION 1
@@ -43,7 +45,7 @@ namespace detail {
 class BundleResourceBufferPrivate
 {
 public:
-  BundleResourceBufferPrivate(std::unique_ptr<void, void (*)(void*)> data,
+  BundleResourceBufferPrivate(std::shared_ptr<const void> data,
                               std::size_t size,
                               const char* begin,
                               std::ios_base::openmode mode)
@@ -51,11 +53,12 @@ public:
     , end(begin + size)
     , current(begin)
     , mode(mode)
-    , uncompressedData(reinterpret_cast<unsigned char*>(data.release()),
-                       data.get_deleter())
+    , data(std::move(data))
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
     , pos(0)
 #endif
+    , remaining(0)
+    , windowPos(0)
   {}
 
   const char* const begin;
@@ -64,35 +67,55 @@ public:
 
   const std::ios_base::openmode mode;
 
-  std::unique_ptr<unsigned char, void (*)(void*)> uncompressedData;
+  // Either owns the uncompressed data or keeps the
+  // memory mapped bundle archive alive.
+  const std::shared_ptr<const void> data;
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
   // records the stream position ignoring CR characters
   std::streambuf::pos_type pos;
 #endif
+
+  // Set if the data is read incrementally into the get area window
+  // instead of being accessed through begin/end/current.
+  BundleResourceBuffer::ReadFunction read;
+  std::vector<char> window;
+  // number of resource bytes not read yet
+  std::size_t remaining;
+  // stream position of the first character in the window
+  std::streamoff windowPos;
 };
 
 BundleResourceBuffer::BundleResourceBuffer(
   std::unique_ptr<void, void (*)(void*)> data,
   std::size_t _size,
   std::ios_base::openmode mode)
+  : BundleResourceBuffer(
+      std::shared_ptr<const void>(data.release(), data.get_deleter()),
+      _size,
+      mode)
+{}
+
+BundleResourceBuffer::BundleResourceBuffer(std::shared_ptr<const void> data,
+                                           std::size_t _size,
+                                           std::ios_base::openmode mode)
   : d(nullptr)
 {
   assert(_size <
          static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()));
 
-  auto* begin = reinterpret_cast<char*>(data.get());
+  auto* begin = static_cast<const char*>(data.get());
   std::size_t size = begin ? _size : 0;
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
-  if (begin != nullptr && !(mode & std::ios_base::binary) && begin[0] == '\r') {
+  if (size > 0 && !(mode & std::ios_base::binary) && begin[0] == '\r') {
     ++begin;
     --size;
   }
 #endif
 
 #ifdef REMOVE_LAST_NEWLINE_IN_TEXT_MODE
-  if (begin != nullptr && !(mode & std::ios_base::binary) &&
+  if (size > 0 && !(mode & std::ios_base::binary) &&
       begin[size - 1] == '\n') {
     --size;
   }
@@ -101,10 +124,104 @@ BundleResourceBuffer::BundleResourceBuffer(
   d = std::make_unique<BundleResourceBufferPrivate>(std::move(data), size, begin, mode);
 }
 
+BundleResourceBuffer::BundleResourceBuffer(ReadFunction read,
+                                           std::size_t size,
+                                           std::size_t windowSize,
+                                           std::ios_base::openmode mode)
+  : d(std::make_unique<BundleResourceBufferPrivate>(nullptr, 0, nullptr, mode))
+{
+  d->read = std::move(read);
+  d->remaining = d->read ? size : 0;
+  d->window.resize((std::max)(windowSize, std::size_t(1)));
+  char* window = d->window.data();
+  setg(window, window, window);
+}
+
 BundleResourceBuffer::~BundleResourceBuffer() = default;
 
+void BundleResourceBuffer::FillWindow()
+{
+  d->windowPos += egptr() - eback();
+
+  char* window = d->window.data();
+  std::size_t filled = 0;
+  for (;;) {
+    // Keep reading after the last byte so that the reader can
+    // verify the complete data.
+    std::size_t n = d->read(window + filled, d->window.size() - filled);
+    filled += n;
+    d->remaining -= (std::min)(n, d->remaining);
+    if (n == 0) {
+      // The reader ended before the expected size, e.g. on truncated or
+      // corrupt data. End the stream instead of waiting for more data.
+      d->remaining = 0;
+      break;
+    }
+    if (filled == d->window.size() && d->remaining > 0) {
+      break;
+    }
+  }
+
+  if (!(d->mode & std::ios_base::binary)) {
+#ifdef DATA_NEEDS_NEWLINE_CONVERSION
+    filled = std::remove(window, window + filled, '\r') - window;
+#endif
+#ifdef REMOVE_LAST_NEWLINE_IN_TEXT_MODE
+    if (d->remaining == 0 && filled > 0 && window[filled - 1] == '\n') {
+      --filled;
+    }
+#endif
+  }
+
+  setg(window, window, window + filled);
+}
+
+std::streambuf::pos_type BundleResourceBuffer::SeekWindow(
+  std::streambuf::off_type off,
+  std::ios_base::seekdir way)
+{
+  const pos_type invalidPos(off_type(-1));
+  std::streamoff target = off;
+  if (way == std::ios_base::cur) {
+    target += d->windowPos + (gptr() - eback());
+  } else if (way == std::ios_base::end) {
+    if (d->mode & std::ios_base::binary) {
+      target += d->windowPos + (egptr() - eback()) + d->remaining;
+    } else {
+      // The length of text data is only known after all line
+      // endings have been seen.
+      while (d->remaining > 0) {
+        setg(eback(), egptr(), egptr());
+        FillWindow();
+      }
+      target += d->windowPos + (egptr() - eback());
+    }
+  }
+
+  if (target < d->windowPos) {
+    return invalidPos;
+  }
+  while (target > d->windowPos + (egptr() - eback())) {
+    if (d->remaining == 0) {
+      return invalidPos;
+    }
+    setg(eback(), egptr(), egptr());
+    FillWindow();
+  }
+  setg(eback(), eback() + (target - d->windowPos), egptr());
+  return target;
+}
+
 BundleResourceBuffer::int_type BundleResourceBuffer::underflow()
 {
+  if (d->read) {
+    while (gptr() == egptr() && d->remaining > 0) {
+      FillWindow();
+    }
+    return gptr() == egptr() ? traits_type::eof()
+                             : traits_type::to_int_type(*gptr());
+  }
+
   if (d->current == d->end)
     return traits_type::eof();
 
@@ -126,6 +243,9 @@ BundleResourceBuffer::int_type BundleResourceBuffer::underflow()
 
 BundleResourceBuffer::int_type BundleResourceBuffer::uflow()
 {
+  if (d->read)
+    return std::streambuf::uflow();
+
   if (d->current == d->end)
     return traits_type::eof();
 
@@ -147,6 +267,10 @@ BundleResourceBuffer::int_type BundleResourceBuffer::uflow()
 
 BundleResourceBuffer::int_type BundleResourceBuffer::pbackfail(int_type ch)
 {
+  // characters before the window are gone
+  if (d->read)
+    return traits_type::eof();
+
   int backOffset = -1;
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
   if (!(d->mode & std::ios_base::binary)) {
@@ -168,6 +292,12 @@ BundleResourceBuffer::int_type BundleResourceBuffer::pbackfail(int_type ch)
 
 std::streamsize BundleResourceBuffer::showmanyc()
 {
+  if (d->read) {
+    if (egptr() != gptr() || d->remaining > 0)
+      return egptr() - gptr();
+    return -1;
+  }
+
   assert(d->current <= d->end);
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
@@ -189,6 +319,9 @@ std::streambuf::pos_type BundleResourceBuffer::seekoff(
   std::ios_base::seekdir way,
   std::ios_base::openmode /*which*/)
 {
+  if (d->read)
+    return SeekWindow(off, way);
+
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
   std::streambuf::off_type step = 1;
   if (way == std::ios_base::beg) {
@@ -0,0 +1,112 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "BundleResourceCache.h"
+
+#include <functional>
+#include <iterator>
+
+namespace cppmicroservices {
+
+std::size_t BundleResourceCache::KeyHash::operator()(const Key& key) const
+{
+  std::size_t h = std::hash<long>()(key.bundleId);
+  h ^= std::hash<int>()(key.index) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= std::hash<uint32_t>()(key.crc32) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
+BundleResourceCache::BundleResourceCache(std::size_t capacity)
+  : capacity(capacity)
+{
+  statistics.capacity = capacity;
+}
+
+bool BundleResourceCache::IsEnabled() const
+{
+  return capacity > 0;
+}
+
+std::shared_ptr<const void> BundleResourceCache::Get(const Key& key)
+{
+  auto l = this->Lock();
+  US_UNUSED(l);
+  auto iter = index.find(key);
+  if (iter == index.end()) {
+    ++statistics.misses;
+    return nullptr;
+  }
+  ++statistics.hits;
+  entries.splice(entries.begin(), entries, iter->second);
+  return iter->second->data;
+}
+
+void BundleResourceCache::Put(const Key& key,
+                              std::shared_ptr<const void> data,
+                              std::size_t size)
+{
+  if (!data || size > capacity) {
+    return;
+  }
+
+  auto l = this->Lock();
+  US_UNUSED(l);
+  // Another thread may have decompressed the same data concurrently.
+  auto iter = index.find(key);
+  if (iter != index.end()) {
+    Erase(iter->second);
+  }
+  while (statistics.size + size > capacity) {
+    Erase(std::prev(entries.end()));
+    ++statistics.evictions;
+  }
+  entries.push_front(Entry{ key, std::move(data), size });
+  index.emplace(key, entries.begin());
+  statistics.size += size;
+}
+
+void BundleResourceCache::Remove(long bundleId)
+{
+  auto l = this->Lock();
+  US_UNUSED(l);
+  for (auto iter = entries.begin(); iter != entries.end();) {
+    auto current = iter++;
+    if (current->key.bundleId == bundleId) {
+      Erase(current);
+    }
+  }
+}
+
+BundleResourceCacheStatistics BundleResourceCache::GetStatistics() const
+{
+  auto l = this->Lock();
+  US_UNUSED(l);
+  return statistics;
+}
+
+void BundleResourceCache::Erase(EntryList::iterator iter)
+{
+  statistics.size -= iter->size;
+  index.erase(iter->key);
+  entries.erase(iter);
+}
+}
@@ -0,0 +1,100 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLERESOURCECACHE_H
+#define CPPMICROSERVICES_BUNDLERESOURCECACHE_H
+
+#include "cppmicroservices/BundleResourceCacheStatistics.h"
+#include "cppmicroservices/detail/Threads.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace cppmicroservices {
+
+/**
+ * A least recently used cache of decompressed bundle resource data
+ * with a byte budget. Cached data is shared, evicting an entry does
+ * not invalidate data still used by a reader.
+ */
+class BundleResourceCache : private detail::MultiThreaded<>
+{
+public:
+  struct Key
+  {
+    long bundleId;
+    int index;
+    uint32_t crc32;
+
+    bool operator==(const Key& other) const
+    {
+      return bundleId == other.bundleId && index == other.index &&
+             crc32 == other.crc32;
+    }
+  };
+
+  explicit BundleResourceCache(std::size_t capacity);
+
+  bool IsEnabled() const;
+
+  /// Returns the cached data for key and marks it as most recently used,
+  /// or returns nullptr if the data is not cached.
+  std::shared_ptr<const void> Get(const Key& key);
+
+  /// Caches size bytes of data for key, evicting the least recently used
+  /// entries as needed. Data larger than the capacity is not cached.
+  void Put(const Key& key, std::shared_ptr<const void> data, std::size_t size);
+
+  /// Removes all entries of the given bundle.
+  void Remove(long bundleId);
+
+  BundleResourceCacheStatistics GetStatistics() const;
+
+private:
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    Key key;
+    std::shared_ptr<const void> data;
+    std::size_t size;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void Erase(EntryList::iterator iter);
+
+  const std::size_t capacity;
+
+  // most recently used entries first
+  EntryList entries;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+  BundleResourceCacheStatistics statistics;
+};
+}
+
+#endif // CPPMICROSERVICES_BUNDLERESOURCECACHE_H
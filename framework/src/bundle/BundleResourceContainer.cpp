@@ -29,6 +29,7 @@
 #include "cppmicroservices/GetBundleContext.h"
 #include "cppmicroservices/detail/Log.h"
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <cstring>
@@ -38,8 +39,112 @@
 #include <sstream>
 #include <stdexcept>
 
+#ifdef US_PLATFORM_WINDOWS
+#  include "cppmicroservices/util/String.h"
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 namespace cppmicroservices {
 
+/// A read-only file which supports concurrent reads at arbitrary offsets.
+struct BundleResourceContainer::ArchiveFile
+{
+  explicit ArchiveFile(const std::string& location)
+  {
+#ifdef US_PLATFORM_WINDOWS
+    handle = CreateFileW(util::ToWString(location).c_str(),
+                         GENERIC_READ,
+                         FILE_SHARE_READ,
+                         nullptr,
+                         OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL,
+                         nullptr);
+    LARGE_INTEGER fileSize;
+    size = (handle != INVALID_HANDLE_VALUE && GetFileSizeEx(handle, &fileSize))
+             ? static_cast<mz_uint64>(fileSize.QuadPart)
+             : 0;
+#else
+    fd = open(location.c_str(), O_RDONLY);
+    struct stat fileStat;
+    size = (fd >= 0 && fstat(fd, &fileStat) == 0)
+             ? static_cast<mz_uint64>(fileStat.st_size)
+             : 0;
+#endif
+  }
+
+  ~ArchiveFile()
+  {
+#ifdef US_PLATFORM_WINDOWS
+    if (handle != INVALID_HANDLE_VALUE) {
+      CloseHandle(handle);
+    }
+#else
+    if (fd >= 0) {
+      close(fd);
+    }
+#endif
+  }
+
+  ArchiveFile(const ArchiveFile&) = delete;
+  ArchiveFile& operator=(const ArchiveFile&) = delete;
+
+  bool IsOpen() const
+  {
+#ifdef US_PLATFORM_WINDOWS
+    return handle != INVALID_HANDLE_VALUE;
+#else
+    return fd >= 0;
+#endif
+  }
+
+  mz_uint64 GetSize() const { return size; }
+
+  /// The miniz read callback.
+  static std::size_t Read(void* opaque,
+                          mz_uint64 offset,
+                          void* buffer,
+                          std::size_t n)
+  {
+    auto const* file = static_cast<const ArchiveFile*>(opaque);
+    std::size_t total = 0;
+    while (total < n) {
+      auto* dest = static_cast<char*>(buffer) + total;
+#ifdef US_PLATFORM_WINDOWS
+      OVERLAPPED overlapped = {};
+      overlapped.Offset = static_cast<DWORD>(offset + total);
+      overlapped.OffsetHigh = static_cast<DWORD>((offset + total) >> 32);
+      DWORD bytesRead = 0;
+      auto const chunk =
+        static_cast<DWORD>((std::min)(n - total, std::size_t(MAXDWORD)));
+      if (!ReadFile(file->handle, dest, chunk, &bytesRead, &overlapped) ||
+          bytesRead == 0) {
+        break;
+      }
+#else
+      auto const bytesRead =
+        pread(file->fd, dest, n - total, static_cast<off_t>(offset + total));
+      if (bytesRead <= 0) {
+        break;
+      }
+#endif
+      total += static_cast<std::size_t>(bytesRead);
+    }
+    return total;
+  }
+
+private:
+#ifdef US_PLATFORM_WINDOWS
+  HANDLE handle;
+#else
+  int fd;
+#endif
+  mz_uint64 size;
+};
+
 BundleResourceContainer::BundleResourceContainer(const std::string& location)
   : m_Location(location)
   , m_ZipArchive()
@@ -62,6 +167,25 @@ BundleResourceContainer::BundleResourceContainer(const std::string& location)
   m_IsContainerOpen = true;
 }
 
+BundleResourceContainer::BundleResourceContainer(
+  const std::string& location,
+  const std::vector<NameIndexPair>& entries)
+  : m_Location(location)
+  , m_ZipArchive()
+  , m_ObjFile()
+  , m_ZipFileMutex()
+  , m_IsContainerOpen(false)
+{
+  for (auto const& entry : entries) {
+    InsertSortedEntry(entry.first, entry.second);
+  }
+  InitEntryIndexes();
+  if (m_SortedToplevelDirs.empty()) {
+    throw std::runtime_error("Invalid zip archive layout for bundle at " +
+                             m_Location);
+  }
+}
+
 BundleResourceContainer::~BundleResourceContainer()
 {
   try {
@@ -80,16 +204,18 @@ std::vector<std::string> BundleResourceContainer::GetTopLevelDirs() const
                                    m_SortedToplevelDirs.end() };
 }
 
+std::vector<BundleResourceContainer::NameIndexPair>
+BundleResourceContainer::GetEntries() const
+{
+  return std::vector<NameIndexPair>{ m_SortedEntries.begin(),
+                                     m_SortedEntries.end() };
+}
+
 bool BundleResourceContainer::GetStat(BundleResourceContainer::Stat& stat)
 {
-  OpenContainer();
-  int fileIndex =
-    mz_zip_reader_locate_file(const_cast<mz_zip_archive*>(&m_ZipArchive),
-                              stat.filePath.c_str(),
-                              nullptr,
-                              0);
-  if (fileIndex >= 0) {
-    return GetStat(fileIndex, stat);
+  auto entry = m_EntryIndex.find(stat.filePath);
+  if (entry != m_EntryIndex.end()) {
+    return GetStat(entry->second, stat);
   }
   return false;
 }
@@ -97,7 +223,7 @@ bool BundleResourceContainer::GetStat(BundleResourceContainer::Stat& stat)
 bool BundleResourceContainer::GetStat(int index,
                                       BundleResourceContainer::Stat& stat)
 {
-  OpenContainer();
+  auto l = LockOpenContainer();
   if (index >= 0) {
     mz_zip_archive_file_stat zipStat;
     if (!mz_zip_reader_file_stat(
@@ -110,6 +236,7 @@ bool BundleResourceContainer::GetStat(int index,
                    const_cast<mz_zip_archive*>(&m_ZipArchive), index)
                    ? true
                    : false;
+    stat.isCompressed = zipStat.m_method != 0;
     stat.modifiedTime = zipStat.m_time;
     stat.crc32 = zipStat.m_crc32;
     // This will limit the size info from uint64 to uint32 on 32-bit
@@ -127,37 +254,230 @@ bool BundleResourceContainer::GetStat(int index,
 std::unique_ptr<void, void (*)(void*)> BundleResourceContainer::GetData(
   int index)
 {
-  OpenContainer();
-  std::unique_lock<std::mutex> l(m_ZipFileStreamMutex);
+  auto l = LockOpenContainer();
   void* data = mz_zip_reader_extract_to_heap(
     const_cast<mz_zip_archive*>(&m_ZipArchive), index, nullptr, 0);
   return { data, ::free };
 }
 
+std::shared_ptr<const void> BundleResourceContainer::GetDataView(int index)
+{
+  std::shared_ptr<RawBundleResources> rawData;
+  mz_zip_archive_file_stat zipStat;
+  bool hasStat = false;
+  {
+    auto l = LockOpenContainer();
+    rawData = m_RawData;
+    hasStat = index >= 0 && mz_zip_reader_file_stat(&m_ZipArchive, index, &zipStat);
+  }
+
+  mz_uint64 dataOffset = 0;
+  if (rawData && hasStat && zipStat.m_method == 0 && zipStat.m_comp_size == zipStat.m_uncomp_size &&
+      GetEntryDataOffset(zipStat, rawData.get(), dataOffset) &&
+      dataOffset + zipStat.m_uncomp_size <= rawData->GetSize()) {
+    auto const* zipData = static_cast<const char*>(rawData->GetData());
+    return std::shared_ptr<const void>(rawData, zipData + dataOffset);
+  }
+
+  auto data = GetData(index);
+  return std::shared_ptr<const void>(data.release(), ::free);
+}
+
+namespace {
+
+/// Reads the uncompressed data of a single zip entry sequentially.
+/// Deflate compressed data is inflated chunk by chunk using the
+/// 32KB dictionary of the miniz inflater, stored data is copied.
+class ZipEntryReader
+{
+public:
+  using ReadFunction =
+    std::function<std::size_t(mz_uint64 offset, void* buffer, std::size_t size)>;
+
+  ZipEntryReader(const mz_zip_archive_file_stat& zipStat,
+                 mz_uint64 dataOffset,
+                 std::shared_ptr<RawBundleResources> rawData,
+                 ReadFunction readArchive)
+    : m_Stat(zipStat)
+    , m_DataOffset(dataOffset)
+    , m_RawData(std::move(rawData))
+    , m_ReadArchive(std::move(readArchive))
+    , m_Stream()
+    , m_Consumed(0)
+    , m_Produced(0)
+    , m_Crc32(MZ_CRC32_INIT)
+  {
+    if (m_Stat.m_method == MZ_DEFLATED) {
+      if (mz_inflateInit2(&m_Stream, -MZ_DEFAULT_WINDOW_BITS) != MZ_OK) {
+        throw std::runtime_error("Could not initialize inflater");
+      }
+      if (!m_RawData) {
+        m_Input.resize(InputChunkSize);
+      }
+    }
+  }
+
+  ZipEntryReader(const ZipEntryReader&) = delete;
+  ZipEntryReader& operator=(const ZipEntryReader&) = delete;
+
+  ~ZipEntryReader()
+  {
+    if (m_Stat.m_method == MZ_DEFLATED) {
+      mz_inflateEnd(&m_Stream);
+    }
+  }
+
+  std::size_t Read(char* buffer, std::size_t size)
+  {
+    size = static_cast<std::size_t>(
+      (std::min)(static_cast<mz_uint64>(size), m_Stat.m_uncomp_size - m_Produced));
+    if (size == 0) {
+      if (m_Crc32 != m_Stat.m_crc32) {
+        throw std::runtime_error("CRC-32 mismatch in " +
+                                 std::string(m_Stat.m_filename));
+      }
+      return 0;
+    }
+
+    if (m_Stat.m_method == MZ_DEFLATED) {
+      Inflate(buffer, size);
+    } else {
+      Copy(buffer, size);
+    }
+
+    m_Produced += size;
+    m_Crc32 = static_cast<mz_uint32>(
+      mz_crc32(m_Crc32, reinterpret_cast<const unsigned char*>(buffer), size));
+    return size;
+  }
+
+private:
+  static const std::size_t InputChunkSize = 16 * 1024;
+
+  void Copy(char* buffer, std::size_t size)
+  {
+    auto const offset = m_DataOffset + m_Produced;
+    if (m_RawData) {
+      std::memcpy(buffer,
+                  static_cast<const char*>(m_RawData->GetData()) + offset,
+                  size);
+    } else if (m_ReadArchive(offset, buffer, size) != size) {
+      ThrowTruncated();
+    }
+  }
+
+  void Inflate(char* buffer, std::size_t size)
+  {
+    m_Stream.next_out = reinterpret_cast<unsigned char*>(buffer);
+    m_Stream.avail_out = static_cast<mz_uint>(size);
+    while (m_Stream.avail_out > 0) {
+      if (m_Stream.avail_in == 0 && m_Consumed < m_Stat.m_comp_size) {
+        auto const offset = m_DataOffset + m_Consumed;
+        auto chunk = m_Stat.m_comp_size - m_Consumed;
+        if (m_RawData) {
+          chunk = (std::min)(chunk, static_cast<mz_uint64>(UINT_MAX));
+          m_Stream.next_in =
+            static_cast<const unsigned char*>(m_RawData->GetData()) + offset;
+        } else {
+          chunk = (std::min)(chunk, static_cast<mz_uint64>(m_Input.size()));
+          if (m_ReadArchive(offset, m_Input.data(), chunk) != chunk) {
+            ThrowTruncated();
+          }
+          m_Stream.next_in = m_Input.data();
+        }
+        m_Stream.avail_in = static_cast<mz_uint>(chunk);
+        m_Consumed += chunk;
+      }
+
+      auto status = mz_inflate(&m_Stream, MZ_SYNC_FLUSH);
+      if (status == MZ_STREAM_END) {
+        break;
+      }
+      if (status != MZ_OK) {
+        ThrowTruncated();
+      }
+    }
+    if (m_Stream.avail_out > 0) {
+      ThrowTruncated();
+    }
+  }
+
+  [[noreturn]] void ThrowTruncated() const
+  {
+    throw std::runtime_error("Corrupt or truncated zip entry " +
+                             std::string(m_Stat.m_filename));
+  }
+
+  const mz_zip_archive_file_stat m_Stat;
+  const mz_uint64 m_DataOffset;
+  // Keeps the in-memory archive alive, or nullptr if the
+  // compressed data is read through m_ReadArchive.
+  const std::shared_ptr<RawBundleResources> m_RawData;
+  const ReadFunction m_ReadArchive;
+
+  mz_stream m_Stream;
+  std::vector<unsigned char> m_Input;
+  mz_uint64 m_Consumed;
+  mz_uint64 m_Produced;
+  mz_uint32 m_Crc32;
+};
+}
+
+BundleResourceContainer::DataReader BundleResourceContainer::GetDataReader(
+  int index)
+{
+  std::shared_ptr<RawBundleResources> rawData;
+  mz_zip_archive_file_stat zipStat;
+  bool hasStat = false;
+  {
+    auto l = LockOpenContainer();
+    rawData = m_RawData;
+    hasStat = index >= 0 && mz_zip_reader_file_stat(&m_ZipArchive, index, &zipStat);
+  }
+
+  mz_uint64 dataOffset = 0;
+  if (!hasStat ||
+      (zipStat.m_method != 0 && zipStat.m_method != MZ_DEFLATED) ||
+      !GetEntryDataOffset(zipStat, rawData.get(), dataOffset)) {
+    return {};
+  }
+  if (rawData &&
+      dataOffset + zipStat.m_comp_size > rawData->GetSize()) {
+    return {};
+  }
+
+  auto self = shared_from_this();
+  auto reader = std::make_shared<ZipEntryReader>(
+    zipStat,
+    dataOffset,
+    std::move(rawData),
+    [self](mz_uint64 offset, void* buffer, std::size_t size) {
+      return self->ReadArchive(offset, buffer, size);
+    });
+  return [reader](char* buffer, std::size_t size) {
+    return reader->Read(buffer, size);
+  };
+}
+
 void BundleResourceContainer::GetChildren(const std::string& resourcePath,
                                           bool relativePaths,
                                           std::vector<std::string>& names,
                                           std::vector<uint32_t>& indices) const
 {
-  auto iter = m_SortedEntries.find(std::make_pair(resourcePath, 0));
-  if (iter == m_SortedEntries.end()) {
+  auto iter = m_DirectoryChildren.find(resourcePath);
+  if (iter == m_DirectoryChildren.end()) {
     return;
   }
 
-  for (++iter; iter != m_SortedEntries.end(); ++iter) {
-    if (resourcePath.size() > iter->first.size())
-      break;
-    if (iter->first.compare(0, resourcePath.size(), resourcePath) == 0) {
-      std::size_t pos = iter->first.find_first_of('/', resourcePath.size());
-      if (pos == std::string::npos || pos == iter->first.size() - 1) {
-        if (relativePaths) {
-          names.push_back(iter->first.substr(resourcePath.size()));
-        } else {
-          names.push_back(iter->first);
-        }
-        indices.push_back(iter->second);
-      }
+  names.reserve(names.size() + iter->second.size());
+  indices.reserve(indices.size() + iter->second.size());
+  for (auto const* child : iter->second) {
+    if (relativePaths) {
+      names.push_back(child->first.substr(resourcePath.size()));
+    } else {
+      names.push_back(child->first);
     }
+    indices.push_back(child->second);
   }
 }
 
@@ -203,10 +523,62 @@ void BundleResourceContainer::InitMiniz()
   if (!rawBundleResourceData || 
     !rawBundleResourceData->GetData() ||
     !mz_zip_reader_init_mem(&m_ZipArchive, rawBundleResourceData->GetData(), rawBundleResourceData->GetSize(), 0)) {
-    if (!mz_zip_reader_init_file(&m_ZipArchive, m_Location.c_str(), 0)) {
+    // Read the zip file with positional reads instead of through a
+    // FILE stream, so that entries can be extracted concurrently.
+    m_ArchiveFile = std::make_unique<ArchiveFile>(m_Location);
+    m_ZipArchive = mz_zip_archive();
+    m_ZipArchive.m_pRead = &ArchiveFile::Read;
+    m_ZipArchive.m_pIO_opaque = m_ArchiveFile.get();
+    if (!m_ArchiveFile->IsOpen() ||
+        !mz_zip_reader_init(&m_ZipArchive, m_ArchiveFile->GetSize(), 0)) {
+      m_ArchiveFile.reset();
       throw std::runtime_error("Could not init zip archive for bundle at " + m_Location);
     }
+    rawBundleResourceData.reset();
+  }
+  m_RawData = std::move(rawBundleResourceData);
+}
+
+bool BundleResourceContainer::GetEntryDataOffset(
+  const mz_zip_archive_file_stat& zipStat,
+  const RawBundleResources* rawData,
+  mz_uint64& offset)
+{
+  // The entry data follows the local file header, which has a fixed
+  // size part followed by the file name and the extra field.
+  const std::size_t localHeaderSize = 30;
+  unsigned char header[localHeaderSize];
+  auto const headerOffset = zipStat.m_local_header_ofs;
+  if (rawData) {
+    if (headerOffset + localHeaderSize > rawData->GetSize()) {
+      return false;
+    }
+    std::memcpy(header,
+                static_cast<const char*>(rawData->GetData()) + headerOffset,
+                localHeaderSize);
+  } else if (ReadArchive(headerOffset, header, localHeaderSize) !=
+             localHeaderSize) {
+    return false;
+  }
+
+  if (header[0] != 'P' || header[1] != 'K' || header[2] != 3 ||
+      header[3] != 4) {
+    return false;
   }
+  auto readLE16 = [&header](std::size_t pos) {
+    return static_cast<mz_uint64>(header[pos]) |
+           static_cast<mz_uint64>(header[pos + 1]) << 8;
+  };
+  offset = headerOffset + localHeaderSize + readLE16(26) + readLE16(28);
+  return true;
+}
+
+std::size_t BundleResourceContainer::ReadArchive(mz_uint64 offset,
+                                                 void* buffer,
+                                                 std::size_t size)
+{
+  auto l = LockOpenContainer();
+  return m_ZipArchive.m_pRead(m_ZipArchive.m_pIO_opaque, offset, buffer, size);
 }
 
 void BundleResourceContainer::InitSortedEntries()
@@ -219,12 +591,70 @@ void BundleResourceContainer::InitSortedEntries()
                                    fileIndex,
                                    fileName,
                                    MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE)) {
-      std::string strFileName = fileName;
-      m_SortedEntries.insert(std::make_pair(strFileName, fileIndex));
-      std::size_t pos = strFileName.find_first_of('/');
-      if (pos != std::string::npos) {
-        m_SortedToplevelDirs.insert(strFileName.substr(0, pos));
-      }
+      InsertSortedEntry(fileName, static_cast<int>(fileIndex));
+    }
+  }
+  InitEntryIndexes();
+}
+
+void BundleResourceContainer::InsertSortedEntry(std::string fileName,
+                                                int fileIndex)
+{
+  std::size_t pos = fileName.find_first_of('/');
+  if (pos != std::string::npos) {
+    m_SortedToplevelDirs.insert(fileName.substr(0, pos));
+  }
+  m_SortedEntries.insert(std::make_pair(std::move(fileName), fileIndex));
+}
+
+namespace {
+char ToLowerAscii(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+}
+
+std::size_t BundleResourceContainer::CaseInsensitiveHash::operator()(
+  const std::string& name) const
+{
+  std::size_t hash = 0;
+  for (char c : name) {
+    hash = hash * 31 + static_cast<unsigned char>(ToLowerAscii(c));
+  }
+  return hash;
+}
+
+bool BundleResourceContainer::CaseInsensitiveEqual::operator()(
+  const std::string& lhs,
+  const std::string& rhs) const
+{
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+           return ToLowerAscii(a) == ToLowerAscii(b);
+         });
+}
+
+void BundleResourceContainer::InitEntryIndexes()
+{
+  m_EntryIndex.reserve(m_SortedEntries.size());
+  for (auto const& entry : m_SortedEntries) {
+    m_EntryIndex.emplace(entry.first, entry.second);
+  }
+
+  // Link every entry to the directory entry it is contained in. Entries
+  // are visited in sorted order, so the children lists stay sorted.
+  for (auto const& entry : m_SortedEntries) {
+    auto const& name = entry.first;
+    if (name.size() < 2) {
+      continue;
+    }
+    auto const pos = name.rfind('/', name.size() - 2);
+    if (pos == std::string::npos) {
+      continue;
+    }
+    auto parent = name.substr(0, pos + 1);
+    if (m_EntryIndex.count(parent) != 0) {
+      m_DirectoryChildren[std::move(parent)].push_back(&entry);
     }
   }
 }
@@ -250,18 +680,32 @@ bool BundleResourceContainer::Matches(const std::string& name,
 
 void BundleResourceContainer::OpenContainer()
 {
-  std::lock_guard<std::mutex> lock(m_ZipFileMutex);
+  std::lock_guard<std::shared_timed_mutex> lock(m_ZipFileMutex);
   if(!m_IsContainerOpen) {
     InitMiniz();
     m_IsContainerOpen = true;
   }
 }
 
+std::shared_lock<std::shared_timed_mutex>
+BundleResourceContainer::LockOpenContainer()
+{
+  std::shared_lock<std::shared_timed_mutex> lock(m_ZipFileMutex);
+  while (!m_IsContainerOpen) {
+    lock.unlock();
+    OpenContainer();
+    lock.lock();
+  }
+  return lock;
+}
+
 void BundleResourceContainer::CloseContainer()
 {
-  std::lock_guard<std::mutex> lock(m_ZipFileMutex);
+  std::lock_guard<std::shared_timed_mutex> lock(m_ZipFileMutex);
   if(m_IsContainerOpen) {
     mz_zip_reader_end(&m_ZipArchive);
+    m_ArchiveFile.reset();
+    m_RawData.reset();
     m_ObjFile.reset();
     m_IsContainerOpen = false;
   }
@@ -28,10 +28,13 @@
 #include "miniz.h"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cppmicroservices {
@@ -44,7 +47,15 @@ class BundleResourceContainer
 {
 
 public:
+  using NameIndexPair = std::pair<std::string, int>;
+
   BundleResourceContainer(const std::string& location);
+
+  /// Create a container from a previously built resource index (see
+  /// GetEntries()). The underlying zip file is not opened until resource
+  /// data or statistics are requested.
+  BundleResourceContainer(const std::string& location,
+                          const std::vector<NameIndexPair>& entries);
   ~BundleResourceContainer();
 
   struct Stat
@@ -56,6 +67,7 @@ public:
       , modifiedTime(0)
       , crc32(0)
       , isDir(false)
+      , isCompressed(false)
     {}
 
     std::string filePath;
@@ -65,17 +77,40 @@ public:
     time_t modifiedTime;
     uint32_t crc32;
     bool isDir;
+    bool isCompressed;
   };
 
   std::string GetLocation() const;
 
   std::vector<std::string> GetTopLevelDirs() const;
 
+  /// Returns all zip entry names and their indices, sorted by name.
+  std::vector<NameIndexPair> GetEntries() const;
+
   bool GetStat(Stat& stat);
   bool GetStat(int index, Stat& stat);
 
   std::unique_ptr<void, void (*)(void*)> GetData(int index);
 
+  /// Returns the data of the entry at index. For entries stored without
+  /// compression in a memory mapped archive, the returned pointer refers
+  /// directly into the mapped archive and keeps the mapping alive.
+  /// Otherwise the entry is decompressed into a newly allocated buffer.
+  /// Returns nullptr if the data could not be read.
+  std::shared_ptr<const void> GetDataView(int index);
+
+  /// Reads uncompressed entry data sequentially. Each call writes at most
+  /// size bytes to buffer and returns the number of bytes written, or 0
+  /// after the last byte has been read. Throws std::runtime_error if the
+  /// entry data is corrupt.
+  using DataReader = std::function<std::size_t(char* buffer, std::size_t size)>;
+
+  /// Returns a reader for the entry at index which inflates compressed
+  /// data in chunks, so that memory use does not grow with the entry
+  /// size. The reader keeps this container alive. Returns an empty
+  /// function if the entry cannot be read incrementally.
+  DataReader GetDataReader(int index);
+
   void GetChildren(const std::string& resourcePath,
                    bool relativePaths,
                    std::vector<std::string>& names,
@@ -94,8 +129,6 @@ public:
   void CloseContainer();
 
 private:
-using NameIndexPair = std::pair<std::string, int>;
-
   struct PairComp
   {
     inline bool operator()(const NameIndexPair& p1,
@@ -106,6 +139,10 @@ using NameIndexPair = std::pair<std::string, int>;
   };
 
   void InitSortedEntries();
+  void InsertSortedEntry(std::string fileName, int fileIndex);
+
+  /// Builds the name and directory indexes from m_SortedEntries.
+  void InitEntryIndexes();
 
   bool Matches(const std::string& name, const std::string& filePattern) const;
 
@@ -118,21 +155,58 @@ using NameIndexPair = std::pair<std::string, int>;
   /// Throws std::runtime_error if the underlying zip file cannot be opened.
   void OpenContainer();
 
+  /// Opens the zip file if necessary and returns a shared lock which
+  /// keeps it open. Any number of threads can read from the zip archive
+  /// while holding the lock.
+  std::shared_lock<std::shared_timed_mutex> LockOpenContainer();
+
+  /// Reads the local file header of the given entry and computes the
+  /// offset of the entry data relative to the start of the zip archive.
+  bool GetEntryDataOffset(const mz_zip_archive_file_stat& zipStat,
+                          const RawBundleResources* rawData,
+                          mz_uint64& offset);
+
+  /// Reads raw archive bytes through the miniz file stream API.
+  std::size_t ReadArchive(mz_uint64 offset, void* buffer, std::size_t size);
+
   const std::string m_Location;
   mz_zip_archive m_ZipArchive;
   std::unique_ptr<BundleObjFile> m_ObjFile;
+  // The memory mapped zip data used by m_ZipArchive, or nullptr if
+  // the zip file is read through a file stream.
+  std::shared_ptr<RawBundleResources> m_RawData;
+  // The zip file read by m_ZipArchive if the zip data is not in memory.
+  struct ArchiveFile;
+  std::unique_ptr<ArchiveFile> m_ArchiveFile;
 
   std::set<NameIndexPair, PairComp> m_SortedEntries;
   std::set<std::string> m_SortedToplevelDirs;
+  // Compare entry names ignoring the ASCII case, like
+  // mz_zip_reader_locate_file does.
+  struct CaseInsensitiveHash
+  {
+    std::size_t operator()(const std::string& name) const;
+  };
+  struct CaseInsensitiveEqual
+  {
+    bool operator()(const std::string& lhs, const std::string& rhs) const;
+  };
 
-  // This is used to synchronize miniz file stream API calls.
-  // Working with file streams is stateful (e.g. current read position)
-  // and hence not thread-safe.
-  mutable std::mutex m_ZipFileStreamMutex;
+  // Maps entry names to zip entry indices.
+  std::unordered_map<std::string,
+                     int,
+                     CaseInsensitiveHash,
+                     CaseInsensitiveEqual>
+    m_EntryIndex;
+  // Maps directory entry names to the entries directly below them, sorted
+  // by name. The elements point into m_SortedEntries.
+  std::unordered_map<std::string, std::vector<const NameIndexPair*>>
+    m_DirectoryChildren;
 
   // Synchronize opening/closing the underlying zip file. Only one thread
-  // should open the underlying zip file.
-  std::mutex m_ZipFileMutex;
+  // should open the underlying zip file. Reading from the zip archive
+  // does not change its state and only requires a shared lock.
+  std::shared_timed_mutex m_ZipFileMutex;
   bool m_IsContainerOpen;
 };
 }
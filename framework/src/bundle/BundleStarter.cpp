@@ -0,0 +1,243 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "BundleStarter.h"
+
+#include "cppmicroservices/Any.h"
+#include "cppmicroservices/Constants.h"
+
+#include "Concurrency.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace cppmicroservices {
+
+namespace {
+
+struct StartNode
+{
+  int level = 1;
+  std::vector<std::string> dependencies;
+  std::vector<std::size_t> dependents;
+  std::size_t pending = 0;
+  bool finished = false;
+};
+
+std::exception_ptr StartError(const std::string& msg)
+{
+  return std::make_exception_ptr(std::runtime_error(msg));
+}
+
+/*
+  Reads the start level and start dependencies from the bundle manifest.
+  Throws if the headers have an invalid type.
+*/
+void ReadStartHeaders(const Bundle& bundle, StartNode& node)
+{
+  auto const& headers = bundle.GetHeaders();
+
+  auto level = headers.find(Constants::BUNDLE_STARTLEVEL);
+  if (level != headers.end()) {
+    try {
+      node.level = any_cast<int>(level->second);
+    } catch (const BadAnyCastException&) {
+      throw std::runtime_error("The manifest header " +
+                               Constants::BUNDLE_STARTLEVEL + " of bundle " +
+                               bundle.GetSymbolicName() +
+                               " must be an integer");
+    }
+  }
+
+  auto dependencies = headers.find(Constants::BUNDLE_STARTDEPENDENCIES);
+  if (dependencies != headers.end()) {
+    try {
+      if (dependencies->second.Type() == typeid(std::vector<Any>)) {
+        for (auto const& dependency :
+             ref_any_cast<std::vector<Any>>(dependencies->second)) {
+          node.dependencies.push_back(any_cast<std::string>(dependency));
+        }
+      } else {
+        node.dependencies.push_back(
+          any_cast<std::string>(dependencies->second));
+      }
+    } catch (const BadAnyCastException&) {
+      throw std::runtime_error(
+        "The manifest header " + Constants::BUNDLE_STARTDEPENDENCIES +
+        " of bundle " + bundle.GetSymbolicName() +
+        " must be a string or an array of strings");
+    }
+  }
+}
+
+/*
+  Starts the bundles of a single start level, honoring the
+  dependency edges between them.
+*/
+void StartLevel(const std::vector<std::size_t>& level,
+                std::vector<StartNode>& nodes,
+                std::vector<BundleStartResult>& results,
+                uint32_t options,
+                std::size_t maxThreads)
+{
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::deque<std::size_t> ready;
+  std::size_t running = 0;
+  std::size_t done = 0;
+
+  for (auto i : level) {
+    if (nodes[i].pending == 0) {
+      ready.push_back(i);
+    }
+  }
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> l(mutex);
+    while (done < level.size()) {
+      if (ready.empty()) {
+        if (running == 0) {
+          // Nothing can make progress anymore, the remaining
+          // bundles depend on each other.
+          for (auto i : level) {
+            if (!nodes[i].finished) {
+              nodes[i].finished = true;
+              if (!results[i].exception) {
+                results[i].exception =
+                  StartError("Cyclic start dependency involving bundle " +
+                             results[i].bundle.GetSymbolicName());
+              }
+              ++done;
+            }
+          }
+          cond.notify_all();
+          break;
+        }
+        cond.wait(l);
+        continue;
+      }
+
+      auto i = ready.front();
+      ready.pop_front();
+      ++running;
+
+      auto exception = results[i].exception;
+      auto duration = std::chrono::nanoseconds::zero();
+      if (!exception) {
+        l.unlock();
+        auto start = std::chrono::steady_clock::now();
+        try {
+          results[i].bundle.Start(options);
+        } catch (...) {
+          exception = std::current_exception();
+        }
+        duration = std::chrono::steady_clock::now() - start;
+        l.lock();
+      }
+
+      --running;
+      ++done;
+      nodes[i].finished = true;
+      results[i].duration = duration;
+      results[i].exception = exception;
+      for (auto dependent : nodes[i].dependents) {
+        if (exception && !results[dependent].exception) {
+          results[dependent].exception = StartError(
+            "Start dependency " + results[i].bundle.GetSymbolicName() +
+            " of bundle " + results[dependent].bundle.GetSymbolicName() +
+            " failed to start");
+        }
+        if (--nodes[dependent].pending == 0) {
+          ready.push_back(dependent);
+        }
+      }
+      cond.notify_all();
+    }
+  };
+
+  RunOnThreads(ThreadCount(level.size(), maxThreads), worker);
+}
+}
+
+std::vector<BundleStartResult> StartBundlesConcurrently(
+  const std::vector<Bundle>& bundles,
+  uint32_t options,
+  std::size_t maxThreads)
+{
+  std::vector<BundleStartResult> results;
+  std::vector<StartNode> nodes(bundles.size());
+  std::unordered_multimap<std::string, std::size_t> indexByName;
+  std::map<int, std::vector<std::size_t>> levels;
+
+  for (std::size_t i = 0; i < bundles.size(); ++i) {
+    results.push_back(
+      { bundles[i], std::chrono::nanoseconds::zero(), nullptr });
+    try {
+      ReadStartHeaders(bundles[i], nodes[i]);
+    } catch (...) {
+      results[i].exception = std::current_exception();
+    }
+    indexByName.emplace(bundles[i].GetSymbolicName(), i);
+    levels[nodes[i].level].push_back(i);
+  }
+
+  for (auto const& level : levels) {
+    for (auto i : level.second) {
+      for (auto const& name : nodes[i].dependencies) {
+        auto range = indexByName.equal_range(name);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+          auto dependency = iter->second;
+          if (dependency == i || results[i].exception) {
+            continue;
+          }
+          if (nodes[dependency].level > level.first) {
+            results[i].exception =
+              StartError("Start dependency " + name + " of bundle " +
+                         bundles[i].GetSymbolicName() +
+                         " has a higher start level");
+          } else if (nodes[dependency].level < level.first) {
+            // Lower start levels have already been processed.
+            if (results[dependency].exception) {
+              results[i].exception =
+                StartError("Start dependency " + name + " of bundle " +
+                           bundles[i].GetSymbolicName() + " failed to start");
+            }
+          } else {
+            nodes[dependency].dependents.push_back(i);
+            ++nodes[i].pending;
+          }
+        }
+      }
+    }
+    StartLevel(level.second, nodes, results, options, maxThreads);
+  }
+
+  return results;
+}
+}
@@ -0,0 +1,56 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CPPMICROSERVICES_BUNDLESTARTER_H
+#define CPPMICROSERVICES_BUNDLESTARTER_H
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleStartResult.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cppmicroservices {
+
+/*
+  Starts the given bundles on up to maxThreads threads, including the
+  calling thread.
+
+  Bundles are started in ascending order of their "bundle.start_level"
+  manifest header. Within a start level, a bundle is started as soon as
+  all bundles listed in its "bundle.start_dependencies" header have been
+  started. Dependencies on bundles which are not part of the given set
+  are ignored. If a bundle fails to start, all bundles depending on it
+  are not started and report the failure. Cyclic dependencies are
+  reported as failures of the involved bundles.
+
+  The results are returned in the order of the given bundles. This
+  function does not throw exceptions from Bundle::Start.
+*/
+std::vector<BundleStartResult> StartBundlesConcurrently(
+  const std::vector<Bundle>& bundles,
+  uint32_t options,
+  std::size_t maxThreads);
+}
+
+#endif // CPPMICROSERVICES_BUNDLESTARTER_H
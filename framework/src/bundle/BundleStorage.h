@@ -23,8 +23,12 @@
 #ifndef CPPMICROSERVICES_BUNDLESTORAGE_H
 #define CPPMICROSERVICES_BUNDLESTORAGE_H
 
+#include "cppmicroservices/AnyMap.h"
+
+#include "BundleResourceCache.h"
 #include "BundleResourceContainer.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +43,22 @@ struct BundleArchive;
 struct BundleStorage
 {
 
+  /**
+   * Parsed manifest headers of the bundles in a bundle library, keyed
+   * by the bundle's top level directory in the library.
+   */
+  using ManifestHeaders = std::map<std::string, std::shared_ptr<const AnyMap>>;
+
+  /**
+   * The content of a bundle library which has been read but not yet
+   * inserted into the storage.
+   */
+  struct PreparedBundleLib
+  {
+    std::shared_ptr<BundleResourceContainer> resCont;
+    ManifestHeaders manifests;
+  };
+
   virtual ~BundleStorage() {}
 
   /**
@@ -50,6 +70,27 @@ struct BundleStorage
   virtual std::vector<std::shared_ptr<BundleArchive>> InsertBundleLib(
     const std::string& location) = 0;
 
+  /**
+   * Read the bundle library at the given location and parse the manifests
+   * of all bundles it contains, without inserting anything into the storage.
+   *
+   * This method can be called concurrently for different locations.
+   *
+   * @param location Location of the bundle library to read.
+   * @return The library content, to be passed to InsertBundleLib(const PreparedBundleLib&).
+   */
+  virtual PreparedBundleLib PrepareBundleLib(const std::string& location) = 0;
+
+  /**
+   * Insert a bundle library previously read by PrepareBundleLib into
+   * persistent storagedata.
+   *
+   * @param lib The bundle library content.
+   * @return A list of BundleArchive instances representing the installed bundles.
+   */
+  virtual std::vector<std::shared_ptr<BundleArchive>> InsertBundleLib(
+    const PreparedBundleLib& lib) = 0;
+
   /**
    * Insert bundles from a container into persistent storagedata.
    *
@@ -82,9 +123,23 @@ struct BundleStorage
    */
   virtual void Close() = 0;
 
+  /// Sets the cache for decompressed resource data which is used by
+  /// archives inserted afterwards.
+  void SetResourceCache(std::shared_ptr<BundleResourceCache> cache)
+  {
+    resourceCache = std::move(cache);
+  }
+
+  std::shared_ptr<BundleResourceCache> GetResourceCache() const
+  {
+    return resourceCache;
+  }
+
 private:
   friend struct BundleArchive;
 
+  std::shared_ptr<BundleResourceCache> resourceCache;
+
   /**
    * Remove bundle archive from archives list.
    *
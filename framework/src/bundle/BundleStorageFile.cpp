@@ -22,65 +22,435 @@
 
 #include "BundleStorageFile.h"
 
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/util/DataContainer.h"
+#include "cppmicroservices/util/FileSystem.h"
+#if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
+#  include "cppmicroservices/util/MappedFile.h"
+#endif
+
+#include "BinaryIO.h"
 #include "BundleArchive.h"
+#include "BundleManifest.h"
+#include "BundleResourceContainer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <random>
 
-#include <stdexcept>
+#ifdef US_PLATFORM_WINDOWS
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
 
 namespace cppmicroservices {
 
-static const std::size_t MAX_ARCHIVE_SIZE = 512;
-static const std::size_t MAX_LOCATION_LEN = 256;
+namespace {
 
-struct ExtraData
+// Cache file layout (see BinaryIO.h for the encoding):
+//
+//   magic "USBC", uint32 version, uint32 record count, records
+//
+// where each record is the bundle library location, the uint32 record
+// length and the record itself:
+//
+//   int64 last modified (nanoseconds), uint64 file size,
+//   uint32 entry count, entry count x (string name, uint32 zip index),
+//   uint32 bundle count, bundle count x (string prefix, string manifest)
+//
+// The manifest string is empty if the bundle has no (valid) manifest,
+// otherwise it uses the binary manifest format of BundleManifest.
+const char CACHE_MAGIC[4] = { 'U', 'S', 'B', 'C' };
+const uint32_t CACHE_VERSION = 3;
+
+// Returns a temporary file name next to path which is unique across
+// processes, so that frameworks sharing a storage area never write to
+// the same temporary file.
+std::string GetUniqueTempFile(const std::string& path)
 {
-  int32_t loc_index; // -1 -> use location field
-  char location[MAX_LOCATION_LEN];
-};
+#ifdef US_PLATFORM_WINDOWS
+  const auto pid = _getpid();
+#else
+  const auto pid = getpid();
+#endif
+  std::random_device rd;
+  return path + ".tmp." + std::to_string(pid) + "." + std::to_string(rd());
+}
+
+std::unique_ptr<DataContainer> ReadCacheFile(const std::string& path)
+{
+  int64_t lastModified = 0;
+  uint64_t size = 0;
+  if (!util::GetFileStatus(path, lastModified, size) || size == 0) {
+    return nullptr;
+  }
+
+#if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
+  std::unique_ptr<DataContainer> mapped(
+    new MappedFile(path, static_cast<std::size_t>(size), 0));
+  if (mapped->GetData()) {
+    return mapped;
+  }
+#endif
+
+  std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+  std::unique_ptr<void, void (*)(void*)> buffer(
+    std::malloc(static_cast<std::size_t>(size)), ::free);
+  if (!file || !buffer ||
+      !file.read(static_cast<char*>(buffer.get()),
+                 static_cast<std::streamsize>(size))) {
+    return nullptr;
+  }
+  return std::unique_ptr<DataContainer>(
+    new RawDataContainer(std::move(buffer), static_cast<std::size_t>(size)));
+}
+}
+
+BundleStorageFile::BundleStorageFile(std::string cacheFile, bool clean)
+  : cacheFile(std::move(cacheFile))
+  , nextFreeId(1)
+{
+  LoadCache(clean);
+}
 
-struct PeristentData
+BundleStorageFile::~BundleStorageFile() = default;
+
+void BundleStorageFile::LoadCache(bool clean)
 {
-  BundleArchive::Data data;
-  char reserved[MAX_ARCHIVE_SIZE - sizeof(BundleArchive::Data) -
-                sizeof(ExtraData)];
-  ExtraData extra;
-};
+  if (clean || cacheFile.empty()) {
+    return;
+  }
+
+  auto data = ReadCacheFile(cacheFile);
+  if (!data) {
+    return;
+  }
 
-BundleStorageFile::BundleStorageFile()
+  // Only index the records here, they are decoded on demand when
+  // the corresponding bundle library is installed.
+  std::unordered_map<std::string, std::pair<std::size_t, std::size_t>> records;
+  try {
+    const char* begin = static_cast<const char*>(data->GetData());
+    BinaryReader reader(begin, data->GetSize());
+    if (std::memcmp(reader.Read(sizeof(CACHE_MAGIC)),
+                    CACHE_MAGIC,
+                    sizeof(CACHE_MAGIC)) != 0 ||
+        reader.ReadUInt32() != CACHE_VERSION) {
+      return;
+    }
+    for (auto count = reader.ReadUInt32(); count > 0; --count) {
+      auto location = reader.ReadString();
+      auto length = reader.ReadUInt32();
+      const char* record = reader.Read(length);
+      records[location] =
+        std::make_pair(static_cast<std::size_t>(record - begin),
+                       static_cast<std::size_t>(length));
+    }
+  } catch (const std::exception&) {
+    // A truncated or otherwise corrupt cache file is ignored
+    // and re-written on Close().
+    return;
+  }
+
+  cachedRecords = std::move(records);
+  cacheData = std::move(data);
+}
+
+std::pair<const char*, std::size_t> BundleStorageFile::FindRecord(
+  const std::string& location,
+  int64_t lastModified,
+  uint64_t size) const
 {
-  throw std::logic_error("not implemented");
+  auto iter = cachedRecords.find(location);
+  if (iter == cachedRecords.end()) {
+    return { nullptr, 0 };
+  }
+
+  const char* record =
+    static_cast<const char*>(cacheData->GetData()) + iter->second.first;
+  try {
+    BinaryReader reader(record, iter->second.second);
+    if (static_cast<int64_t>(reader.ReadUInt64()) != lastModified ||
+        reader.ReadUInt64() != size) {
+      return { nullptr, 0 };
+    }
+  } catch (const std::exception&) {
+    return { nullptr, 0 };
+  }
+  return { record, iter->second.second };
 }
 
 std::vector<std::shared_ptr<BundleArchive>> BundleStorageFile::InsertBundleLib(
-  const std::string& /*location*/)
+  const std::string& location)
 {
-  throw std::logic_error("not implemented");
+  return InsertBundleLib(PrepareBundleLib(location));
+}
+
+BundleStorage::PreparedBundleLib BundleStorageFile::PrepareBundleLib(
+  const std::string& location)
+{
+  int64_t lastModified = 0;
+  uint64_t size = 0;
+  if (!util::GetFileStatus(location, lastModified, size)) {
+    throw std::runtime_error(location + " does not exist");
+  }
+
+  auto record = FindRecord(location, lastModified, size);
+  if (record.first) {
+    usedRecords.Lock(), usedRecords.v.insert(location);
+    // Warm start: re-create the resource index and the manifest headers
+    // from the cache without touching the bundle library.
+    PreparedBundleLib lib;
+    try {
+      BinaryReader reader(record.first, record.second);
+      reader.Read(2 * sizeof(uint64_t));
+
+      std::vector<BundleResourceContainer::NameIndexPair> entries(
+        reader.ReadUInt32());
+      for (auto& entry : entries) {
+        entry.first = reader.ReadString();
+        entry.second = static_cast<int>(reader.ReadUInt32());
+      }
+
+      for (auto count = reader.ReadUInt32(); count > 0; --count) {
+        auto prefix = reader.ReadString();
+        auto manifestLength = reader.ReadUInt32();
+        const char* manifestData = reader.Read(manifestLength);
+        if (manifestLength > 0) {
+          BundleManifest manifest;
+          manifest.ParseBinary(manifestData, manifestLength);
+          lib.manifests[prefix] =
+            std::make_shared<const AnyMap>(manifest.GetHeaders());
+        }
+      }
+
+      lib.resCont =
+        std::make_shared<BundleResourceContainer>(location, entries);
+    } catch (const std::exception&) {
+      // Fall back to reading the bundle library below.
+      lib = PreparedBundleLib();
+    }
+
+    if (lib.resCont) {
+      return lib;
+    }
+  }
+
+  // Cold start: read the bundle library and cache the result.
+  PreparedBundleLib lib;
+  lib.resCont = std::make_shared<BundleResourceContainer>(location);
+  auto topLevelDirs = lib.resCont->GetTopLevelDirs();
+
+  std::string newRecord;
+  WriteUInt64(newRecord, static_cast<uint64_t>(lastModified));
+  WriteUInt64(newRecord, size);
+
+  auto entries = lib.resCont->GetEntries();
+  WriteUInt32(newRecord, static_cast<uint32_t>(entries.size()));
+  for (auto const& entry : entries) {
+    WriteString(newRecord, entry.first);
+    WriteUInt32(newRecord, static_cast<uint32_t>(entry.second));
+  }
+
+  WriteUInt32(newRecord, static_cast<uint32_t>(topLevelDirs.size()));
+  for (auto const& prefix : topLevelDirs) {
+    std::string manifestData;
+    if (auto headers = ParseBundleManifest(*lib.resCont, prefix)) {
+      BundleManifest manifest;
+      manifest.SetHeaders(*headers);
+      try {
+        manifestData = manifest.SerializeBinary();
+        lib.manifests[prefix] = std::move(headers);
+      } catch (const std::exception&) {
+        manifestData.clear();
+      }
+    }
+    WriteString(newRecord, prefix);
+    WriteString(newRecord, manifestData);
+  }
+
+  newRecords.Lock(), newRecords.v[location] = std::move(newRecord);
+
+  return lib;
+}
+
+std::vector<std::shared_ptr<BundleArchive>> BundleStorageFile::InsertBundleLib(
+  const PreparedBundleLib& lib)
+{
+  return InsertArchives(
+    lib.resCont, lib.resCont->GetTopLevelDirs(), lib.manifests);
 }
 
 std::vector<std::shared_ptr<BundleArchive>> BundleStorageFile::InsertArchives(
-  const std::shared_ptr<BundleResourceContainer>& /*resCont*/,
-  const std::vector<std::string>& /*topLevelEntries*/)
+  const std::shared_ptr<BundleResourceContainer>& resCont,
+  const std::vector<std::string>& topLevelEntries)
 {
-  throw std::logic_error("not implemented");
+  return InsertArchives(resCont, topLevelEntries, ManifestHeaders());
 }
 
-bool BundleStorageFile::RemoveArchive(const BundleArchive* /*ba*/)
+std::vector<std::shared_ptr<BundleArchive>> BundleStorageFile::InsertArchives(
+  const std::shared_ptr<BundleResourceContainer>& resCont,
+  const std::vector<std::string>& topLevelEntries,
+  const ManifestHeaders& manifests)
 {
-  throw std::logic_error("not implemented");
+  std::vector<std::shared_ptr<BundleArchive>> res;
+  auto l = archives.Lock();
+  US_UNUSED(l);
+  for (auto const& prefix : topLevelEntries) {
+#ifndef US_BUILD_SHARED_LIBS
+    // The system bundle is already installed
+    if (prefix == Constants::SYSTEM_BUNDLE_SYMBOLICNAME) {
+      continue;
+    }
+#endif
+    auto id = nextFreeId++;
+    auto ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+    std::unique_ptr<BundleArchive::Data> data(
+      new BundleArchive::Data{ id, ts, -1 });
+    auto manifest = manifests.find(prefix);
+    auto p = archives.v.insert(std::make_pair(
+      id,
+      std::make_shared<BundleArchive>(
+        this,
+        std::move(data),
+        resCont,
+        prefix,
+        resCont->GetLocation(),
+        manifest != manifests.end() ? manifest->second : nullptr)));
+    res.push_back(p.first->second);
+  }
+  return res;
+}
+
+bool BundleStorageFile::RemoveArchive(const BundleArchive* ba)
+{
+  auto l = archives.Lock();
+  US_UNUSED(l);
+  auto iter = archives.v.find(ba->GetBundleId());
+  if (iter != archives.v.end()) {
+    archives.v.erase(iter);
+    return true;
+  }
+  return false;
 }
 
 std::vector<std::shared_ptr<BundleArchive>>
 BundleStorageFile::GetAllBundleArchives() const
 {
-  throw std::logic_error("not implemented");
+  std::vector<std::shared_ptr<BundleArchive>> res;
+  auto l = archives.Lock();
+  US_UNUSED(l);
+  for (auto const& v : archives.v) {
+    res.emplace_back(v.second);
+  }
+  return res;
 }
 
 std::vector<long> BundleStorageFile::GetStartOnLaunchBundles() const
 {
-  throw std::logic_error("not implemented");
+  std::vector<long> res;
+  auto l = archives.Lock();
+  US_UNUSED(l);
+  for (auto& v : archives.v) {
+    if (v.second->GetAutostartSetting() != -1) {
+      res.emplace_back(v.second->GetBundleId());
+    }
+  }
+  return res;
+}
+
+void BundleStorageFile::WriteCache()
+{
+  std::string out(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  WriteUInt32(out, CACHE_VERSION);
+
+  // Only keep the records of the bundle libraries installed during this
+  // launch, so that the records of uninstalled or moved libraries do not
+  // accumulate.
+  std::size_t countPos = out.size();
+  uint32_t count = 0;
+  WriteUInt32(out, count);
+
+  auto writeRecord = [&out, &count](const std::string& location,
+                                    const char* record,
+                                    std::size_t length) {
+    WriteString(out, location);
+    WriteUInt32(out, static_cast<uint32_t>(length));
+    out.append(record, length);
+    ++count;
+  };
+
+  for (auto const& r : newRecords.v) {
+    writeRecord(r.first, r.second.data(), r.second.size());
+  }
+  if (cacheData) {
+    const char* begin = static_cast<const char*>(cacheData->GetData());
+    for (auto const& r : cachedRecords) {
+      if (newRecords.v.count(r.first) == 0 &&
+          usedRecords.v.count(r.first) != 0) {
+        writeRecord(r.first, begin + r.second.first, r.second.second);
+      }
+    }
+  }
+
+  std::string countData;
+  WriteUInt32(countData, count);
+  out.replace(countPos, countData.size(), countData);
+
+  // Write to a temporary file first so that a concurrently starting
+  // framework never observes a partially written cache file. The rename
+  // replaces the cache file atomically, the last writer wins.
+  const std::string tmpFile = GetUniqueTempFile(cacheFile);
+  {
+    std::ofstream file(tmpFile,
+                       std::ios_base::out | std::ios_base::binary |
+                         std::ios_base::trunc);
+    if (!file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+      throw std::runtime_error("Could not write bundle cache file " +
+                               tmpFile);
+    }
+  }
+
+  // The cache file may still be mapped.
+  cachedRecords.clear();
+  cacheData.reset();
+
+#ifdef US_PLATFORM_WINDOWS
+  std::remove(cacheFile.c_str());
+#endif
+  if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+    std::remove(tmpFile.c_str());
+    throw std::runtime_error("Could not write bundle cache file " +
+                             cacheFile);
+  }
 }
 
 void BundleStorageFile::Close()
 {
-  throw std::logic_error("not implemented");
+  // Not need to lock "archives", "newRecords" or "usedRecords" here: at
+  // this point, the framework is going down and no other threads can
+  // access it. The cache file is re-written if records were added or
+  // records of the previous cache file were not used.
+  if (!cacheFile.empty() && (!newRecords.v.empty() ||
+                             usedRecords.v.size() != cachedRecords.size())) {
+    try {
+      WriteCache();
+    } catch (const std::exception&) {
+      // The cache is only an optimization, the next launch
+      // of the framework reads the bundle libraries again.
+    }
+  }
+  newRecords.v.clear();
+  usedRecords.v.clear();
+  cachedRecords.clear();
+  cacheData.reset();
+  archives.v.clear();
 }
 }
@@ -23,19 +23,55 @@
 #ifndef CPPMICROSERVICES_BUNDLESTORAGEFILE_H
 #define CPPMICROSERVICES_BUNDLESTORAGEFILE_H
 
+#include "cppmicroservices/AnyMap.h"
+#include "cppmicroservices/detail/Threads.h"
+
 #include "BundleStorage.h"
 
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace cppmicroservices {
 
+class DataContainer;
+
+/**
+ * Bundle storage which persists bundle archive meta-data in a cache
+ * file across framework launches.
+ *
+ * For each installed bundle library the cache stores the zip entry
+ * index and the parsed manifest headers of all bundles it contains,
+ * keyed by the library location, modification time (with nanosecond
+ * resolution where the file system provides it) and size. A later install
+ * of an unchanged library creates its archives from the cache without
+ * reading the library at all.
+ */
 class BundleStorageFile : public BundleStorage
 {
 
 public:
-  BundleStorageFile();
+  /**
+   * Creates a new file based bundle storage.
+   *
+   * @param cacheFile The path of the cache file. The file is read (if it
+   *        exists) during construction and written on Close().
+   * @param clean If true, the content of an existing cache file is
+   *        discarded.
+   */
+  BundleStorageFile(std::string cacheFile, bool clean);
+  ~BundleStorageFile();
 
   std::vector<std::shared_ptr<BundleArchive>> InsertBundleLib(
     const std::string& location);
 
+  PreparedBundleLib PrepareBundleLib(const std::string& location);
+
+  std::vector<std::shared_ptr<BundleArchive>> InsertBundleLib(
+    const PreparedBundleLib& lib);
+
   std::vector<std::shared_ptr<BundleArchive>> InsertArchives(
     const std::shared_ptr<BundleResourceContainer>& resCont,
     const std::vector<std::string>& topLevelEntries);
@@ -47,6 +83,68 @@ public:
   std::vector<long> GetStartOnLaunchBundles() const;
 
   void Close();
+
+private:
+  void LoadCache(bool clean);
+  void WriteCache();
+
+  /**
+   * Looks up the cached record of the bundle library at location.
+   *
+   * @return The record data and length, or a null pointer if the
+   *         library is not cached or has been modified since.
+   */
+  std::pair<const char*, std::size_t> FindRecord(const std::string& location,
+                                                 int64_t lastModified,
+                                                 uint64_t size) const;
+
+  std::vector<std::shared_ptr<BundleArchive>> InsertArchives(
+    const std::shared_ptr<BundleResourceContainer>& resCont,
+    const std::vector<std::string>& topLevelEntries,
+    const ManifestHeaders& manifests);
+
+  const std::string cacheFile;
+
+  /**
+   * The content of the cache file read at construction time.
+   */
+  std::unique_ptr<DataContainer> cacheData;
+
+  /**
+   * Location to (offset, length) of the cached records in cacheData.
+   */
+  std::unordered_map<std::string, std::pair<std::size_t, std::size_t>>
+    cachedRecords;
+
+  /**
+   * Records created by this storage instance, keyed by location.
+   */
+  struct : detail::MultiThreaded<>
+  {
+    std::map<std::string, std::string> v;
+  } newRecords;
+
+  /**
+   * Locations of the records in cachedRecords used by this storage
+   * instance. Only these records are written back to the cache file.
+   */
+  struct : detail::MultiThreaded<>
+  {
+    std::unordered_set<std::string> v;
+  } usedRecords;
+
+  /**
+   * Next available bundle id.
+   */
+  long nextFreeId;
+
+  /**
+   * Bundle id sorted list of all active bundle archives.
+   */
+  struct : detail::MultiThreaded<>
+  {
+    std::map<long, std::shared_ptr<BundleArchive>> v;
+  } archives;
 };
 }
 
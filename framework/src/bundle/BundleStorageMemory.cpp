@@ -25,6 +25,7 @@
 #include "cppmicroservices/Constants.h"
 
 #include "BundleArchive.h"
+#include "BundleManifest.h"
 #include "BundleResourceContainer.h"
 
 #include <chrono>
@@ -42,9 +43,37 @@ BundleStorageMemory::InsertBundleLib(const std::string& location)
   return InsertArchives(resCont, resCont->GetTopLevelDirs());
 }
 
+BundleStorage::PreparedBundleLib BundleStorageMemory::PrepareBundleLib(
+  const std::string& location)
+{
+  PreparedBundleLib lib;
+  lib.resCont = std::make_shared<BundleResourceContainer>(location);
+  for (auto const& prefix : lib.resCont->GetTopLevelDirs()) {
+    if (auto headers = ParseBundleManifest(*lib.resCont, prefix)) {
+      lib.manifests[prefix] = std::move(headers);
+    }
+  }
+  return lib;
+}
+
+std::vector<std::shared_ptr<BundleArchive>>
+BundleStorageMemory::InsertBundleLib(const PreparedBundleLib& lib)
+{
+  return InsertArchives(
+    lib.resCont, lib.resCont->GetTopLevelDirs(), lib.manifests);
+}
+
 std::vector<std::shared_ptr<BundleArchive>> BundleStorageMemory::InsertArchives(
   const std::shared_ptr<BundleResourceContainer>& resCont,
   const std::vector<std::string>& topLevelEntries)
+{
+  return InsertArchives(resCont, topLevelEntries, ManifestHeaders());
+}
+
+std::vector<std::shared_ptr<BundleArchive>> BundleStorageMemory::InsertArchives(
+  const std::shared_ptr<BundleResourceContainer>& resCont,
+  const std::vector<std::string>& topLevelEntries,
+  const ManifestHeaders& manifests)
 {
   std::vector<std::shared_ptr<BundleArchive>> res;
   auto l = archives.Lock();
@@ -59,12 +88,14 @@ std::vector<std::shared_ptr<BundleArchive>> BundleStorageMemory::InsertArchives(
     auto id = nextFreeId++;
     auto ts = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
     std::unique_ptr<BundleArchive::Data> data(new BundleArchive::Data{ id, ts, -1 });
+    auto manifest = manifests.find(prefix);
     auto p = archives.v.insert(std::make_pair(id,
                                               std::make_shared<BundleArchive>(this,
                                                                               std::move(data),
                                                                               resCont,
                                                                               prefix,
-                                                                              resCont->GetLocation())));
+                                                                              resCont->GetLocation(),
+                                                                              manifest != manifests.end() ? manifest->second : nullptr)));
     res.push_back(p.first->second);
   }
   return res;
@@ -41,6 +41,11 @@ public:
   std::vector<std::shared_ptr<BundleArchive>> InsertBundleLib(
     const std::string& location);
 
+  PreparedBundleLib PrepareBundleLib(const std::string& location);
+
+  std::vector<std::shared_ptr<BundleArchive>> InsertBundleLib(
+    const PreparedBundleLib& lib);
+
   std::vector<std::shared_ptr<BundleArchive>> InsertArchives(
     const std::shared_ptr<BundleResourceContainer>& resCont,
     const std::vector<std::string>& topLevelEntries);
@@ -54,6 +59,11 @@ public:
   void Close();
 
 private:
+  std::vector<std::shared_ptr<BundleArchive>> InsertArchives(
+    const std::shared_ptr<BundleResourceContainer>& resCont,
+    const std::vector<std::string>& topLevelEntries,
+    const ManifestHeaders& manifests);
+
   /**
    * Next available bundle id.
    */
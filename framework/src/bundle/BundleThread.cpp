@@ -40,8 +40,6 @@ const int BundleThread::OP_START = 2;
 const int BundleThread::OP_STOP = 3;
 
 #ifdef US_ENABLE_THREADING_SUPPORT
-const std::chrono::milliseconds BundleThread::KEEP_ALIVE(1000);
-
 BundleThread::BundleThread(CoreBundleContext* ctx)
   : be(BundleEvent::BUNDLE_INSTALLED, nullptr)
   , startStopTimeout(0)
@@ -64,8 +62,7 @@ BundleThread::~BundleThread()
 void BundleThread::Quit()
 {
 #ifdef US_ENABLE_THREADING_SUPPORT
-  doRun = false;
-  op.NotifyAll();
+  SignalQuit();
   auto l = th.Lock();
   US_UNUSED(l);
   if (th.v.joinable())
@@ -73,6 +70,16 @@ void BundleThread::Quit()
 #endif
 }
 
+#ifdef US_ENABLE_THREADING_SUPPORT
+void BundleThread::SignalQuit()
+{
+  // set doRun while holding the op lock, otherwise Run() could miss
+  // the notification and wait forever
+  op.Lock(), doRun = false;
+  op.NotifyAll();
+}
+#endif
+
 void BundleThread::Run(CoreBundleContext* fwCtx)
 {
 #ifdef US_ENABLE_THREADING_SUPPORT
@@ -82,43 +89,19 @@ void BundleThread::Run(CoreBundleContext* fwCtx)
     BundlePrivate* bundle = nullptr;
     BundleEventInternal bev{ BundleEvent::BUNDLE_INSTALLED, nullptr };
 
-    while (doRun) {
+    {
+      // Idle threads wait in CoreBundleContext::bundleThreads until they
+      // are picked for the next operation or told to quit.
       auto l = op.Lock();
-      US_UNUSED(l);
-      if (doRun && op.operation == OP_IDLE) {
-        op.WaitFor(l, KEEP_ALIVE);
-      }
+      op.Wait(l, [this] { return !doRun || op.operation != OP_IDLE; });
 
       if (!doRun)
         return;
-      if (op.operation != OP_IDLE) {
-        pr = std::move(op.pr);
-        operation = op.operation;
-        bundle = op.bundle;
-        bev = be.Exchange(
-          BundleEventInternal{ BundleEvent::BUNDLE_INSTALLED, nullptr });
-        break;
-      }
-
-      // If we arrive here, we reached our keep-alive limit without
-      // an operation being queued. However, in the mean time, some
-      // other thread may have picked this thread from the bundleThreads.value
-      // list and calling StartAndWait(). So we only terminate this thread
-      // (by returning) if it was not taken from the bundleThreads list to
-      // do more work. Otherwise, we just keep running for another keep alive
-      // cycle.
-      {
-        auto l2 = fwCtx->bundleThreads.Lock();
-        US_UNUSED(l2);
-        auto iter = std::find(fwCtx->bundleThreads.value.begin(),
-                              fwCtx->bundleThreads.value.end(),
-                              this->shared_from_this());
-        if (iter != fwCtx->bundleThreads.value.end()) {
-          fwCtx->bundleThreads.zombies.push_back(*iter);
-          fwCtx->bundleThreads.value.erase(iter);
-          return;
-        }
-      }
+      pr = std::move(op.pr);
+      operation = op.operation;
+      bundle = op.bundle;
+      bev = be.Exchange(
+        BundleEventInternal{ BundleEvent::BUNDLE_INSTALLED, nullptr });
     }
 
     if (!doRun)
@@ -267,8 +250,24 @@ std::exception_ptr BundleThread::StartAndWait(BundlePrivate* b,
       std::runtime_error("Bundle#" + util::ToString(b->id) + " " + opType +
                          " failed with reason: " + reason));
   } else {
-    b->coreCtx->bundleThreads.Lock(),
-      b->coreCtx->bundleThreads.value.push_front(this->shared_from_this());
+    std::shared_ptr<BundleThread> surplus;
+    {
+      auto& bundleThreads = b->coreCtx->bundleThreads;
+      auto l = bundleThreads.Lock();
+      US_UNUSED(l);
+      bundleThreads.value.push_front(this->shared_from_this());
+      // Keep at most poolSize idle threads. The least recently used one
+      // quits and is joined later, we must not join it while holding
+      // the packages lock.
+      if (bundleThreads.value.size() > bundleThreads.poolSize) {
+        surplus = bundleThreads.value.back();
+        bundleThreads.value.pop_back();
+        bundleThreads.zombies.push_back(surplus);
+      }
+    }
+    if (surplus) {
+      surplus->SignalQuit();
+    }
     if (operation != op.operation) {
       // TODO! Handle when operation has changed.
       // i.e. uninstall during operation?
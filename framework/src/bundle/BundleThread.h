@@ -53,8 +53,6 @@ class BundleThread : public std::enable_shared_from_this<BundleThread>
   detail::Atomic<BundleEventInternal> be;
 
 #ifdef US_ENABLE_THREADING_SUPPORT
-  const static std::chrono::milliseconds KEEP_ALIVE;
-
   std::chrono::milliseconds startStopTimeout;
 
   struct Op
@@ -76,6 +74,11 @@ class BundleThread : public std::enable_shared_from_this<BundleThread>
   {
     std::thread v;
   } th;
+
+  /**
+   * Makes Run() return without joining this thread.
+   */
+  void SignalQuit();
 #endif
 
 public:
@@ -40,14 +40,31 @@ const std::string BUNDLE_DOCURL = "bundle.doc_url";
 const std::string BUNDLE_CONTACTADDRESS = "bundle.contact_address";
 const std::string BUNDLE_SYMBOLICNAME = "bundle.symbolic_name";
 const std::string BUNDLE_MANIFESTVERSION = "bundle.manifest_version";
+const std::string BUNDLE_STARTLEVEL = "bundle.start_level";
+const std::string BUNDLE_STARTDEPENDENCIES = "bundle.start_dependencies";
 const std::string BUNDLE_ACTIVATIONPOLICY = "bundle.activation_policy";
 const std::string ACTIVATION_LAZY = "lazy";
+const std::string BUNDLE_LAZYSERVICES = "bundle.lazy_services";
 const std::string FRAMEWORK_VERSION = "org.cppmicroservices.framework.version";
 const std::string FRAMEWORK_VENDOR = "org.cppmicroservices.framework.vendor";
 const std::string FRAMEWORK_STORAGE = "org.cppmicroservices.framework.storage";
 const std::string FRAMEWORK_STORAGE_CLEAN =
   "org.cppmicroservices.framework.storage.clean";
 const std::string FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT = "onFirstInit";
+const std::string FRAMEWORK_STORAGE_TYPE =
+  "org.cppmicroservices.framework.storage.type";
+const std::string FRAMEWORK_STORAGE_TYPE_MEMORY = "memory";
+const std::string FRAMEWORK_STORAGE_TYPE_FILE = "file";
+const std::string FRAMEWORK_BUNDLE_INSTALL_THREADS =
+  "org.cppmicroservices.framework.install.threads";
+const std::string FRAMEWORK_BUNDLE_START_THREADS =
+  "org.cppmicroservices.framework.start.threads";
+const std::string FRAMEWORK_BUNDLE_THREADS =
+  "org.cppmicroservices.framework.bundle.threads";
+const std::string FRAMEWORK_BUNDLE_PREFETCH =
+  "org.cppmicroservices.framework.bundle.prefetch";
+const std::string FRAMEWORK_RESOURCE_CACHE_SIZE =
+  "org.cppmicroservices.framework.resource_cache.size";
 const std::string FRAMEWORK_THREADING_SUPPORT =
   "org.cppmicroservices.framework.threading.support";
 const std::string FRAMEWORK_THREADING_SINGLE = "single";
@@ -32,13 +32,17 @@ US_MSVC_DISABLE_WARNING(4355)
 #include "cppmicroservices/util/FileSystem.h"
 #include "cppmicroservices/util/String.h"
 
+#include "BundlePrefetcher.h"
+#include "BundleStorageFile.h"
 #include "BundleStorageMemory.h"
 #include "BundleThread.h"
 #include "BundleUtils.h"
 #include "FrameworkPrivate.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <memory>
+#include <thread>
 
 #ifdef US_PLATFORM_POSIX
 #include <dlfcn.h>
@@ -93,6 +97,8 @@ CoreBundleContext::CoreBundleContext(const std::unordered_map<std::string, Any>&
   , firstInit(true)
   , initCount(0)
   , libraryLoadOptions(0)
+  , installThreads(1)
+  , startThreads(1)
 {
   auto enableDiagLog = any_cast<bool>(frameworkProperties.at(Constants::FRAMEWORK_LOG));
   std::ostream* diagnosticLogger = (logger) ? logger : &std::clog;
@@ -118,12 +124,14 @@ void CoreBundleContext::Init()
   DIAG_LOG(*sink) << "initializing";
   initCount++;
 
+  bool cleanStorage = false;
   auto storageCleanProp =
     frameworkProperties.find(Constants::FRAMEWORK_STORAGE_CLEAN);
   if (firstInit && storageCleanProp != frameworkProperties.end() &&
       storageCleanProp->second ==
         Constants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT) {
     // DeleteFWDir();
+    cleanStorage = true;
     firstInit = false;
   }
 
@@ -135,8 +143,57 @@ void CoreBundleContext::Init()
 
   frameworkProperties[Constants::FRAMEWORK_UUID] = ss.str();
 
-  // $TODO we only support non-persistent (main memory) storage yet
-  storage = std::make_unique<BundleStorageMemory>();
+  storage.reset();
+  auto storageTypeProp =
+    frameworkProperties.find(Constants::FRAMEWORK_STORAGE_TYPE);
+  if (storageTypeProp != frameworkProperties.end() &&
+      storageTypeProp->second == Constants::FRAMEWORK_STORAGE_TYPE_FILE) {
+    try {
+      auto cacheDir = GetPersistentStoragePath(this, "bundles", /*create=*/true);
+      if (cacheDir.empty()) {
+        DIAG_LOG(*sink) << Constants::FRAMEWORK_STORAGE
+                        << " is empty, the bundle meta-data is not "
+                           "persisted across framework launches";
+      }
+      storage = std::make_unique<BundleStorageFile>(
+        cacheDir.empty() ? cacheDir
+                         : cacheDir + util::DIR_SEP + "bundles.cache",
+        cleanStorage);
+    } catch (const std::exception& e) {
+      DIAG_LOG(*sink) << "Using the memory bundle storage: " << e.what();
+    }
+  }
+  if (!storage) {
+    storage = std::make_unique<BundleStorageMemory>();
+  }
+
+  std::size_t resourceCacheSize = 0;
+  auto resourceCacheProp =
+    frameworkProperties.find(Constants::FRAMEWORK_RESOURCE_CACHE_SIZE);
+  if (resourceCacheProp != frameworkProperties.end()) {
+    try {
+      resourceCacheSize = static_cast<std::size_t>(
+        (std::max)(any_cast<int>(resourceCacheProp->second), 0));
+    } catch (...) {
+      DIAG_LOG(*sink) << "Ignoring invalid value of "
+                      << Constants::FRAMEWORK_RESOURCE_CACHE_SIZE;
+    }
+  }
+  storage->SetResourceCache(
+    std::make_shared<BundleResourceCache>(resourceCacheSize));
+
+  auto prefetchProp =
+    frameworkProperties.find(Constants::FRAMEWORK_BUNDLE_PREFETCH);
+  if (prefetchProp != frameworkProperties.end()) {
+    try {
+      if (any_cast<bool>(prefetchProp->second)) {
+        prefetcher = std::make_unique<BundlePrefetcher>();
+      }
+    } catch (...) {
+      DIAG_LOG(*sink) << "Ignoring invalid value of "
+                      << Constants::FRAMEWORK_BUNDLE_PREFETCH;
+    }
+  }
   //  if (frameworkProperties[FWProps::READ_ONLY_PROP] == true)
   //  {
   //    dataStorage.clear();
@@ -195,6 +252,36 @@ void CoreBundleContext::Init()
   }
   DIAG_LOG(*sink) << "Library Load Options = " << libraryLoadOptions;
 #endif
+
+  installThreads =
+    GetThreadCount(Constants::FRAMEWORK_BUNDLE_INSTALL_THREADS);
+  startThreads = GetThreadCount(Constants::FRAMEWORK_BUNDLE_START_THREADS);
+  auto bundleThreadPoolSize =
+    GetThreadCount(Constants::FRAMEWORK_BUNDLE_THREADS);
+  bundleThreads.Lock(), bundleThreads.poolSize = bundleThreadPoolSize;
+  DIAG_LOG(*sink) << "Bundle install threads = " << installThreads
+                  << ", bundle start threads = " << startThreads
+                  << ", bundle threads = " << bundleThreadPoolSize;
+}
+
+std::size_t CoreBundleContext::GetThreadCount(const std::string& key) const
+{
+#ifdef US_ENABLE_THREADING_SUPPORT
+  std::size_t threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+  auto prop = frameworkProperties.find(key);
+  if (prop != frameworkProperties.end()) {
+    try {
+      threads =
+        static_cast<std::size_t>((std::max)(any_cast<int>(prop->second), 1));
+    } catch (...) {
+      DIAG_LOG(*sink) << "Ignoring invalid value of " << key;
+    }
+  }
+  return threads;
+#else
+  US_UNUSED(key);
+  return 1;
+#endif
 }
 
 void CoreBundleContext::Uninit0()
@@ -206,6 +293,7 @@ void CoreBundleContext::Uninit0()
 
 void CoreBundleContext::Uninit1()
 {
+  prefetcher.reset();
   bundleRegistry.Clear();
   services.Clear();
   listeners.Clear();
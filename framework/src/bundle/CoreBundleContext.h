@@ -59,6 +59,7 @@ as specified in the OSGi R4.2 specifications.
 
 namespace cppmicroservices {
 
+class BundlePrefetcher;
 struct BundleStorage;
 class BundleThread;
 class FrameworkPrivate;
@@ -99,12 +100,16 @@ public:
   std::shared_ptr<detail::LogSink> sink;
 
   /**
-   * Threads for running listeners and activators
+   * Threads for running listeners and activators. Idle threads are
+   * kept in value, most recently used first. Up to poolSize of them
+   * are kept alive, a thread returned to a full pool makes the least
+   * recently used one quit and moves it to zombies.
    */
   struct : detail::MultiThreaded<>
   {
     std::list<std::shared_ptr<BundleThread>> value;
     std::list<std::shared_ptr<BundleThread>> zombies;
+    std::size_t poolSize = 1;
   } bundleThreads;
 
   /**
@@ -112,6 +117,12 @@ public:
    */
   std::unique_ptr<BundleStorage> storage;
 
+  /**
+   * Reads bundle libraries ahead after installation, or nullptr
+   * if prefetching is disabled.
+   */
+  std::unique_ptr<BundlePrefetcher> prefetcher;
+
   /**
    * Private Bundle Data Storage
    */
@@ -160,6 +171,18 @@ public:
    * Flags to use for dlopen calls on unix systems. Ignored on Windows.
    */
   int libraryLoadOptions;
+
+  /**
+   * The maximum number of threads used to read bundle libraries
+   * when installing several bundle libraries at once.
+   */
+  std::size_t installThreads;
+
+  /**
+   * The maximum number of threads used to start bundles
+   * when starting several bundles at once.
+   */
+  std::size_t startThreads;
   
   ~CoreBundleContext();
 
@@ -180,6 +203,12 @@ public:
    */
   std::string GetDataStorage(long id) const;
 
+  /**
+   * Get the thread count configured by the framework property key,
+   * defaulting to the number of hardware threads.
+   */
+  std::size_t GetThreadCount(const std::string& key) const;
+
 private:
   // The core context is exclusively constructed by the FrameworkFactory class
   friend class FrameworkFactory;
@@ -149,6 +149,14 @@ void ServiceHooks::FilterServiceReferences(
   }
 }
 
+bool ServiceHooks::HasServiceEventListenerHooks() const
+{
+  std::vector<ServiceRegistrationBase> eventListenerHooks;
+  coreCtx->services.Get(us_service_interface_iid<ServiceEventListenerHook>(),
+                        eventListenerHooks);
+  return !eventListenerHooks.empty();
+}
+
 void ServiceHooks::FilterServiceEventReceivers(
   const ServiceEvent& evt,
   ServiceListeners::ServiceListenerEntries& receivers)
@@ -67,6 +67,8 @@ public:
                                const std::string& filter,
                                std::vector<ServiceReferenceBase>& refs);
 
+  bool HasServiceEventListenerHooks() const;
+
   void FilterServiceEventReceivers(
     const ServiceEvent& evt,
     ServiceListeners::ServiceListenerEntries& receivers);
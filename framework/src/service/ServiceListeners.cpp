@@ -399,10 +399,15 @@ void ServiceListeners::ServiceChanged(ServiceListenerEntries& receivers,
 void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt,
                                                    ServiceListenerEntries& set)
 {
-  // Filter the original set of listeners
-  ServiceListenerEntries receivers = (this->Lock(), serviceSet);
-  // This must not be called with any locks held
-  coreCtx->serviceHooks.FilterServiceEventReceivers(evt, receivers);
+  // Filter the original set of listeners. The set is only copied if there
+  // are event listener hooks, otherwise all listeners receive the event.
+  ServiceListenerEntries filteredReceivers;
+  const bool filter = coreCtx->serviceHooks.HasServiceEventListenerHooks();
+  if (filter) {
+    filteredReceivers = (this->Lock(), serviceSet);
+    // This must not be called with any locks held
+    coreCtx->serviceHooks.FilterServiceEventReceivers(evt, filteredReceivers);
+  }
 
   // Get a copy of the service reference and keep it until we are
   // done with its properties.
@@ -412,6 +417,8 @@ void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt,
   {
     auto l = this->Lock();
     US_UNUSED(l);
+    const ServiceListenerEntries& receivers =
+      filter ? filteredReceivers : serviceSet;
     // Check complicated or empty listener filters
     for (auto& sse : complicatedListeners) {
       if (receivers.count(sse) == 0)
@@ -64,6 +64,8 @@ InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceFromFactory(
   const std::shared_ptr<ServiceFactory>& factory)
 {
   assert(factory && "Factory service pointer is nullptr");
+  // Use the framework of the requesting bundle for error reporting, the
+  // registration might be unregistered while calling into the factory.
   InterfaceMapConstPtr s;
   try {
     InterfaceMapConstPtr smap =
@@ -72,7 +74,7 @@ InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceFromFactory(
     if (!smap || smap->empty()) {
       std::string message =
         "ServiceFactory returned an empty or nullptr interface map.";
-      registration->bundle->coreCtx->listeners.SendFrameworkEvent(
+      bundle->coreCtx->listeners.SendFrameworkEvent(
         FrameworkEvent(
           FrameworkEvent::Type::FRAMEWORK_ERROR,
           MakeBundle(bundle->shared_from_this()),
@@ -91,7 +93,7 @@ InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceFromFactory(
           clazz != "org.cppmicroservices.factory") {
         std::string message(
           "ServiceFactory produced an object that did not implement: " + clazz);
-        registration->bundle->coreCtx->listeners.SendFrameworkEvent(
+        bundle->coreCtx->listeners.SendFrameworkEvent(
           FrameworkEvent(
             FrameworkEvent::Type::FRAMEWORK_WARNING,
             MakeBundle(bundle->shared_from_this()),
@@ -102,7 +104,7 @@ InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceFromFactory(
     }
     s = smap;
   } catch (const cppmicroservices::SharedLibraryException&) {
-    registration->bundle->coreCtx->listeners.SendFrameworkEvent(
+    bundle->coreCtx->listeners.SendFrameworkEvent(
       FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
                      MakeBundle(bundle->shared_from_this()),
                      "Failed to load shared library",
@@ -111,7 +113,7 @@ InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceFromFactory(
   } catch (const std::exception& ex) {
     s.reset();
     std::string message = "ServiceFactory threw an unknown exception.";
-    registration->bundle->coreCtx->listeners.SendFrameworkEvent(
+    bundle->coreCtx->listeners.SendFrameworkEvent(
       FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
                      MakeBundle(bundle->shared_from_this()),
                      message,
@@ -236,6 +238,14 @@ InterfaceMapConstPtr ServiceReferenceBasePrivate::GetServiceInterfaceMap(
   auto l = registration->Lock();
   US_UNUSED(l);
 
+  // The service might have been unregistered while calling into the
+  // service factory, e.g. a placeholder for a lazily activated bundle.
+  // Do not cache the service object of an unregistered service, nobody
+  // would release it.
+  if (!registration->available) {
+    return s;
+  }
+
   registration->dependents.insert(std::make_pair(bundle, 0));
 
   if (s && !s->empty()) {
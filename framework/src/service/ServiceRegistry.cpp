@@ -52,27 +52,31 @@ Properties ServiceRegistry::CreateServiceProperties(
   long sid)
 {
   static std::atomic<long> nextServiceID(1);
-  ServiceProperties props(in);
+
+  // Build the final property set in one pass: the caller supplied
+  // properties are copied exactly once and the framework defined ones
+  // are moved in. Existing keys take precedence, as before.
+  Properties props(in, 3);
 
   if (!classes.empty()) {
-    props.insert(std::make_pair(Constants::OBJECTCLASS, classes));
+    props.Insert_unlocked(std::string(Constants::OBJECTCLASS), Any(classes));
   }
 
-  props.insert(
-    std::make_pair(Constants::SERVICE_ID, sid != -1 ? sid : nextServiceID++));
+  props.Insert_unlocked(std::string(Constants::SERVICE_ID),
+                        Any(sid != -1 ? sid : nextServiceID++));
 
   if (isPrototypeFactory) {
-    props.insert(
-      std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_PROTOTYPE));
+    props.Insert_unlocked(std::string(Constants::SERVICE_SCOPE),
+                          Any(Constants::SCOPE_PROTOTYPE));
   } else if (isFactory) {
-    props.insert(
-      std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_BUNDLE));
+    props.Insert_unlocked(std::string(Constants::SERVICE_SCOPE),
+                          Any(Constants::SCOPE_BUNDLE));
   } else {
-    props.insert(
-      std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_SINGLETON));
+    props.Insert_unlocked(std::string(Constants::SERVICE_SCOPE),
+                          Any(Constants::SCOPE_SINGLETON));
   }
 
-  return Properties(std::move(props));
+  return props;
 }
 
 ServiceRegistry::ServiceRegistry(CoreBundleContext* coreCtx)
@@ -98,8 +102,9 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(BundlePrivate* bundle
        : false);
 
   std::vector<std::string> classes;
+  classes.reserve(service->size());
   // Check if service implements claimed classes and that they exist.
-  for (auto i : *service) {
+  for (auto& i : *service) {
     if (i.first.empty() || (!isFactory && i.second == nullptr)) {
       throw std::invalid_argument("Can't register as null class");
     }
@@ -0,0 +1,108 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BINARYIO_H
+#define CPPMICROSERVICES_BINARYIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace cppmicroservices {
+
+//-------------------------------------------------------------------
+// Little endian encoding helpers for the framework's binary formats
+//-------------------------------------------------------------------
+
+inline void WriteUInt32(std::string& out, uint32_t value)
+{
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+inline void WriteUInt64(std::string& out, uint64_t value)
+{
+  WriteUInt32(out, static_cast<uint32_t>(value & 0xFFFFFFFF));
+  WriteUInt32(out, static_cast<uint32_t>(value >> 32));
+}
+
+inline void WriteString(std::string& out, const std::string& value)
+{
+  WriteUInt32(out, static_cast<uint32_t>(value.size()));
+  out.append(value);
+}
+
+/**
+ * Bounds-checked cursor over a read-only buffer. All read methods
+ * throw std::runtime_error if the buffer is too short.
+ */
+class BinaryReader
+{
+public:
+  BinaryReader(const char* data, std::size_t size)
+    : current(data)
+    , end(data + size)
+  {}
+
+  bool AtEnd() const { return current == end; }
+
+  const char* Read(std::size_t n)
+  {
+    if (static_cast<std::size_t>(end - current) < n) {
+      throw std::runtime_error("Unexpected end of binary data");
+    }
+    const char* p = current;
+    current += n;
+    return p;
+  }
+
+  uint8_t ReadUInt8() { return static_cast<uint8_t>(*Read(1)); }
+
+  uint32_t ReadUInt32()
+  {
+    auto p = reinterpret_cast<const unsigned char*>(Read(4));
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  uint64_t ReadUInt64()
+  {
+    uint64_t low = ReadUInt32();
+    return low | (static_cast<uint64_t>(ReadUInt32()) << 32);
+  }
+
+  std::string ReadString()
+  {
+    auto len = ReadUInt32();
+    return std::string(Read(len), len);
+  }
+
+private:
+  const char* current;
+  const char* const end;
+};
+}
+
+#endif // CPPMICROSERVICES_BINARYIO_H
@@ -0,0 +1,82 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_CONCURRENCY_H
+#define CPPMICROSERVICES_CONCURRENCY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace cppmicroservices {
+
+/*
+  Calls worker() on numThreads threads, including the calling thread,
+  and waits for all of them to finish. If not all threads can be
+  created, continues with the threads created so far.
+*/
+template<class Worker>
+void RunOnThreads(std::size_t numThreads, const Worker& worker)
+{
+  std::vector<std::thread> threads;
+  try {
+    for (std::size_t i = 1; i < numThreads; ++i) {
+      threads.emplace_back(worker);
+    }
+  } catch (const std::system_error&) {
+    // Continue with the threads created so far.
+  }
+  worker();
+  for (auto& th : threads) {
+    th.join();
+  }
+}
+
+/*
+  Returns the number of threads to use for count tasks and
+  at most maxThreads threads, with a minimum of one.
+*/
+inline std::size_t ThreadCount(std::size_t count, std::size_t maxThreads)
+{
+  return (std::min)(count, (std::max<std::size_t>)(maxThreads, 1));
+}
+
+/*
+  Calls task(i) for all i in [0, count) on up to maxThreads threads,
+  including the calling thread. The task must not throw.
+*/
+template<class Task>
+void RunConcurrently(std::size_t count, std::size_t maxThreads, const Task& task)
+{
+  std::atomic<std::size_t> next(0);
+  RunOnThreads(ThreadCount(count, maxThreads), [&next, count, &task]() {
+    for (std::size_t i = next++; i < count; i = next++) {
+      task(i);
+    }
+  });
+}
+}
+
+#endif // CPPMICROSERVICES_CONCURRENCY_H
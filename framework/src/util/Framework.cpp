@@ -24,6 +24,9 @@
 
 #include "cppmicroservices/FrameworkEvent.h"
 
+#include "BundlePrivate.h"
+#include "BundleStorage.h"
+#include "CoreBundleContext.h"
 #include "FrameworkPrivate.h"
 
 namespace cppmicroservices {
@@ -71,4 +74,26 @@ FrameworkEvent Framework::WaitForStop(const std::chrono::milliseconds& timeout)
 {
   return pimpl(d)->WaitForStop(timeout);
 }
+
+BundleResourceCacheStatistics Framework::GetResourceCacheStatistics() const
+{
+  auto const& storage = d->coreCtx->storage;
+  if (auto cache = storage ? storage->GetResourceCache() : nullptr) {
+    return cache->GetStatistics();
+  }
+  return BundleResourceCacheStatistics();
+}
+
+std::map<long, BundleLoadStatistics> Framework::GetBundleLoadStatistics() const
+{
+  std::map<long, BundleLoadStatistics> result;
+  for (auto const& b : d->coreCtx->bundleRegistry.GetBundles()) {
+    BundleLoadStatistics stats;
+    stats.prefetched = b->libPrefetched;
+    stats.prefetchTime = std::chrono::nanoseconds(b->libPrefetchTime);
+    stats.loadTime = std::chrono::nanoseconds(b->libLoadTime);
+    result.emplace(b->id, stats);
+  }
+  return result;
+}
 }
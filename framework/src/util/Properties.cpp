@@ -56,6 +56,27 @@ Properties::Properties(const AnyMap& p)
   }
 }
 
+Properties::Properties(const ServiceProperties& p, std::size_t extraCapacity)
+{
+  if (p.size() + extraCapacity >
+      static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    throw std::runtime_error("Properties contain too many keys");
+  }
+
+  keys.reserve(p.size() + extraCapacity);
+  values.reserve(p.size() + extraCapacity);
+
+  for (auto& iter : p) {
+    if (Find_unlocked(iter.first) > -1) {
+      std::string msg("Properties contain case variants of the key: ");
+      msg += iter.first;
+      throw std::runtime_error(msg.c_str());
+    }
+    keys.push_back(iter.first);
+    values.push_back(iter.second);
+  }
+}
+
 Properties::Properties(Properties&& o)
   : keys(std::move(o.keys))
   , values(std::move(o.values))
@@ -111,6 +132,21 @@ std::vector<std::string> Properties::Keys_unlocked() const
   return keys;
 }
 
+void Properties::Insert_unlocked(std::string&& key, Any&& value)
+{
+  int i = Find_unlocked(key);
+  if (i > -1) {
+    if (keys[static_cast<std::size_t>(i)] == key) {
+      return;
+    }
+    std::string msg("Properties contain case variants of the key: ");
+    msg += key;
+    throw std::runtime_error(msg.c_str());
+  }
+  keys.push_back(std::move(key));
+  values.push_back(std::move(value));
+}
+
 void Properties::Clear_unlocked()
 {
   keys.clear();
@@ -25,6 +25,7 @@
 
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/AnyMap.h"
+#include "cppmicroservices/ServiceProperties.h"
 #include "cppmicroservices/detail/Threads.h"
 
 #include <string>
@@ -38,6 +39,13 @@ class Properties : public detail::MultiThreaded<>
 public:
   explicit Properties(const AnyMap& props);
 
+  /**
+   * Copies <code>props</code> directly into the key and value storage,
+   * reserving room for <code>extraCapacity</code> further entries which
+   * can then be added with Insert_unlocked without re-allocating.
+   */
+  Properties(const ServiceProperties& props, std::size_t extraCapacity);
+
   Properties(Properties&& o);
   Properties& operator=(Properties&& o);
 
@@ -49,6 +57,15 @@ public:
 
   std::vector<std::string> Keys_unlocked() const;
 
+  /**
+   * Moves <code>key</code> and <code>value</code> into this object unless
+   * a property with exactly the same key already exists, in which case the
+   * existing value is kept (like std::unordered_map::insert).
+   *
+   * @throws std::runtime_error if a case variant of <code>key</code> exists.
+   */
+  void Insert_unlocked(std::string&& key, Any&& value);
+
   void Clear_unlocked();
 
 private:
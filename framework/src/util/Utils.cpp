@@ -94,7 +94,8 @@ bool OnlyContainsManifest(const std::shared_ptr<BundleResourceContainer>& resCon
                          names.end(),
                          [](const std::string& resourceName) -> bool {
                            return resourceName ==
-                             std::string("manifest.json");
+                                    std::string("manifest.json") ||
+                                  resourceName == std::string("manifest.bin");
                          });
     });
 }
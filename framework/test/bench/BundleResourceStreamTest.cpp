@@ -0,0 +1,303 @@
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/BundleResourceStream.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+#if defined(__linux__)
+/// Returns the value of the given field of /proc/self/status in bytes.
+double ReadProcStatus(const std::string& field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, field.size(), field) == 0) {
+      return std::stod(line.substr(field.size() + 1)) * 1024;
+    }
+  }
+  return 0;
+}
+
+/// Resets the peak resident set size of this process to the current one.
+void ResetPeakRss()
+{
+  std::ofstream("/proc/self/clear_refs") << "5";
+}
+#endif
+
+/// Reports how much the peak resident set size grew above the
+/// resident set size at construction time.
+class PeakRssCounter
+{
+public:
+  PeakRssCounter()
+#if defined(__linux__)
+    : baseline((ResetPeakRss(), ReadProcStatus("VmRSS:")))
+#endif
+  {}
+
+  void Report(benchmark::State& state) const
+  {
+#if defined(__linux__)
+    state.counters["PeakRssGrowth"] = ReadProcStatus("VmHWM:") - baseline;
+#else
+    (void)state;
+#endif
+  }
+
+private:
+#if defined(__linux__)
+  double baseline;
+#endif
+};
+}
+
+class BundleResourceStreamFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State&)
+  {
+    using namespace cppmicroservices;
+
+    framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+    framework->Start();
+    auto bundle = testing::InstallLib(framework->GetBundleContext(),
+                                      "largeResourceBundle");
+    resource = bundle.GetResource("large.txt");
+  }
+
+  void TearDown(const ::benchmark::State&)
+  {
+    using namespace std::chrono;
+
+    resource = cppmicroservices::BundleResource();
+    framework->Stop();
+    framework->WaitForStop(milliseconds::zero());
+  }
+
+  ~BundleResourceStreamFixture() { framework.reset(); }
+
+protected:
+  std::unique_ptr<cppmicroservices::BundleResourceStream> Open(
+    std::size_t windowSize) const
+  {
+    using namespace cppmicroservices;
+    if (windowSize == 0) {
+      return std::make_unique<BundleResourceStream>(resource,
+                                                    std::ios_base::binary);
+    }
+    return std::make_unique<BundleResourceStream>(
+      resource, std::ios_base::binary, windowSize);
+  }
+
+  std::shared_ptr<cppmicroservices::Framework> framework;
+  cppmicroservices::BundleResource resource;
+};
+
+/// Benchmark the time from opening a stream on a large compressed resource
+/// until the first byte is available. A window size of 0 selects the
+/// default stream which decompresses the whole resource up front.
+BENCHMARK_DEFINE_F(BundleResourceStreamFixture, TimeToFirstByte)
+(benchmark::State& state)
+{
+  using namespace std::chrono;
+
+  auto const windowSize = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    auto start = high_resolution_clock::now();
+    auto rs = Open(windowSize);
+    benchmark::DoNotOptimize(rs->get());
+    auto end = high_resolution_clock::now();
+    state.SetIterationTime(duration_cast<duration<double>>(end - start).count());
+  }
+}
+
+/// Benchmark reading a large compressed resource completely and report
+/// the growth of the peak resident set size while doing so.
+BENCHMARK_DEFINE_F(BundleResourceStreamFixture, ReadAll)
+(benchmark::State& state)
+{
+  using namespace std::chrono;
+
+  auto const windowSize = static_cast<std::size_t>(state.range(0));
+  std::vector<char> buffer(64 * 1024);
+  PeakRssCounter peakRss;
+  for (auto _ : state) {
+    auto start = high_resolution_clock::now();
+    auto rs = Open(windowSize);
+    while (rs->read(buffer.data(), buffer.size())) {
+    }
+    auto end = high_resolution_clock::now();
+    state.SetIterationTime(duration_cast<duration<double>>(end - start).count());
+  }
+  peakRss.Report(state);
+  state.SetBytesProcessed(state.iterations() * resource.GetSize());
+}
+
+/// Shares one framework and bundle between all benchmark threads.
+class ConcurrentResourceReadFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State& state)
+  {
+    using namespace cppmicroservices;
+
+    if (state.thread_index == 0) {
+      framework =
+        std::make_shared<Framework>(FrameworkFactory().NewFramework());
+      framework->Start();
+      auto bundle =
+        testing::InstallLib(framework->GetBundleContext(), "TestBundleR");
+      resources.clear();
+      for (auto const& resource : bundle.FindResources("", "*", true)) {
+        if (resource.IsFile()) {
+          resources.push_back(resource);
+        }
+      }
+    }
+  }
+
+  void TearDown(const ::benchmark::State& state)
+  {
+    using namespace std::chrono;
+
+    if (state.thread_index == 0) {
+      resources.clear();
+      framework->Stop();
+      framework->WaitForStop(milliseconds::zero());
+      framework.reset();
+    }
+  }
+
+protected:
+  static std::shared_ptr<cppmicroservices::Framework> framework;
+  static std::vector<cppmicroservices::BundleResource> resources;
+};
+
+std::shared_ptr<cppmicroservices::Framework>
+  ConcurrentResourceReadFixture::framework;
+std::vector<cppmicroservices::BundleResource>
+  ConcurrentResourceReadFixture::resources;
+
+/// Benchmark reading all resources of a single bundle from several
+/// threads at once.
+BENCHMARK_DEFINE_F(ConcurrentResourceReadFixture, ReadResources)
+(benchmark::State& state)
+{
+  int64_t bytes = 0;
+  for (auto _ : state) {
+    for (auto const& resource : resources) {
+      auto data = resource.GetDataView();
+      benchmark::DoNotOptimize(data.get());
+      bytes += resource.GetSize();
+    }
+  }
+  state.SetBytesProcessed(bytes);
+}
+
+class FindResourcesFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State&)
+  {
+    using namespace cppmicroservices;
+
+    framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+    framework->Start();
+    bundle = testing::InstallLib(framework->GetBundleContext(), "largeBundle");
+  }
+
+  void TearDown(const ::benchmark::State&)
+  {
+    using namespace std::chrono;
+
+    bundle = cppmicroservices::Bundle();
+    framework->Stop();
+    framework->WaitForStop(milliseconds::zero());
+  }
+
+  ~FindResourcesFixture() { framework.reset(); }
+
+protected:
+  std::shared_ptr<cppmicroservices::Framework> framework;
+  cppmicroservices::Bundle bundle;
+};
+
+/// Benchmark enumerating all resources of a bundle with many entries.
+BENCHMARK_DEFINE_F(FindResourcesFixture, FindAllResources)
+(benchmark::State& state)
+{
+  std::size_t count = 0;
+  for (auto _ : state) {
+    auto resources = bundle.FindResources("", "*", true);
+    count = resources.size();
+  }
+  state.counters["Resources"] = static_cast<double>(count);
+}
+
+/// Benchmark enumerating the direct children of the bundle root.
+BENCHMARK_DEFINE_F(FindResourcesFixture, FindTopLevelResources)
+(benchmark::State& state)
+{
+  for (auto _ : state) {
+    auto resources = bundle.FindResources("", "*", false);
+    benchmark::DoNotOptimize(resources.data());
+  }
+}
+
+/// Benchmark looking up each resource of a bundle by its path.
+BENCHMARK_DEFINE_F(FindResourcesFixture, GetResourceByPath)
+(benchmark::State& state)
+{
+  std::vector<std::string> paths;
+  for (auto const& resource : bundle.FindResources("", "*", true)) {
+    paths.push_back(resource.GetResourcePath());
+  }
+  for (auto _ : state) {
+    for (auto const& path : paths) {
+      auto resource = bundle.GetResource(path);
+      benchmark::DoNotOptimize(resource.IsValid());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(paths.size()));
+}
+
+BENCHMARK_REGISTER_F(BundleResourceStreamFixture, TimeToFirstByte)
+  ->Arg(0)
+  ->Arg(4096)
+  ->Arg(64 * 1024)
+  ->UseManualTime();
+BENCHMARK_REGISTER_F(BundleResourceStreamFixture, ReadAll)
+  ->Arg(0)
+  ->Arg(4096)
+  ->Arg(64 * 1024)
+  ->UseManualTime();
+BENCHMARK_REGISTER_F(ConcurrentResourceReadFixture, ReadResources)
+  ->ThreadRange(1, 16)
+  ->UseRealTime();
+BENCHMARK_REGISTER_F(FindResourcesFixture, FindAllResources);
+BENCHMARK_REGISTER_F(FindResourcesFixture, FindTopLevelResources);
+BENCHMARK_REGISTER_F(FindResourcesFixture, GetResourceByPath);
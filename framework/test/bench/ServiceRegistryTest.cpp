@@ -1,3 +1,4 @@
+#include "AllocationCounter.h"
 #include "benchmark/benchmark.h"
 #include <cppmicroservices/Bundle.h>
 #include <cppmicroservices/BundleContext.h>
@@ -123,6 +124,42 @@ BENCHMARK_REGISTER_F(ServiceRegistryFixture, RegisterServicesWithRank)
   ->Ranges({ { 1, 1000 }, { 1, 1000 } })
   ->UseManualTime();
 
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, RegisterServiceAllocations)
+(benchmark::State& state)
+{
+  auto fc = framework->GetBundleContext();
+  auto propCount = state.range(0);
+  auto interfaceMap = MakeInterfaceMapWithNInterfaces(1);
+
+  ServiceProperties props;
+  for (auto i = propCount; i > 0; --i) {
+    props.insert(
+      std::make_pair("prop" + std::to_string(i), Any(static_cast<int>(i))));
+  }
+
+  std::vector<ServiceRegistrationBase> regs;
+  std::uint64_t allocations = 0;
+  for (auto _ : state) {
+    InterfaceMapPtr iMapCopy(std::make_shared<InterfaceMap>(*interfaceMap));
+    auto before = benchutil::AllocationCount();
+    regs.push_back(fc.RegisterService(iMapCopy, props));
+    allocations += benchutil::AllocationCount() - before;
+  }
+
+  // heap allocations made by a single call to RegisterService
+  state.counters["allocs"] = benchmark::Counter(
+    static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+
+  for (auto& reg : regs) {
+    reg.Unregister();
+  }
+}
+
+// the parameter specifies the number of user supplied service properties
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, RegisterServiceAllocations)
+  ->RangeMultiplier(4)
+  ->Range(0, 64);
+
 BENCHMARK_DEFINE_F(ServiceRegistryFixture, FindServices)
 (benchmark::State& state)
 {
@@ -0,0 +1,68 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ThreadCounter.h"
+
+#include <atomic>
+
+#if defined(__linux__)
+#  include <dlfcn.h>
+#  include <pthread.h>
+#endif
+
+namespace {
+std::atomic<std::uint64_t> threadCreationCount(0);
+}
+
+namespace benchutil {
+
+bool IsThreadCreationCountSupported()
+{
+#if defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::uint64_t ThreadCreationCount()
+{
+  return threadCreationCount.load(std::memory_order_relaxed);
+}
+}
+
+#if defined(__linux__)
+// Interpose pthread_create for the whole benchmark executable, including
+// the threads created by std::thread in the framework library.
+extern "C" int pthread_create(pthread_t* thread,
+                              const pthread_attr_t* attr,
+                              void* (*start)(void*),
+                              void* arg)
+{
+  using CreateFunction =
+    int (*)(pthread_t*, const pthread_attr_t*, void* (*)(void*), void*);
+  static const auto next =
+    reinterpret_cast<CreateFunction>(dlsym(RTLD_NEXT, "pthread_create"));
+  threadCreationCount.fetch_add(1, std::memory_order_relaxed);
+  return next(thread, attr, start, arg);
+}
+#endif
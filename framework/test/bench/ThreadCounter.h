@@ -0,0 +1,42 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_THREADCOUNTER_H
+#define CPPMICROSERVICES_THREADCOUNTER_H
+
+#include <cstdint>
+
+namespace benchutil {
+
+/**
+ * Returns true if ThreadCreationCount() is supported on this platform.
+ */
+bool IsThreadCreationCountSupported();
+
+/**
+ * Returns the number of threads created by any thread of the benchmark
+ * executable so far, or 0 if this is not supported on this platform.
+ */
+std::uint64_t ThreadCreationCount();
+}
+
+#endif // CPPMICROSERVICES_THREADCOUNTER_H
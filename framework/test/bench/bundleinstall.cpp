@@ -2,12 +2,15 @@
 #include <cppmicroservices/Bundle.h>
 #include <cppmicroservices/BundleContext.h>
 #include <cppmicroservices/BundleEvent.h>
+#include <cppmicroservices/Constants.h>
 #include <cppmicroservices/Framework.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/util/FileSystem.h>
 #include <future>
 
 #include "TestUtils.h"
+#include <TestingConfig.h>
 #include "benchmark/benchmark.h"
 
 class BundleInstallFixture : public ::benchmark::Fixture
@@ -61,6 +64,90 @@ protected:
     framework.WaitForStop(std::chrono::milliseconds::zero());
   }
 
+  void InstallWithFileStorage(benchmark::State& state, bool warm)
+  {
+    using namespace std::chrono;
+    using namespace cppmicroservices;
+
+    const std::vector<std::string> bundleNames = {
+      "largeBundle", "dummyService", "TestBundleA",  "TestBundleA2",
+      "TestBundleH", "TestBundleLQ", "TestBundleM", "TestBundleR"
+    };
+
+    testing::TempDir storageDir;
+    FrameworkConfiguration config{
+      { Constants::FRAMEWORK_STORAGE, storageDir.Path },
+      { Constants::FRAMEWORK_STORAGE_TYPE, Constants::FRAMEWORK_STORAGE_TYPE_FILE }
+    };
+    if (warm) {
+      // Populate the cache file once, outside of the measured region.
+      auto framework = FrameworkFactory().NewFramework(config);
+      framework.Start();
+      for (const auto& name : bundleNames) {
+        testing::InstallLib(framework.GetBundleContext(), name);
+      }
+      framework.Stop();
+      framework.WaitForStop(milliseconds::zero());
+    } else {
+      config[Constants::FRAMEWORK_STORAGE_CLEAN] =
+        Constants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT;
+    }
+
+    for (auto _ : state) {
+      auto framework = FrameworkFactory().NewFramework(config);
+      framework.Start();
+      auto context = framework.GetBundleContext();
+
+      auto start = high_resolution_clock::now();
+      for (const auto& name : bundleNames) {
+        testing::InstallLib(context, name);
+      }
+      auto end = high_resolution_clock::now();
+      auto elapsed = duration_cast<duration<double>>(end - start);
+      state.SetIterationTime(elapsed.count());
+
+      framework.Stop();
+      framework.WaitForStop(milliseconds::zero());
+    }
+  }
+
+  void InstallBundleLibs(benchmark::State& state, int numThreads)
+  {
+    using namespace std::chrono;
+    using namespace cppmicroservices;
+
+    const std::vector<std::string> bundleNames = {
+      "largeBundle",  "dummyService", "TestBundleA",  "TestBundleA2",
+      "TestBundleB",  "TestBundleC1", "TestBundleH",  "TestBundleLQ",
+      "TestBundleM",  "TestBundleR",  "TestBundleRA", "TestBundleRL",
+      "TestBundleS",  "TestBundleSL1", "TestBundleSL3", "TestBundleSL4",
+      "TestBundleU",  "TestBundleBA_00", "TestBundleBA_01", "TestBundleBA_10"
+    };
+    std::vector<std::string> locations;
+    for (const auto& name : bundleNames) {
+      locations.push_back(testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX +
+                          name + US_LIB_POSTFIX + US_LIB_EXT);
+    }
+
+    FrameworkConfiguration config{
+      { Constants::FRAMEWORK_BUNDLE_INSTALL_THREADS, numThreads }
+    };
+    for (auto _ : state) {
+      auto framework = FrameworkFactory().NewFramework(config);
+      framework.Start();
+      auto context = framework.GetBundleContext();
+
+      auto start = high_resolution_clock::now();
+      auto bundles = context.InstallBundles(locations);
+      auto end = high_resolution_clock::now();
+      auto elapsed = duration_cast<duration<double>>(end - start);
+      state.SetIterationTime(elapsed.count());
+
+      framework.Stop();
+      framework.WaitForStop(milliseconds::zero());
+    }
+  }
+
   void InstallConcurrently(benchmark::State& state, uint32_t numThreads)
   {
     using namespace std::chrono;
@@ -133,6 +220,26 @@ BENCHMARK_DEFINE_F(BundleInstallFixture, LargeBundleInstallCppFramework)
   InstallWithCppFramework(state, "largeBundle");
 }
 
+BENCHMARK_DEFINE_F(BundleInstallFixture, FileStorageColdInstall)
+(benchmark::State& state)
+{
+  InstallWithFileStorage(state, false);
+}
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, FileStorageWarmInstall)
+(benchmark::State& state)
+{
+  InstallWithFileStorage(state, true);
+}
+
+#if defined(US_BUILD_SHARED_LIBS)
+BENCHMARK_DEFINE_F(BundleInstallFixture, InstallBundlesParallel)
+(benchmark::State& state)
+{
+  InstallBundleLibs(state, static_cast<int>(state.range(0)));
+}
+#endif
+
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)
 (benchmark::State& state)
@@ -164,6 +271,17 @@ BENCHMARK_REGISTER_F(BundleInstallFixture, BundleInstallCppFramework)
   ->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, LargeBundleInstallCppFramework)
   ->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, FileStorageColdInstall)
+  ->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, FileStorageWarmInstall)
+  ->UseManualTime();
+#if defined(US_BUILD_SHARED_LIBS)
+BENCHMARK_REGISTER_F(BundleInstallFixture, InstallBundlesParallel)
+  ->Arg(1)
+  ->Arg(4)
+  ->Arg(16)
+  ->UseManualTime();
+#endif
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)
   ->UseManualTime();
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Constants.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "TestUtils.h"
+#include "ThreadCounter.h"
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+#if defined(US_BUILD_SHARED_LIBS)
+
+class BundleStartStopFixture : public ::benchmark::Fixture
+{
+public:
+  using benchmark::Fixture::SetUp;
+  using benchmark::Fixture::TearDown;
+
+  void SetUp(const ::benchmark::State& state)
+  {
+    using namespace cppmicroservices;
+
+    const std::vector<std::string> bundleNames = {
+      "dummyService", "TestBundleA",   "TestBundleA2",  "TestBundleH",
+      "TestBundleM",  "TestBundleR",   "TestBundleRA",  "TestBundleRL",
+      "TestBundleS",  "TestBundleSL1", "TestBundleSL3", "TestBundleSL4"
+    };
+
+    FrameworkConfiguration config{
+      { Constants::FRAMEWORK_BUNDLE_THREADS, static_cast<int>(state.range(0)) }
+    };
+    framework = std::make_shared<Framework>(
+      FrameworkFactory().NewFramework(config));
+    framework->Start();
+    bundles.clear();
+    for (const auto& name : bundleNames) {
+      bundles.push_back(
+        testing::InstallLib(framework->GetBundleContext(), name));
+    }
+  }
+
+  void TearDown(const ::benchmark::State&)
+  {
+    using namespace std::chrono;
+
+    bundles.clear();
+    framework->Stop();
+    framework->WaitForStop(milliseconds::zero());
+  }
+
+  ~BundleStartStopFixture() { framework.reset(); }
+
+protected:
+  std::shared_ptr<cppmicroservices::Framework> framework;
+  std::vector<cppmicroservices::Bundle> bundles;
+};
+
+/// Benchmark starting and stopping 500 bundles, one after another, and
+/// report how many threads the framework created for calling the bundle
+/// activators and listeners.
+BENCHMARK_DEFINE_F(BundleStartStopFixture, StartStop500Bundles)
+(benchmark::State& state)
+{
+  using namespace std::chrono;
+
+  const std::size_t operations = 500;
+  std::uint64_t threadsCreated = 0;
+  for (auto _ : state) {
+    auto const threadsBefore = benchutil::ThreadCreationCount();
+    auto start = high_resolution_clock::now();
+    for (std::size_t i = 0; i < operations; ++i) {
+      auto& bundle = bundles[i % bundles.size()];
+      bundle.Start();
+      bundle.Stop();
+    }
+    auto end = high_resolution_clock::now();
+    state.SetIterationTime(duration_cast<duration<double>>(end - start).count());
+    threadsCreated += benchutil::ThreadCreationCount() - threadsBefore;
+  }
+  if (benchutil::IsThreadCreationCountSupported()) {
+    state.counters["ThreadsCreated"] =
+      benchmark::Counter(static_cast<double>(threadsCreated),
+                         benchmark::Counter::kAvgIterations);
+  }
+}
+
+BENCHMARK_REGISTER_F(BundleStartStopFixture, StartStop500Bundles)
+  ->Arg(1)
+  ->Arg(4)
+  ->UseManualTime();
+
+#endif
@@ -0,0 +1,51 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "cppmicroservices/BundleActivator.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/GlobalConfig.h"
+
+#include <chrono>
+#include <thread>
+
+namespace cppmicroservices {
+
+class TestStartDependencyAActivator : public BundleActivator
+{
+public:
+  TestStartDependencyAActivator() {}
+  ~TestStartDependencyAActivator() {}
+
+  void Start(BundleContext)
+  {
+    // Take long enough for a concurrently started dependent
+    // bundle to notice if it was not ordered after this one.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  void Stop(BundleContext) {}
+};
+}
+
+CPPMICROSERVICES_EXPORT_BUNDLE_ACTIVATOR(
+  cppmicroservices::TestStartDependencyAActivator)
@@ -32,6 +32,7 @@
 #include <array>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -1319,6 +1320,163 @@ void testManifestWithNullTerminator(const std::string& rcbinpath,
     0 == nullTerminatorJSON.compare(expectedJSON),
     "Test that the JSON content matches the expected JSON content.");
 }
+
+// Create count text files and one png file in tempdir/many/ and return
+// the --res-add arguments for them, relative to tempdir.
+std::string createManyResources(const std::string& tempdir, int count)
+{
+  MakePath(tempdir + "many");
+  std::ostringstream args;
+  for (int i = 0; i < count; ++i) {
+    std::string name("many/res" + std::to_string(i) + ".txt");
+    std::ofstream file(tempdir + name);
+    for (int j = 0; j < 100; ++j) {
+      file << "Resource " << i << " compresses well, line " << j << "\n";
+    }
+    args << " --res-add " << name;
+  }
+  std::ofstream png(tempdir + "many/image.png", std::ios::binary);
+  for (int j = 0; j < 1000; ++j) {
+    png << "not really a png " << j;
+  }
+  args << " --res-add many/image.png";
+  return args.str();
+}
+
+// Return the entry with the given name, or an entry with an empty name.
+EntryInfo findEntry(const ZipFile& zip, const std::string& name)
+{
+  for (ZipFile::size_type i = 0; i < zip.size(); ++i) {
+    if (zip[i].name == name) {
+      return zip[i];
+    }
+  }
+  return EntryInfo();
+}
+
+/*
+ * Compress resources on multiple threads and check that the result matches
+ * the archive created on a single thread. Then modify one resource and
+ * update the archive incrementally.
+ */
+void testParallelAndIncrementalResAdd(const std::string& rcbinpath,
+                                      const std::string& tempdir)
+{
+  const int count = 40;
+  auto resArgs = createManyResources(tempdir, count);
+
+  auto origdir = util::GetCurrentWorkingDirectory();
+  testing::ChangeDirectory(tempdir);
+
+  std::ostringstream cmd;
+  cmd << rcbinpath << " --bundle-name mybundle --out-file single.zip --jobs 1"
+      << resArgs;
+  US_TEST_CONDITION_REQUIRED(EXIT_SUCCESS == runExecutable(cmd.str()),
+                             "Compress resources on a single thread");
+
+  cmd.str("");
+  cmd << rcbinpath << " --bundle-name mybundle --out-file parallel.zip"
+      << " --jobs 4" << resArgs;
+  US_TEST_CONDITION_REQUIRED(EXIT_SUCCESS == runExecutable(cmd.str()),
+                             "Compress resources on multiple threads");
+
+  ZipFile single("single.zip");
+  ZipFile parallel("parallel.zip");
+  // count + 1 files, the bundle directory and the many/ directory
+  US_TEST_CONDITION_REQUIRED(parallel.size() == count + 3,
+                             "Check number of entries of zip.");
+  US_TEST_CONDITION_REQUIRED(single.size() == parallel.size(),
+                             "Check number of entries of zip.");
+  bool sameEntries = true;
+  for (ZipFile::size_type i = 0; i < parallel.size(); ++i) {
+    sameEntries = sameEntries && single[i].name == parallel[i].name &&
+                  single[i].crc32 == parallel[i].crc32 &&
+                  single[i].compressedSize == parallel[i].compressedSize;
+  }
+  US_TEST_CONDITION(sameEntries,
+                    "Entries are independent of the number of threads");
+
+  auto txt = findEntry(parallel, "mybundle/many/res0.txt");
+  US_TEST_CONDITION(txt.compressedSize < txt.uncompressedSize,
+                    "Text resources are compressed");
+  auto png = findEntry(parallel, "mybundle/many/image.png");
+  US_TEST_CONDITION(png.compressedSize < png.uncompressedSize,
+                    "png resources are compressed by default");
+
+  {
+    std::ofstream file("many/res1.txt", std::ios::app);
+    file << "changed\n";
+  }
+
+  cmd.str("");
+  cmd << rcbinpath << " --verbose --bundle-name mybundle"
+      << " --out-file parallel.zip --incremental" << resArgs
+      << " > incremental.log 2>&1";
+  US_TEST_CONDITION_REQUIRED(EXIT_SUCCESS == runExecutable(cmd.str()),
+                             "Update resources incrementally");
+
+  std::ifstream logFile("incremental.log");
+  std::string log((std::istreambuf_iterator<char>(logFile)),
+                  std::istreambuf_iterator<char>());
+  logFile.close();
+  US_TEST_CONDITION(log.find("reusing mybundle/many/res0.txt") !=
+                      std::string::npos,
+                    "Unchanged resources are reused");
+  US_TEST_CONDITION(log.find("reusing mybundle/many/res1.txt") ==
+                      std::string::npos,
+                    "Changed resources are compressed again");
+
+  ZipFile incremental("parallel.zip");
+  US_TEST_CONDITION_REQUIRED(incremental.size() == parallel.size(),
+                             "Check number of entries of zip.");
+  US_TEST_CONDITION(findEntry(incremental, "mybundle/many/res0.txt").crc32 ==
+                      txt.crc32,
+                    "Unchanged resource has the same content");
+  auto changed = findEntry(incremental, "mybundle/many/res1.txt");
+  US_TEST_CONDITION(changed.crc32 !=
+                        findEntry(parallel, "mybundle/many/res1.txt").crc32 &&
+                      changed.compressedSize < changed.uncompressedSize,
+                    "Changed resource has the new content");
+
+  cmd.str("");
+  cmd << rcbinpath << " --verbose --bundle-name mybundle"
+      << " --out-file parallel.zip --incremental --compression-level 9"
+      << resArgs << " > incremental.log 2>&1";
+  US_TEST_CONDITION_REQUIRED(EXIT_SUCCESS == runExecutable(cmd.str()),
+                             "Update resources with a new compression level");
+  logFile.open("incremental.log");
+  log.assign((std::istreambuf_iterator<char>(logFile)),
+             std::istreambuf_iterator<char>());
+  logFile.close();
+  US_TEST_CONDITION(log.find("reusing") == std::string::npos,
+                    "Resources are compressed again for a new level");
+
+  cmd.str("");
+  cmd << rcbinpath << " --bundle-name mybundle --out-file stored.zip"
+      << " --store-ext txt" << resArgs;
+  US_TEST_CONDITION_REQUIRED(EXIT_SUCCESS == runExecutable(cmd.str()),
+                             "Store resources by extension");
+  ZipFile stored("stored.zip");
+  txt = findEntry(stored, "mybundle/many/res0.txt");
+  US_TEST_CONDITION(txt.compressedSize == txt.uncompressedSize,
+                    "Resources with a --store-ext extension are stored");
+
+  cmd.str("");
+  cmd << rcbinpath << " --bundle-name mybundle --out-file stored.zip"
+      << " --store-ext compressed" << resArgs;
+  US_TEST_CONDITION_REQUIRED(EXIT_SUCCESS == runExecutable(cmd.str()),
+                             "Store compressed formats");
+  ZipFile storedFormats("stored.zip");
+  png = findEntry(storedFormats, "mybundle/many/image.png");
+  US_TEST_CONDITION(png.uncompressedSize > 0 &&
+                      png.compressedSize == png.uncompressedSize,
+                    "png resources are stored with --store-ext compressed");
+  txt = findEntry(storedFormats, "mybundle/many/res0.txt");
+  US_TEST_CONDITION(txt.compressedSize < txt.uncompressedSize,
+                    "Text resources are still compressed");
+
+  testing::ChangeDirectory(origdir);
+}
 }
 
 int ResourceCompilerTest(int /*argc*/, char* /*argv*/ [])
@@ -1391,5 +1549,7 @@ int ResourceCompilerTest(int /*argc*/, char* /*argv*/ [])
 
   US_TEST_NO_EXCEPTION(testManifestWithNullTerminator(rcbinpath, tempdir));
 
+  US_TEST_NO_EXCEPTION(testParallelAndIncrementalResAdd(rcbinpath, tempdir));
+
   US_TEST_END()
 }
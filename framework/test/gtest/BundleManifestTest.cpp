@@ -25,6 +25,7 @@
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleResource.h"
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
@@ -191,3 +192,57 @@ TEST(BundleManifestTest, ParseManifest)
   framework.Stop();
   framework.WaitForStop(std::chrono::milliseconds::zero());
 }
+
+TEST(BundleManifestTest, ParseBinaryManifest)
+{
+  auto framework = FrameworkFactory().NewFramework();
+  framework.Start();
+
+  auto bundle = cppmicroservices::testing::InstallLib(
+    framework.GetBundleContext(), "TestBundleMWithBinaryManifest");
+  ASSERT_TRUE(bundle) << "Failed to install TestBundleMWithBinaryManifest";
+
+  // The resource compiler adds the compiled manifest next to manifest.json
+  auto binaryManifest = bundle.GetResource("manifest.bin");
+  ASSERT_TRUE(binaryManifest.IsValid());
+  EXPECT_GT(binaryManifest.GetSize(), 0);
+  EXPECT_TRUE(bundle.GetResource("manifest.json").IsValid());
+
+  // The headers must be the same as if manifest.json had been parsed.
+  const auto& headers = bundle.GetHeaders();
+  EXPECT_THAT(headers.at(Constants::BUNDLE_SYMBOLICNAME).ToString(),
+              ::testing::StrEq("TestBundleMWithBinaryManifest"));
+  EXPECT_THAT(headers.at(Constants::BUNDLE_DESCRIPTION).ToString(),
+              ::testing::StrEq("My Bundle description"));
+  EXPECT_EQ(bundle.GetVersion(), BundleVersion(1, 0, 0));
+  EXPECT_EQ(any_cast<bool>(headers.at(Constants::BUNDLE_ACTIVATOR)), true);
+  EXPECT_EQ(any_cast<int>(headers.at("number")), 5);
+  EXPECT_EQ(any_cast<double>(headers.at("double")), 1.1);
+  EXPECT_EQ(headers.count("large_number"), 0ul);
+  EXPECT_EQ(headers.count("nothing"), 0ul);
+  EXPECT_EQ(headers.count("NUMBER"), 1ul) << "Keys must be case-insensitive";
+
+  auto vec = any_cast<std::vector<Any>>(headers.at("vector"));
+  ASSERT_EQ(vec.size(), 3ul);
+  EXPECT_THAT(vec[0].ToString(), ::testing::StrEq("first"));
+  EXPECT_EQ(any_cast<int>(vec[1]), 2);
+  ASSERT_EQ(vec[2].Type(), typeid(AnyMap));
+  EXPECT_THAT(ref_any_cast<AnyMap>(vec[2]).at("key").ToString(),
+              ::testing::StrEq("value"));
+
+  auto m = any_cast<AnyMap>(headers.at("map"));
+  ASSERT_EQ(m.size(), 4ul);
+  EXPECT_THAT(m.at("string").ToString(), ::testing::StrEq("hi"));
+  EXPECT_EQ(any_cast<int>(m.at("number")), 4);
+  EXPECT_EQ(any_cast<std::vector<Any>>(m.at("list")).size(), 2ul);
+  ASSERT_EQ(m.at("nested").Type(), typeid(AnyMap));
+  EXPECT_EQ(any_cast<bool>(ref_any_cast<AnyMap>(m.at("nested")).at("FLAG")),
+            false);
+
+  auto deprecatedProperties = bundle.GetProperties();
+  ASSERT_TRUE(compare_deprecated_properties(headers, deprecatedProperties))
+    << "Deprecated properties mismatch";
+
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+}
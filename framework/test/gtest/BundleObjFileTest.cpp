@@ -32,6 +32,17 @@
 
 #include "gtest/gtest.h"
 
+#if defined (US_PLATFORM_LINUX)
+#  include <elf.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <vector>
+
 namespace {
 #if defined (US_BUILD_SHARED_LIBS)
 const std::string testBundlePath = cppmicroservices::testing::LIB_PATH
@@ -114,5 +125,94 @@ TEST(BundleObjFile, MappedFile)
       ASSERT_EQ(mappedBundleFile.GetSize(), 0u);
   });
 }
+
+TEST(BundleObjFile, MappedFileView)
+{
+  cppmicroservices::MappedFile mappedBundleFile(testBundlePath);
+  ASSERT_TRUE(mappedBundleFile.GetData());
+  auto const size = mappedBundleFile.GetSize();
+  ASSERT_GT(size, 4u);
+
+  EXPECT_EQ(mappedBundleFile.GetView<char>(0, size),
+            mappedBundleFile.GetData());
+  EXPECT_TRUE(mappedBundleFile.GetView<char>(size, 0));
+  EXPECT_TRUE(mappedBundleFile.GetView<uint32_t>(0));
+
+  // Views must lie completely within the file and be aligned.
+  EXPECT_FALSE(mappedBundleFile.GetView<char>(0, size + 1));
+  EXPECT_FALSE(mappedBundleFile.GetView<char>(size + 1, 0));
+  EXPECT_FALSE(mappedBundleFile.GetView<char>(1, UINT64_MAX));
+  EXPECT_FALSE(mappedBundleFile.GetView<uint32_t>(size - 2));
+  EXPECT_FALSE(mappedBundleFile.GetView<uint32_t>(1));
+
+  cppmicroservices::MappedFile bogusFile("/does/not/exist/bogus.bundle");
+  EXPECT_EQ(bogusFile.GetData(), nullptr);
+  EXPECT_FALSE(bogusFile.GetView<char>(0, 0));
+}
 #endif // defined (US_PLATFORM_APPLE) || defined (US_PLATFORM_POSIX)
+
+#if defined (US_PLATFORM_LINUX)
+namespace {
+
+// Writes a copy of the test bundle to a temporary file after letting
+// corrupt modify its ELF header and contents.
+std::string WriteCorruptedElfFile(
+  const std::function<void(Elf64_Ehdr&, std::vector<char>&)>& corrupt)
+{
+  std::ifstream in(testBundlePath, std::ios::binary);
+  std::vector<char> content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+  EXPECT_GE(content.size(), sizeof(Elf64_Ehdr));
+  EXPECT_EQ(content[EI_CLASS], ELFCLASS64);
+
+  Elf64_Ehdr header;
+  std::memcpy(&header, content.data(), sizeof header);
+  corrupt(header, content);
+  std::memcpy(content.data(), &header, sizeof header);
+
+  auto tempFile = cppmicroservices::testing::MakeUniqueTempFile(
+    cppmicroservices::testing::GetTempDirectory());
+  std::ofstream out(tempFile.Path, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  out.close();
+  return tempFile.Path;
+}
+
+}
+
+TEST(BundleObjFile, ElfTruncatedSectionHeaders)
+{
+  auto path = WriteCorruptedElfFile([](Elf64_Ehdr& header,
+                                       std::vector<char>& content) {
+    // cut the file in the middle of the section header table
+    content.resize(header.e_shoff +
+                   header.e_shentsize * (header.e_shnum / 2));
+  });
+  EXPECT_THROW(cppmicroservices::BundleObjFactory().CreateBundleFileObj(path),
+               cppmicroservices::InvalidObjFileException);
+  std::remove(path.c_str());
+}
+
+TEST(BundleObjFile, ElfBogusSectionHeaderOffset)
+{
+  auto path = WriteCorruptedElfFile([](Elf64_Ehdr& header,
+                                       std::vector<char>&) {
+    header.e_shoff = UINT64_MAX - 1;
+  });
+  EXPECT_THROW(cppmicroservices::BundleObjFactory().CreateBundleFileObj(path),
+               cppmicroservices::InvalidObjFileException);
+  std::remove(path.c_str());
+}
+
+TEST(BundleObjFile, ElfBogusSectionHeaderSize)
+{
+  auto path = WriteCorruptedElfFile([](Elf64_Ehdr& header,
+                                       std::vector<char>&) {
+    header.e_shentsize = sizeof(Elf64_Shdr) / 2;
+  });
+  EXPECT_THROW(cppmicroservices::BundleObjFactory().CreateBundleFileObj(path),
+               cppmicroservices::InvalidObjFileException);
+  std::remove(path.c_str());
+}
+#endif // defined (US_PLATFORM_LINUX)
 #endif // defined (US_BUILD_SHARED_LIBS)
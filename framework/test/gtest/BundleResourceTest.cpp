@@ -23,12 +23,23 @@ limitations under the License.
 #include "TestUtils.h"
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleResource.h"
+#include "cppmicroservices/BundleResourceStream.h"
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/detail/BundleResourceBuffer.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace cppmicroservices;
 
 class BundleResourceTest : public ::testing::Test
@@ -75,3 +86,312 @@ TEST_F(BundleResourceTest, getChildResources)
   // Confirm that GetChildResources() returns the correct number
   ASSERT_EQ(resource.GetChildResources().size(), static_cast<unsigned int>(3));
 }
+
+namespace {
+std::string ParentPath(const BundleResource& resource)
+{
+  auto const path = resource.GetResourcePath();
+  return path.substr(0, path.rfind('/', path.size() - 2) + 1);
+}
+}
+
+TEST_F(BundleResourceTest, lookupAndEnumerationAgree)
+{
+  // Every resource found by enumeration can be looked up by its path, and
+  // the children of a directory are exactly the entries directly below it.
+  auto resources = bundleR.FindResources("", "*", true);
+  ASSERT_FALSE(resources.empty());
+  for (auto const& resource : resources) {
+    auto found = bundleR.GetResource(resource.GetResourcePath());
+    ASSERT_TRUE(found.IsValid()) << resource.GetResourcePath();
+    EXPECT_EQ(found, resource);
+    for (auto const& child : found.GetChildResources()) {
+      EXPECT_EQ(ParentPath(child), resource.GetResourcePath());
+    }
+  }
+
+  auto topLevel = bundleR.FindResources("", "*", false);
+  EXPECT_LT(topLevel.size(), resources.size());
+  for (auto const& resource : topLevel) {
+    EXPECT_EQ(ParentPath(resource), "/");
+  }
+
+  // Lookup ignores the case of entry names, but not partial names.
+  auto upperCase = bundleR.GetResource("ICONS/compressable.bmp");
+  ASSERT_TRUE(upperCase.IsValid());
+  EXPECT_EQ(upperCase.GetSize(),
+            bundleR.GetResource("icons/compressable.bmp").GetSize());
+  EXPECT_FALSE(bundleR.GetResource("icons/compressable").IsValid());
+}
+
+namespace {
+std::string ReadAll(const BundleResource& resource)
+{
+  BundleResourceStream rs(resource, std::ios_base::binary);
+  return std::string(std::istreambuf_iterator<char>(rs), {});
+}
+}
+
+TEST_F(BundleResourceTest, getDataViewOfCompressedResource)
+{
+  BundleResource resource = bundleR.GetResource("icons/compressable.bmp");
+  ASSERT_TRUE(resource);
+  ASSERT_LT(resource.GetCompressedSize(), resource.GetSize());
+
+  auto view = resource.GetDataView();
+  ASSERT_TRUE(view);
+  EXPECT_EQ(std::string(static_cast<const char*>(view.get()),
+                        resource.GetSize()),
+            ReadAll(resource));
+
+  // Compressed data is uncompressed into a new buffer for each call.
+  EXPECT_NE(resource.GetDataView().get(), view.get());
+}
+
+TEST_F(BundleResourceTest, getDataViewOfStoredResource)
+{
+  auto bundleRS =
+    cppmicroservices::testing::InstallLib(f.GetBundleContext(), "TestBundleRS");
+  ASSERT_TRUE(bundleRS);
+
+  for (auto const& path : { "foo.txt", "test.xml", "manifest.json" }) {
+    BundleResource resource = bundleRS.GetResource(path);
+    ASSERT_TRUE(resource) << path;
+    EXPECT_EQ(resource.GetCompressedSize(), resource.GetSize()) << path;
+
+    auto view = resource.GetDataView();
+    ASSERT_TRUE(view) << path;
+    EXPECT_EQ(std::string(static_cast<const char*>(view.get()),
+                          resource.GetSize()),
+              ReadAll(resource))
+      << path;
+
+    // Stored data is not copied, all views refer to the mapped archive.
+    EXPECT_EQ(resource.GetDataView().get(), view.get()) << path;
+  }
+
+  EXPECT_FALSE(BundleResource().GetDataView());
+}
+
+namespace {
+std::string ReadAll(const BundleResource& resource,
+                    std::ios_base::openmode mode,
+                    std::size_t windowSize)
+{
+  BundleResourceStream rs(resource, mode, windowSize);
+  return std::string(std::istreambuf_iterator<char>(rs), {});
+}
+}
+
+TEST_F(BundleResourceTest, incrementalStream)
+{
+  for (auto const& path : { "icons/compressable.bmp",
+                            "icons/cppmicroservices.png",
+                            "foo.txt",
+                            "test.xml" }) {
+    BundleResource resource = bundleR.GetResource(path);
+    ASSERT_TRUE(resource) << path;
+
+    BundleResourceStream rs(resource, std::ios_base::binary);
+    std::string binary(std::istreambuf_iterator<char>(rs), {});
+    EXPECT_EQ(ReadAll(resource, std::ios_base::binary, 97), binary) << path;
+    EXPECT_EQ(ReadAll(resource, std::ios_base::binary, 4096), binary) << path;
+
+    BundleResourceStream textRs(resource);
+    std::string text(std::istreambuf_iterator<char>(textRs), {});
+    EXPECT_EQ(ReadAll(resource, std::ios_base::in, 3), text) << path;
+  }
+
+  auto bundleRS = cppmicroservices::testing::InstallLib(f.GetBundleContext(),
+                                                        "TestBundleRS");
+  ASSERT_TRUE(bundleRS);
+  BundleResource stored = bundleRS.GetResource("test.xml");
+  ASSERT_TRUE(stored);
+  EXPECT_EQ(ReadAll(stored, std::ios_base::binary, 5), ReadAll(stored));
+}
+
+TEST_F(BundleResourceTest, incrementalStreamSeek)
+{
+  BundleResource resource = bundleR.GetResource("icons/compressable.bmp");
+  ASSERT_TRUE(resource);
+  auto const data = ReadAll(resource);
+  ASSERT_GT(data.size(), 4096u);
+
+  BundleResourceStream rs(resource, std::ios_base::binary, 1024);
+  char c = 0;
+
+  // Seeking forward skips over several windows.
+  rs.seekg(3000);
+  ASSERT_TRUE(rs.get(c));
+  EXPECT_EQ(c, data[3000]);
+  EXPECT_EQ(rs.tellg(), std::streampos(3001));
+
+  // Seeking backwards within the current window succeeds.
+  rs.seekg(-2, std::ios_base::cur);
+  ASSERT_TRUE(rs.get(c));
+  EXPECT_EQ(c, data[2999]);
+
+  rs.seekg(-1, std::ios_base::end);
+  ASSERT_TRUE(rs.get(c));
+  EXPECT_EQ(c, data.back());
+  EXPECT_FALSE(rs.get(c));
+
+  // Data before the current window has been discarded.
+  rs.clear();
+  rs.seekg(0);
+  EXPECT_TRUE(rs.fail());
+}
+
+TEST(BundleResourceBufferTest, truncatedData)
+{
+  // The reader ends after 10 of the announced 100 bytes.
+  const std::string data(10, 'x');
+  std::size_t pos = 0;
+  auto read = [&data, &pos](char* buffer, std::size_t size) {
+    auto n = (std::min)(size, data.size() - pos);
+    std::memcpy(buffer, data.data() + pos, n);
+    pos += n;
+    return n;
+  };
+
+  {
+    detail::BundleResourceBuffer buffer(read, 100, 4, std::ios_base::binary);
+    std::istream is(&buffer);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(is), {}), data);
+  }
+
+  pos = 0;
+  {
+    detail::BundleResourceBuffer buffer(read, 100, 4, std::ios_base::in);
+    std::istream is(&buffer);
+    is.seekg(0, std::ios_base::end);
+    EXPECT_EQ(is.tellg(), std::streampos(10));
+  }
+
+  pos = 0;
+  {
+    detail::BundleResourceBuffer buffer(read, 100, 4, std::ios_base::binary);
+    std::istream is(&buffer);
+    is.seekg(50);
+    EXPECT_TRUE(is.fail());
+  }
+}
+
+TEST(BundleResourceBufferTest, unavailableData)
+{
+  detail::BundleResourceBuffer buffer(
+    detail::BundleResourceBuffer::ReadFunction(), 100, 4, std::ios_base::in);
+  std::istream is(&buffer);
+  EXPECT_EQ(is.get(), std::char_traits<char>::eof());
+  EXPECT_TRUE(is.eof());
+}
+
+TEST_F(BundleResourceTest, concurrentReads)
+{
+  // TestBundleRA has its resources appended to the shared library,
+  // which are read from the file instead of memory.
+  auto bundleRA = cppmicroservices::testing::InstallLib(f.GetBundleContext(),
+                                                        "TestBundleRA");
+  ASSERT_TRUE(bundleRA);
+
+  std::vector<BundleResource> resources;
+  std::vector<std::string> expected;
+  for (auto const& bundle : { bundleR, bundleRA }) {
+    for (auto const& resource : bundle.FindResources("", "*", true)) {
+      if (resource.IsFile()) {
+        resources.push_back(resource);
+        expected.push_back(ReadAll(resource));
+      }
+    }
+  }
+  ASSERT_FALSE(resources.empty());
+
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&resources, &expected, &mismatches]() {
+      for (int i = 0; i < 3; ++i) {
+        for (std::size_t r = 0; r < resources.size(); ++r) {
+          auto view = resources[r].GetDataView();
+          if (!view ||
+              expected[r].compare(0,
+                                  std::string::npos,
+                                  static_cast<const char*>(view.get()),
+                                  resources[r].GetSize()) != 0 ||
+              ReadAll(resources[r], std::ios_base::binary, 4096) !=
+                expected[r]) {
+            ++mismatches;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(BundleResourceCacheTest, cachesDecompressedData)
+{
+  // Only one of the two resources used below fits into the cache.
+  const int bmpSize = 300122;
+  const int capacity = bmpSize + 16;
+  FrameworkConfiguration config{ { Constants::FRAMEWORK_RESOURCE_CACHE_SIZE,
+                                   capacity } };
+  auto f = FrameworkFactory().NewFramework(config);
+  f.Start();
+  auto bundleR =
+    cppmicroservices::testing::InstallLib(f.GetBundleContext(), "TestBundleR");
+  auto bmp = bundleR.GetResource("icons/compressable.bmp");
+  auto xml = bundleR.GetResource("test.xml");
+  ASSERT_EQ(bmp.GetSize(), bmpSize);
+  ASSERT_LT(bmp.GetCompressedSize(), bmp.GetSize());
+  ASSERT_GT(xml.GetSize(), 16);
+
+  // Installing bundles may have read resources already.
+  auto bmpData = bmp.GetDataView();
+  auto before = f.GetResourceCacheStatistics();
+  EXPECT_EQ(before.capacity, static_cast<std::size_t>(capacity));
+  EXPECT_EQ(before.size, static_cast<std::size_t>(bmpSize));
+
+  EXPECT_EQ(bmp.GetDataView(), bmpData);
+  EXPECT_EQ(ReadAll(bmp).size(), static_cast<std::size_t>(bmpSize));
+  auto stats = f.GetResourceCacheStatistics();
+  EXPECT_EQ(stats.hits - before.hits, 2u);
+  EXPECT_EQ(stats.misses, before.misses);
+
+  // Evicting the data does not invalidate readers of the evicted data.
+  auto xmlData = xml.GetDataView();
+  stats = f.GetResourceCacheStatistics();
+  EXPECT_EQ(stats.misses - before.misses, 1u);
+  EXPECT_EQ(stats.evictions - before.evictions, 1u);
+  EXPECT_EQ(stats.size, static_cast<std::size_t>(xml.GetSize()));
+  EXPECT_EQ(std::string(static_cast<const char*>(bmpData.get()), bmpSize),
+            ReadAll(bmp));
+  EXPECT_EQ(f.GetResourceCacheStatistics().misses - before.misses, 2u);
+
+  // Uninstalling a bundle removes its data from the cache.
+  bundleR.Uninstall();
+  EXPECT_EQ(f.GetResourceCacheStatistics().size, 0u);
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(BundleResourceCacheTest, disabledByDefault)
+{
+  auto f = FrameworkFactory().NewFramework();
+  f.Start();
+  auto bundleR =
+    cppmicroservices::testing::InstallLib(f.GetBundleContext(), "TestBundleR");
+  auto bmp = bundleR.GetResource("icons/compressable.bmp");
+  EXPECT_NE(bmp.GetDataView(), bmp.GetDataView());
+
+  auto stats = f.GetResourceCacheStatistics();
+  EXPECT_EQ(stats.capacity, 0u);
+  EXPECT_EQ(stats.hits + stats.misses, 0u);
+
+  f.Stop();
+  f.WaitForStop(std::chrono::milliseconds::zero());
+}
@@ -0,0 +1,178 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/BundleStartResult.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "TestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS) && defined(US_ENABLE_THREADING_SUPPORT)
+
+namespace {
+
+const int poolSize = 2;
+
+class BundleThreadTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FrameworkConfiguration config{
+      { Constants::FRAMEWORK_BUNDLE_THREADS, poolSize },
+      { Constants::FRAMEWORK_BUNDLE_START_THREADS, 8 }
+    };
+    framework = FrameworkFactory().NewFramework(config);
+    framework.Start();
+    context = framework.GetBundleContext();
+  }
+
+  void TearDown() override
+  {
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  Bundle Install(const std::string& name)
+  {
+    auto bundle = cppmicroservices::testing::InstallLib(context, name);
+    EXPECT_TRUE(bundle) << "Cannot install " << name;
+    return bundle;
+  }
+
+  Framework framework{ FrameworkFactory().NewFramework() };
+  BundleContext context;
+};
+
+#if defined(__linux__)
+/// Returns the number of threads of this process.
+int CountThreads()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 8, "Threads:") == 0) {
+      return std::stoi(line.substr(8));
+    }
+  }
+  return 0;
+}
+
+/// Waits until at most maxThreads threads are left, surplus bundle
+/// threads exit asynchronously.
+int WaitForThreadCount(int maxThreads)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  int threads = CountThreads();
+  while (threads > maxThreads && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    threads = CountThreads();
+  }
+  return threads;
+}
+#endif
+}
+
+TEST_F(BundleThreadTest, ReusesThreadsAcrossStartAndStop)
+{
+  auto bundle = Install("TestBundleA");
+
+  // Bundle listeners are called on the bundle thread which stops the bundle.
+  std::mutex mutex;
+  std::set<std::thread::id> threadIds;
+  auto token = context.AddBundleListener([&](const BundleEvent& event) {
+    if (event.GetType() == BundleEvent::BUNDLE_STOPPED) {
+      std::lock_guard<std::mutex> lock(mutex);
+      threadIds.insert(std::this_thread::get_id());
+    }
+  });
+
+  bundle.Start();
+  bundle.Stop();
+#if defined(__linux__)
+  auto threads = CountThreads();
+#endif
+  for (int i = 0; i < 10; ++i) {
+    bundle.Start();
+    bundle.Stop();
+  }
+
+  context.RemoveListener(std::move(token));
+  EXPECT_EQ(threadIds.size(), 1u);
+  EXPECT_NE(*threadIds.begin(), std::this_thread::get_id());
+#if defined(__linux__)
+  EXPECT_EQ(CountThreads(), threads);
+#endif
+}
+
+#if defined(__linux__)
+TEST_F(BundleThreadTest, PoolDoesNotGrowBeyondPoolSize)
+{
+  const std::vector<std::string> names = { "TestBundleA",
+                                           "TestBundleA2",
+                                           "TestBundleLQ",
+                                           "TestBundleH",
+                                           "TestBundleM",
+                                           "TestStartDependencyA" };
+  std::vector<Bundle> bundles;
+  for (auto const& name : names) {
+    bundles.push_back(Install(name));
+  }
+
+  // Idle bundle threads left over from installing are part of the
+  // baseline, which only makes the bound below looser.
+  auto const threads = CountThreads();
+
+  for (int i = 0; i < 5; ++i) {
+    // Start the bundles concurrently, which needs more than
+    // poolSize bundle threads at the same time.
+    for (auto const& result : context.StartBundles(bundles)) {
+      EXPECT_FALSE(result.exception) << result.bundle.GetSymbolicName();
+    }
+    EXPECT_LE(WaitForThreadCount(threads + poolSize), threads + poolSize);
+
+    for (auto& bundle : bundles) {
+      bundle.Stop();
+    }
+    EXPECT_LE(WaitForThreadCount(threads + poolSize), threads + poolSize);
+  }
+}
+#endif
+
+#endif
@@ -22,15 +22,21 @@ limitations under the License.
 
 #include <chrono>
 #include <fstream>
+#include <iterator>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "TestUtilBundleListener.h"
 #include "TestUtils.h"
+#include "TestingConfig.h"
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/BundleResource.h"
+#include "cppmicroservices/BundleResourceStream.h"
 #include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
@@ -38,6 +44,12 @@ limitations under the License.
 #include "cppmicroservices/util/FileSystem.h"
 #include "gtest/gtest.h"
 
+#if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
+#  include <dlfcn.h>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#endif
+
 using namespace cppmicroservices;
 using cppmicroservices::testing::File;
 using cppmicroservices::testing::GetTempDirectory;
@@ -293,6 +305,238 @@ TEST(FrameworkTest, TempDataDirIsNotCreatedWhenFrameworkStarts)
   framework.WaitForStop(std::chrono::milliseconds::zero());
 }
 
+#if defined(US_BUILD_SHARED_LIBS)
+TEST(FrameworkTest, FileStorageWarmRestart)
+{
+  TempDir frameworkStorage = MakeUniqueTempDirectory();
+  FrameworkConfiguration frameworkConfig;
+  frameworkConfig[Constants::FRAMEWORK_STORAGE] =
+    static_cast<std::string>(frameworkStorage);
+  frameworkConfig[Constants::FRAMEWORK_STORAGE_TYPE] =
+    Constants::FRAMEWORK_STORAGE_TYPE_FILE;
+  const std::string cacheFile = static_cast<std::string>(frameworkStorage) +
+                                util::DIR_SEP + "bundles" + util::DIR_SEP +
+                                "bundles.cache";
+
+  AnyMap coldHeaders(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+  std::size_t coldResourceCount = 0;
+  {
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start());
+    auto bundle = cppmicroservices::testing::InstallLib(
+      framework.GetBundleContext(), "TestBundleR");
+    ASSERT_TRUE(bundle);
+    coldHeaders = bundle.GetHeaders();
+    coldResourceCount = bundle.FindResources("", "*", true).size();
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+  ASSERT_TRUE(util::Exists(cacheFile))
+    << "Stopping the framework should write the bundle cache file";
+
+  // The second framework instance installs the bundle from the cache.
+  auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+  ASSERT_NO_THROW(framework.Start());
+  auto bundle = cppmicroservices::testing::InstallLib(
+    framework.GetBundleContext(), "TestBundleR");
+  ASSERT_TRUE(bundle);
+  ASSERT_EQ(bundle.GetSymbolicName(), "TestBundleR");
+  ASSERT_EQ(bundle.GetHeaders().size(), coldHeaders.size());
+  for (const auto& header : coldHeaders) {
+    ASSERT_EQ(bundle.GetHeaders().at(header.first).ToJSON(),
+              header.second.ToJSON());
+  }
+
+  auto resource = bundle.GetResource("foo.txt");
+  ASSERT_TRUE(resource.IsValid());
+  BundleResourceStream rs(resource);
+  std::string content((std::istreambuf_iterator<char>(rs)),
+                      std::istreambuf_iterator<char>());
+  ASSERT_FALSE(content.empty());
+  ASSERT_EQ(bundle.FindResources("", "*", true).size(), coldResourceCount);
+
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(FrameworkTest, FileStoragePrunesUnusedRecords)
+{
+  TempDir frameworkStorage = MakeUniqueTempDirectory();
+  FrameworkConfiguration frameworkConfig;
+  frameworkConfig[Constants::FRAMEWORK_STORAGE] =
+    static_cast<std::string>(frameworkStorage);
+  frameworkConfig[Constants::FRAMEWORK_STORAGE_TYPE] =
+    Constants::FRAMEWORK_STORAGE_TYPE_FILE;
+  const std::string cacheFile = static_cast<std::string>(frameworkStorage) +
+                                util::DIR_SEP + "bundles" + util::DIR_SEP +
+                                "bundles.cache";
+  auto getCacheSize = [&cacheFile]() {
+    int64_t lastModified = 0;
+    uint64_t size = 0;
+    EXPECT_TRUE(util::GetFileStatus(cacheFile, lastModified, size));
+    return size;
+  };
+  auto run = [&frameworkConfig](const std::vector<std::string>& names) {
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start());
+    for (auto const& name : names) {
+      ASSERT_TRUE(cppmicroservices::testing::InstallLib(
+        framework.GetBundleContext(), name));
+    }
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  };
+
+  run({ "TestBundleA", "TestBundleR" });
+  const auto bothSize = getCacheSize();
+  // a warm launch of the same bundles keeps all records
+  run({ "TestBundleA", "TestBundleR" });
+  EXPECT_EQ(getCacheSize(), bothSize);
+  // the record of the bundle library which is no longer installed is dropped
+  run({ "TestBundleR" });
+  const auto oneSize = getCacheSize();
+  EXPECT_LT(oneSize, bothSize);
+  run({ "TestBundleR" });
+  EXPECT_EQ(getCacheSize(), oneSize);
+}
+
+#if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
+TEST(FrameworkTest, FileStorageDetectsRebuiltLibrary)
+{
+  TempDir frameworkStorage = MakeUniqueTempDirectory();
+  TempDir libDir = MakeUniqueTempDirectory();
+  FrameworkConfiguration frameworkConfig;
+  frameworkConfig[Constants::FRAMEWORK_STORAGE] =
+    static_cast<std::string>(frameworkStorage);
+  frameworkConfig[Constants::FRAMEWORK_STORAGE_TYPE] =
+    Constants::FRAMEWORK_STORAGE_TYPE_FILE;
+
+  const std::string libName =
+    std::string(US_LIB_PREFIX) + "TestBundleR" + US_LIB_POSTFIX + US_LIB_EXT;
+  const std::string libPath =
+    static_cast<std::string>(libDir) + util::DIR_SEP + libName;
+  std::string content;
+  {
+    std::ifstream in(cppmicroservices::testing::LIB_PATH + util::DIR_SEP +
+                       libName,
+                     std::ios_base::binary);
+    content.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+    std::ofstream out(libPath, std::ios_base::binary);
+    out << content;
+  }
+  struct stat libStat;
+  ASSERT_EQ(stat(libPath.c_str(), &libStat), 0);
+
+  {
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start());
+    auto bundles = framework.GetBundleContext().InstallBundles(libPath);
+    ASSERT_EQ(bundles.size(), 1u);
+    ASSERT_TRUE(bundles.front().GetResource("foo.txt").IsValid());
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  // Rebuild the library with a renamed resource, keeping its size and
+  // the second of its modification time.
+  std::string::size_type pos = 0;
+  while ((pos = content.find("foo.txt", pos)) != std::string::npos) {
+    content[pos + 2] = 'p';
+  }
+  {
+    std::ofstream out(libPath, std::ios_base::binary | std::ios_base::trunc);
+    out << content;
+  }
+  struct timespec times[2];
+  times[0].tv_sec = 0;
+  times[0].tv_nsec = UTIME_OMIT;
+#  if defined(US_PLATFORM_APPLE)
+  times[1] = libStat.st_mtimespec;
+#  else
+  times[1] = libStat.st_mtim;
+#  endif
+  times[1].tv_nsec = (times[1].tv_nsec + 1) % 1000000000;
+  ASSERT_EQ(utimensat(AT_FDCWD, libPath.c_str(), times, 0), 0);
+
+  auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+  ASSERT_NO_THROW(framework.Start());
+  auto bundles = framework.GetBundleContext().InstallBundles(libPath);
+  ASSERT_EQ(bundles.size(), 1u);
+  EXPECT_FALSE(bundles.front().GetResource("foo.txt").IsValid())
+    << "The cached resource index of the old library must not be used";
+  EXPECT_TRUE(bundles.front().GetResource("fop.txt").IsValid());
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
+
+TEST(FrameworkTest, PrefetchBundleLibraries)
+{
+  FrameworkConfiguration frameworkConfig;
+  frameworkConfig[Constants::FRAMEWORK_BUNDLE_PREFETCH] = true;
+  auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+  ASSERT_NO_THROW(framework.Start());
+  // TestBundleR has no activator. It is installed first, so the prefetcher
+  // is done with it once TestBundleA has been prefetched.
+  auto bundleWithoutActivator = cppmicroservices::testing::InstallLib(
+    framework.GetBundleContext(), "TestBundleR");
+  ASSERT_TRUE(bundleWithoutActivator);
+  auto bundle = cppmicroservices::testing::InstallLib(
+    framework.GetBundleContext(), "TestBundleA");
+  ASSERT_TRUE(bundle);
+
+  // Prefetching happens in the background.
+  auto const deadline =
+    std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!framework.GetBundleLoadStatistics()[bundle.GetBundleId()]
+            .prefetched &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  auto stats = framework.GetBundleLoadStatistics()[bundle.GetBundleId()];
+  ASSERT_TRUE(stats.prefetched);
+  EXPECT_EQ(stats.loadTime.count(), 0);
+
+  // Bundles without an activator are neither prefetched nor loaded.
+  auto withoutActivatorStats =
+    framework
+      .GetBundleLoadStatistics()[bundleWithoutActivator.GetBundleId()];
+  EXPECT_FALSE(withoutActivatorStats.prefetched);
+  EXPECT_EQ(withoutActivatorStats.loadTime.count(), 0);
+#if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
+  auto handle = dlopen(bundleWithoutActivator.GetLocation().c_str(),
+                       RTLD_LAZY | RTLD_NOLOAD);
+  EXPECT_EQ(handle, nullptr);
+  if (handle) {
+    dlclose(handle);
+  }
+#endif
+
+  bundle.Start();
+  stats = framework.GetBundleLoadStatistics()[bundle.GetBundleId()];
+  EXPECT_GT(stats.loadTime.count(), 0);
+
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(FrameworkTest, PrefetchIsDisabledByDefault)
+{
+  auto framework = FrameworkFactory().NewFramework();
+  ASSERT_NO_THROW(framework.Start());
+  auto bundle = cppmicroservices::testing::InstallLib(
+    framework.GetBundleContext(), "TestBundleA");
+  bundle.Start();
+  auto stats = framework.GetBundleLoadStatistics()[bundle.GetBundleId()];
+  EXPECT_FALSE(stats.prefetched);
+  EXPECT_GT(stats.loadTime.count(), 0);
+
+  framework.Stop();
+  framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
+
 TEST(FrameworkTest, DefaultLogSink)
 {
   FrameworkConfiguration configuration;
@@ -0,0 +1,204 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/util/FileSystem.h"
+
+#include "TestUtils.h"
+#include <TestingConfig.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+
+namespace {
+
+std::string LibLocation(const std::string& libName)
+{
+  return cppmicroservices::testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX +
+         libName + US_LIB_POSTFIX + US_LIB_EXT;
+}
+
+class InstallBundlesTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FrameworkConfiguration config{
+      { Constants::FRAMEWORK_BUNDLE_INSTALL_THREADS, 4 }
+    };
+    framework = FrameworkFactory().NewFramework(config);
+    framework.Start();
+    context = framework.GetBundleContext();
+  }
+
+  void TearDown() override
+  {
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  Framework framework{ FrameworkFactory().NewFramework() };
+  BundleContext context;
+};
+}
+
+TEST_F(InstallBundlesTest, InstallsInLocationOrder)
+{
+  const std::vector<std::string> names = { "TestBundleA", "TestBundleB",
+                                           "TestBundleH", "TestBundleLQ",
+                                           "TestBundleM", "TestBundleR" };
+  std::vector<std::string> locations;
+  for (auto const& name : names) {
+    locations.push_back(LibLocation(name));
+  }
+
+  std::vector<Bundle> events;
+  context.AddBundleListener([&events](const BundleEvent& evt) {
+    if (evt.GetType() == BundleEvent::BUNDLE_INSTALLED) {
+      events.push_back(evt.GetBundle());
+    }
+  });
+
+  auto bundles = context.InstallBundles(locations);
+  ASSERT_EQ(events, bundles);
+
+  // A bundle library can contain several bundles, but the bundles must be
+  // grouped by location and appear in the order of the locations.
+  std::size_t location = 0;
+  for (std::size_t i = 0; i < bundles.size(); ++i) {
+    while (location < locations.size() &&
+           bundles[i].GetLocation() != locations[location]) {
+      ++location;
+    }
+    ASSERT_LT(location, locations.size()) << "Unexpected bundle order";
+    EXPECT_EQ(bundles[i].GetState(), Bundle::STATE_INSTALLED);
+    if (i > 0) {
+      EXPECT_GT(bundles[i].GetBundleId(), bundles[i - 1].GetBundleId());
+    }
+  }
+  for (auto const& name : names) {
+    EXPECT_EQ(std::count_if(bundles.begin(),
+                            bundles.end(),
+                            [&name](const Bundle& b) {
+                              return b.GetSymbolicName() == name;
+                            }),
+              1);
+  }
+}
+
+TEST_F(InstallBundlesTest, InstalledAndDuplicateLocations)
+{
+  auto bundleA =
+    cppmicroservices::testing::InstallLib(context, "TestBundleA");
+  ASSERT_TRUE(bundleA);
+
+  auto bundles = context.InstallBundles({ LibLocation("TestBundleA"),
+                                          LibLocation("TestBundleB"),
+                                          LibLocation("TestBundleB") });
+  auto bundlesA = context.GetBundles(LibLocation("TestBundleA"));
+  auto bundlesB = context.GetBundles(LibLocation("TestBundleB"));
+  ASSERT_EQ(bundles.size(), bundlesA.size() + 2 * bundlesB.size());
+  EXPECT_EQ(bundles.front(), bundleA);
+  EXPECT_TRUE(std::equal(bundles.begin() + bundlesA.size(),
+                         bundles.begin() + bundlesA.size() + bundlesB.size(),
+                         bundles.begin() + bundlesA.size() + bundlesB.size()));
+}
+
+TEST_F(InstallBundlesTest, FailureStopsAtFailingLocation)
+{
+  const std::string invalidLocation = cppmicroservices::testing::LIB_PATH +
+                                      util::DIR_SEP + "NonExistingBundleLib";
+  EXPECT_THROW(context.InstallBundles({ LibLocation("TestBundleA"),
+                                        invalidLocation,
+                                        LibLocation("TestBundleB") }),
+               std::runtime_error);
+
+  EXPECT_EQ(context.GetBundles(LibLocation("TestBundleA")).size(), 1u);
+  EXPECT_TRUE(context.GetBundles(LibLocation("TestBundleB")).empty());
+
+  // The claims on all locations must have been released, otherwise
+  // this call would wait forever.
+  auto bundleB =
+    cppmicroservices::testing::InstallLib(context, "TestBundleB");
+  EXPECT_TRUE(bundleB);
+}
+
+TEST_F(InstallBundlesTest, ConcurrentOverlappingLocations)
+{
+  const std::vector<std::string> names = { "TestBundleA", "TestBundleB",
+                                           "TestBundleH", "TestBundleLQ",
+                                           "TestBundleM", "TestBundleR" };
+  std::vector<std::string> locations;
+  for (auto const& name : names) {
+    locations.push_back(LibLocation(name));
+  }
+  std::vector<std::string> reversed(locations.rbegin(), locations.rend());
+
+  // Each batch waits for the locations claimed by the other one, which
+  // must not deadlock.
+  for (int i = 0; i < 20; ++i) {
+    auto first = std::async(std::launch::async,
+                            [&] { return context.InstallBundles(locations); });
+    auto second = std::async(std::launch::async,
+                             [&] { return context.InstallBundles(reversed); });
+    ASSERT_EQ(first.wait_for(std::chrono::seconds(30)),
+              std::future_status::ready);
+    ASSERT_EQ(second.wait_for(std::chrono::seconds(30)),
+              std::future_status::ready);
+    auto firstBundles = first.get();
+    auto secondBundles = second.get();
+    ASSERT_EQ(firstBundles.size(), secondBundles.size());
+    EXPECT_TRUE(std::is_permutation(
+      firstBundles.begin(), firstBundles.end(), secondBundles.begin()));
+    auto locationIndex = [](const std::vector<std::string>& order,
+                            const Bundle& b) {
+      return std::find(order.begin(), order.end(), b.GetLocation()) -
+             order.begin();
+    };
+    for (std::size_t j = 1; j < firstBundles.size(); ++j) {
+      EXPECT_LE(locationIndex(locations, firstBundles[j - 1]),
+                locationIndex(locations, firstBundles[j]));
+      EXPECT_LE(locationIndex(reversed, secondBundles[j - 1]),
+                locationIndex(reversed, secondBundles[j]));
+    }
+    for (auto& bundle : firstBundles) {
+      bundle.Uninstall();
+    }
+  }
+}
+
+#endif
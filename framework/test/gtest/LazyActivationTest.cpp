@@ -0,0 +1,176 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+#include "cppmicroservices/ServiceReference.h"
+
+#include "TestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+
+namespace {
+
+const std::string lazyServiceId = "cppmicroservices::TestBundleLazyService";
+
+class LazyActivationTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    framework.Start();
+    context = framework.GetBundleContext();
+    bundle = cppmicroservices::testing::InstallLib(context, "TestBundleLazy");
+    ASSERT_TRUE(bundle);
+    context.AddBundleListener([this](const BundleEvent& evt) {
+      if (evt.GetBundle() == bundle) {
+        events.push_back(evt.GetType());
+      }
+    });
+  }
+
+  void TearDown() override
+  {
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  bool HasEvent(BundleEvent::Type type) const
+  {
+    return std::find(events.begin(), events.end(), type) != events.end();
+  }
+
+  Framework framework{ FrameworkFactory().NewFramework() };
+  BundleContext context;
+  Bundle bundle;
+  std::vector<BundleEvent::Type> events;
+};
+}
+
+TEST_F(LazyActivationTest, ActivatesOnFirstGetService)
+{
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+  EXPECT_TRUE(HasEvent(BundleEvent::BUNDLE_LAZY_ACTIVATION));
+  EXPECT_FALSE(HasEvent(BundleEvent::BUNDLE_STARTED));
+
+  // Starting again with the activation policy keeps waiting.
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+
+  // The declared service is visible before the activation.
+  auto refs = context.GetServiceReferences(lazyServiceId);
+  ASSERT_EQ(refs.size(), 1u);
+  EXPECT_EQ(refs.front().GetBundle(), bundle);
+  EXPECT_TRUE(any_cast<bool>(refs.front().GetProperty("lazy.declared")));
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+
+  auto service = context.GetService(refs.front());
+  ASSERT_TRUE(service);
+  EXPECT_EQ(service->count(lazyServiceId), 1u);
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+  EXPECT_TRUE(HasEvent(BundleEvent::BUNDLE_STARTED));
+
+  // The placeholder is replaced by the service registered by the activator.
+  refs = context.GetServiceReferences(lazyServiceId);
+  ASSERT_EQ(refs.size(), 1u);
+  EXPECT_TRUE(refs.front().GetProperty("lazy.declared").Empty());
+  EXPECT_EQ(context.GetService(refs.front())->at(lazyServiceId),
+            service->at(lazyServiceId));
+}
+
+TEST_F(LazyActivationTest, ServiceIsTrackedForRequestingBundle)
+{
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  auto placeholder = context.GetServiceReference(lazyServiceId);
+  ASSERT_TRUE(placeholder);
+
+  auto service = context.GetService(placeholder);
+  ASSERT_TRUE(service);
+  ASSERT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+
+  auto ref = context.GetServiceReference(lazyServiceId);
+  ASSERT_TRUE(ref);
+  auto usingBundles = ref.GetUsingBundles();
+  ASSERT_EQ(usingBundles.size(), 1u);
+  EXPECT_EQ(usingBundles.front(), framework);
+
+  service.reset();
+  EXPECT_TRUE(ref.GetUsingBundles().empty())
+    << "Releasing the service must unget it for the requesting bundle";
+}
+
+TEST_F(LazyActivationTest, EagerStart)
+{
+  bundle.Start();
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+  EXPECT_FALSE(HasEvent(BundleEvent::BUNDLE_LAZY_ACTIVATION));
+
+  auto refs = context.GetServiceReferences(lazyServiceId);
+  ASSERT_EQ(refs.size(), 1u);
+  EXPECT_TRUE(refs.front().GetProperty("lazy.declared").Empty());
+}
+
+TEST_F(LazyActivationTest, EagerStartWhileWaiting)
+{
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  ASSERT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+
+  bundle.Start();
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+
+  auto refs = context.GetServiceReferences(lazyServiceId);
+  ASSERT_EQ(refs.size(), 1u);
+  EXPECT_TRUE(refs.front().GetProperty("lazy.declared").Empty());
+}
+
+TEST_F(LazyActivationTest, StopWhileWaiting)
+{
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  ASSERT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+
+  bundle.Stop();
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_RESOLVED);
+  EXPECT_FALSE(HasEvent(BundleEvent::BUNDLE_STARTED));
+  EXPECT_TRUE(context.GetServiceReferences(lazyServiceId).empty());
+
+  bundle.Start(Bundle::START_ACTIVATION_POLICY);
+  EXPECT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+  EXPECT_EQ(context.GetServiceReferences(lazyServiceId).size(), 1u);
+}
+
+#endif
@@ -238,3 +238,29 @@ TEST_F(ServiceReferenceTest, TestGetServiceReferenceWithModifiedProperties)
   ASSERT_EQ(context.GetServiceReference<ServiceNS::ITestServiceA>(),
             regArr[1].GetReference());
 }
+
+TEST_F(ServiceReferenceTest, TestRegisterServiceProperties)
+{
+  auto context = framework.GetBundleContext();
+  auto impl = std::make_shared<TestServiceA>();
+
+  auto reg = context.RegisterService<ServiceNS::ITestServiceA>(
+    impl, { { "custom", std::string("value") }, { "Another.Key", 5 } });
+  auto sRef = reg.GetReference();
+
+  // user supplied and framework supplied properties are all present
+  EXPECT_EQ(any_cast<std::string>(sRef.GetProperty("custom")), "value");
+  EXPECT_EQ(any_cast<int>(sRef.GetProperty("another.key")), 5);
+  EXPECT_EQ(any_cast<std::vector<std::string>>(
+              sRef.GetProperty(Constants::OBJECTCLASS)),
+            std::vector<std::string>{ "ServiceNS::ITestServiceA" });
+  EXPECT_FALSE(sRef.GetProperty(Constants::SERVICE_ID).Empty());
+  EXPECT_EQ(any_cast<std::string>(sRef.GetProperty(Constants::SERVICE_SCOPE)),
+            Constants::SCOPE_SINGLETON);
+  EXPECT_EQ(sRef.GetPropertyKeys().size(), 5u);
+
+  // case variants of framework defined keys are rejected
+  EXPECT_THROW(context.RegisterService<ServiceNS::ITestServiceA>(
+                 impl, { { "Service.Scope", std::string("singleton") } }),
+               std::runtime_error);
+}
@@ -0,0 +1,140 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleStartResult.h"
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
+
+#include "TestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+
+namespace {
+
+class StartBundlesTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FrameworkConfiguration config{
+      { Constants::FRAMEWORK_BUNDLE_START_THREADS, 4 }
+    };
+    framework = FrameworkFactory().NewFramework(config);
+    framework.Start();
+    context = framework.GetBundleContext();
+  }
+
+  void TearDown() override
+  {
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+  }
+
+  Bundle Install(const std::string& name)
+  {
+    auto bundle = cppmicroservices::testing::InstallLib(context, name);
+    EXPECT_TRUE(bundle) << "Cannot install " << name;
+    return bundle;
+  }
+
+  Framework framework{ FrameworkFactory().NewFramework() };
+  BundleContext context;
+};
+}
+
+TEST_F(StartBundlesTest, StartsDependenciesFirst)
+{
+  auto bundleB = Install("TestStartDependencyB");
+  auto bundleA = Install("TestStartDependencyA");
+
+  // TestStartDependencyB fails to start if TestStartDependencyA
+  // is not active yet.
+  auto results = context.StartBundles({ bundleB, bundleA });
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0].bundle, bundleB);
+  EXPECT_EQ(results[1].bundle, bundleA);
+  for (auto const& result : results) {
+    EXPECT_FALSE(result.exception) << result.bundle.GetSymbolicName();
+    EXPECT_EQ(result.bundle.GetState(), Bundle::STATE_ACTIVE);
+  }
+  EXPECT_GE(results[1].duration, std::chrono::milliseconds(20));
+}
+
+TEST_F(StartBundlesTest, IgnoresDependenciesOutsideTheSet)
+{
+  auto bundleB = Install("TestStartDependencyB");
+  Install("TestStartDependencyA");
+
+  auto results = context.StartBundles({ bundleB });
+  ASSERT_EQ(results.size(), 1u);
+  ASSERT_TRUE(results[0].exception);
+  EXPECT_THROW(std::rethrow_exception(results[0].exception),
+               std::runtime_error);
+  EXPECT_EQ(bundleB.GetState(), Bundle::STATE_RESOLVED);
+}
+
+TEST_F(StartBundlesTest, ReportsEachBundle)
+{
+  const std::vector<std::string> names = { "TestBundleA",
+                                           "TestBundleStartFail",
+                                           "TestBundleH",
+                                           "TestBundleM",
+                                           "TestStartDependencyA" };
+  std::vector<Bundle> bundles;
+  for (auto const& name : names) {
+    bundles.push_back(Install(name));
+  }
+
+  auto results = context.StartBundles(bundles);
+  ASSERT_EQ(results.size(), bundles.size());
+  for (std::size_t i = 0; i < bundles.size(); ++i) {
+    EXPECT_EQ(results[i].bundle, bundles[i]);
+    if (names[i] == "TestBundleStartFail") {
+      EXPECT_TRUE(results[i].exception);
+      EXPECT_NE(bundles[i].GetState(), Bundle::STATE_ACTIVE);
+    } else {
+      EXPECT_FALSE(results[i].exception) << names[i];
+      EXPECT_EQ(bundles[i].GetState(), Bundle::STATE_ACTIVE);
+    }
+  }
+}
+
+TEST_F(StartBundlesTest, InvalidBundle)
+{
+  EXPECT_THROW(context.StartBundles({ Bundle() }), std::invalid_argument);
+}
+
+#endif
@@ -22,15 +22,22 @@
 
 #include "miniz.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -288,8 +295,217 @@ Json::Value AggregateManifestsAndValidate(
             << manifestJson.toStyledString() << std::endl;
   return manifestJson;
 }
+
+// The binary manifest format must be kept in sync with
+// BundleManifest::ParseBinary() in the framework.
+const char BINARY_MANIFEST_MAGIC[4] = { 'U', 'S', 'M', 'F' };
+const uint32_t BINARY_MANIFEST_VERSION = 1;
+
+enum BinaryValueTag : uint8_t
+{
+  TAG_OBJECT = 0,
+  TAG_ORDERED_OBJECT = 1,
+  TAG_ARRAY = 2,
+  TAG_STRING = 3,
+  TAG_BOOL = 4,
+  TAG_INT = 5,
+  TAG_DOUBLE = 6
+};
+
+void writeUInt32(std::string& out, uint32_t value)
+{
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void writeString(std::string& out, const std::string& value)
+{
+  writeUInt32(out, static_cast<uint32_t>(value.size()));
+  out.append(value);
 }
 
+/*
+ * @brief returns true if the framework keeps the JSON value when
+ * parsing a manifest. Null values and integers which do not fit into
+ * an int are dropped.
+ */
+bool isRepresentable(const Json::Value& value)
+{
+  switch (value.type()) {
+    case Json::nullValue:
+      return false;
+    case Json::intValue:
+    case Json::uintValue:
+      return value.isInt();
+    default:
+      return true;
+  }
+}
+
+void writeBinaryValue(std::string& out, const Json::Value& value, bool ci);
+
+void writeBinaryChildren(std::string& out, const Json::Value& value, bool ci)
+{
+  std::vector<const Json::Value*> children;
+  std::vector<std::string> names;
+  for (auto iter = value.begin(); iter != value.end(); ++iter) {
+    if (isRepresentable(*iter)) {
+      children.push_back(&(*iter));
+      if (value.isObject()) {
+        names.push_back(iter.name());
+      }
+    }
+  }
+  writeUInt32(out, static_cast<uint32_t>(children.size()));
+  for (std::size_t i = 0; i < children.size(); ++i) {
+    if (value.isObject()) {
+      writeString(out, names[i]);
+    }
+    writeBinaryValue(out, *children[i], ci);
+  }
+}
+
+/*
+ * @brief writes a JSON value in the binary manifest format, applying the
+ * same conversions as the framework's JSON manifest parser.
+ * @param ci true if objects are stored with case-insensitive keys, which
+ * is the case for all objects nested in the manifest root.
+ */
+void writeBinaryValue(std::string& out, const Json::Value& value, bool ci)
+{
+  switch (value.type()) {
+    case Json::objectValue:
+      out.push_back(static_cast<char>(ci ? TAG_OBJECT : TAG_ORDERED_OBJECT));
+      writeBinaryChildren(out, value, ci);
+      break;
+    case Json::arrayValue:
+      out.push_back(static_cast<char>(TAG_ARRAY));
+      writeBinaryChildren(out, value, ci);
+      break;
+    case Json::stringValue: {
+      // Attribute localization is not supported, the framework always
+      // removes a leading '%' character.
+      std::string str = value.asString();
+      if (!str.empty() && str[0] == '%') {
+        str = str.substr(1);
+      }
+      out.push_back(static_cast<char>(TAG_STRING));
+      writeString(out, str);
+      break;
+    }
+    case Json::booleanValue:
+      out.push_back(static_cast<char>(TAG_BOOL));
+      out.push_back(static_cast<char>(value.asBool() ? 1 : 0));
+      break;
+    case Json::intValue:
+    case Json::uintValue:
+      out.push_back(static_cast<char>(TAG_INT));
+      writeUInt32(out, static_cast<uint32_t>(value.asInt()));
+      break;
+    case Json::realValue: {
+      double d = value.asDouble();
+      uint64_t bits = 0;
+      std::memcpy(&bits, &d, sizeof(d));
+      out.push_back(static_cast<char>(TAG_DOUBLE));
+      writeUInt32(out, static_cast<uint32_t>(bits & 0xFFFFFFFF));
+      writeUInt32(out, static_cast<uint32_t>(bits >> 32));
+      break;
+    }
+    default:
+      throw std::runtime_error("Unsupported JSON value in manifest");
+  }
+}
+
+/*
+ * @brief converts a validated manifest into the compact binary manifest
+ * format which the framework loads without parsing JSON.
+ * @param manifest the manifest root, which must be a JSON object.
+ * @throw InvalidManifest if the manifest root is not an object.
+ * @return the binary manifest content
+ */
+std::string toBinaryManifest(const Json::Value& manifest)
+{
+  if (!manifest.isObject()) {
+    throw InvalidManifest("The Json root element must be an object.");
+  }
+  std::string out(BINARY_MANIFEST_MAGIC, sizeof(BINARY_MANIFEST_MAGIC));
+  writeUInt32(out, BINARY_MANIFEST_VERSION);
+  out.push_back(static_cast<char>(TAG_OBJECT));
+  writeBinaryChildren(out, manifest, true);
+  return out;
+}
+
+/*
+ * @brief returns the lower case file extension of a path, without the dot.
+ */
+std::string fileExtension(const std::string& path)
+{
+  auto dot = path.find_last_of('.');
+  auto sep = path.find_last_of("/\\");
+  if (dot == std::string::npos || (sep != std::string::npos && dot < sep)) {
+    return std::string();
+  }
+  std::string ext(path.substr(dot + 1));
+  std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  return ext;
+}
+
+/*
+ * @brief reads the whole content of a file.
+ * @throw std::runtime_error if the file could not be read.
+ */
+std::vector<char> readFile(const std::string& path)
+{
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open file " + path);
+  }
+  std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+  if (file.bad()) {
+    throw std::runtime_error("Error reading file " + path);
+  }
+  return data;
+}
+}
+
+/*
+ * @brief file extensions of formats which are compressed already. Files
+ * are deflated by default. Passing "--store-ext compressed" stores files
+ * with these extensions without compression instead, which also lets the
+ * framework read them without copying.
+ */
+const std::set<std::string> COMPRESSED_FORMAT_EXTENSIONS = {
+  "7z",  "bz2", "gif", "gz",   "jar", "jpeg", "jpg", "mp3",
+  "mp4", "ogg", "png", "webp", "xz",  "zip"
+};
+
+/*
+ *@brief options controlling how resource files are added to a zip archive
+ */
+struct ZipArchiveOptions
+{
+  ZipArchiveOptions()
+    : compressionLevel(MZ_DEFAULT_LEVEL)
+    , binaryManifest(false)
+    , incremental(false)
+    , jobs(1)
+  {}
+
+  int compressionLevel;
+  // add a compiled manifest.bin next to manifest.json
+  bool binaryManifest;
+  // reuse unchanged compressed entries of an existing output archive
+  bool incremental;
+  // number of threads compressing resource files
+  unsigned int jobs;
+  // lower case extensions of files which are stored without compression
+  std::set<std::string> storedExtensions;
+};
+
 /*
  *@brief class to represent the zip archive for bundles
  */
@@ -297,11 +513,12 @@ class ZipArchive
 {
 public:
   ZipArchive(const std::string& archiveFileName,
-             int compressionLevel,
-             const std::string& bundleName);
+             const std::string& bundleName,
+             const ZipArchiveOptions& options);
   virtual ~ZipArchive();
   /*
-  * @brief Add manifest.json to this zip archive
+  * @brief Add manifest.json to this zip archive. If binary manifests are
+  * enabled, manifest.bin is added as well.
   * @param manifest contents of the manifest to add to the zip archive
   * @throw std::runtime exception if failed to add manifest.json
   * @throw InvalidManifest if manifest.json is invalid
@@ -317,6 +534,15 @@ public:
    */
   void AddResourceFile(const std::string& resFileName, bool isManifest = false);
 
+  /*
+   * @brief Add files to this zip archive. The files are compressed on
+   * multiple threads and written to the archive in the given order.
+   * @throw std::runtime exception if failed to add any of the resource files
+   * @throw InvalidManifest if manifest.json is invalid
+   * @param resFileNames are the paths to the resources to be added
+   */
+  void AddResourceFiles(const std::vector<std::string>& resFileNames);
+
   /*
    * @brief Add all files from another zip archive to this zip archive
    * @throw std::runtime exception if failed to add any of the resources
@@ -332,12 +558,75 @@ public:
   ZipArchive& operator=(ZipArchive&&) = delete;
 
 private:
+  /*
+   * @brief A resource file on its way into the archive. Entries are
+   * prepared in order, compressed concurrently and then written in order.
+   */
+  struct ResourceEntry
+  {
+    ResourceEntry()
+      : addsManifest(false)
+      , store(false)
+      , compressed(false)
+      , reuse(false)
+      , done(false)
+      , crc32(0)
+    {}
+
+    std::string fileName;     // path of the resource file
+    std::string archiveEntry; // name of the entry in the archive
+    bool addsManifest;
+    Json::Value manifest;
+    bool store; // store without compression
+    // set by CompressEntry()
+    bool compressed; // data holds raw deflate data
+    bool reuse;      // copy the entry from the previous archive
+    bool done;
+    mz_uint32 crc32;
+    std::vector<char> content; // uncompressed file content
+    std::vector<char> data;    // deflated file content
+    std::exception_ptr error;
+  };
+
+  /*
+   * @brief Validate the resource file and reserve its archive entry name
+   * @throw std::runtime exception if the archive entry already exists
+   * @throw InvalidManifest if manifest.json is invalid
+   */
+  ResourceEntry PrepareResourceEntry(const std::string& resFileName,
+                                     bool isManifest);
+
+  /*
+   * @brief Read and compress the file of a resource entry, unless the
+   * previous archive contains the same content. Called concurrently for
+   * different entries.
+   */
+  void CompressEntry(ResourceEntry& entry) const;
+
+  /*
+   * @brief Write a prepared resource entry and its directory entries
+   * @throw std::runtime exception if failed to write the entry
+   */
+  void WriteEntry(ResourceEntry& entry);
+
+  /*
+   * @brief Open the previous version of the output archive for reuse of
+   * unchanged entries. Does nothing if there is no readable archive.
+   */
+  void OpenPreviousArchive();
+
   /*
    * @brief Add a directory entry to the zip archive
    * @throw std::runtime exception if failed to add the entry
    */
   void AddDirectory(const std::string& dirName);
 
+  /*
+   * @brief Add manifest.bin, the binary form of the given manifest
+   * @throw std::runtime exception if failed to add manifest.bin
+   */
+  void AddBinaryManifestFile(const Json::Value& manifest);
+
   /*
    * @brief Checks whether the archive file entry already
    *        exists in the zip archive. If it does, throw an exception.
@@ -353,21 +642,34 @@ private:
 
   std::string fileName;
   int compressionLevel;
+  // comment of compressed resource entries, records the compression level
+  // so that entries are only reused for the same level
+  std::string compressedEntryComment;
   std::string bundleName;
+  ZipArchiveOptions options;
   std::unique_ptr<mz_zip_archive> writeArchive;
+  std::string previousFileName;
+  std::unique_ptr<mz_zip_archive> previousArchive;
+  // file entries of the previous archive and their index
+  std::unordered_map<std::string, mz_uint> previousEntries;
   std::set<std::string> archivedNames; // list of all the file entries
   std::set<std::string> archivedDirs;  // list of all directory entries
 };
 
 ZipArchive::ZipArchive(const std::string& archiveFileName,
-                       int compressionLevel,
-                       const std::string& bName)
+                       const std::string& bName,
+                       const ZipArchiveOptions& opts)
   : fileName(archiveFileName)
-  , compressionLevel(compressionLevel)
+  , compressionLevel(opts.compressionLevel)
+  , compressedEntryComment("level=" + std::to_string(opts.compressionLevel))
   , bundleName(bName)
+  , options(opts)
   , writeArchive(new mz_zip_archive())
 {
   std::clog << "Initializing zip archive " << fileName << " ..." << std::endl;
+  if (options.incremental) {
+    OpenPreviousArchive();
+  }
   // clear the contents of a outFile if it exists
   std::ofstream ofile(fileName, std::ofstream::trunc);
   ofile.close();
@@ -402,18 +704,84 @@ void ZipArchive::AddManifestFile(const Json::Value& manifest)
                              fileName);
   }
   AddDirectory(bundleName + "/");
+  if (options.binaryManifest) {
+    AddBinaryManifestFile(manifest);
+  }
 }
 
-void ZipArchive::AddResourceFile(const std::string& resFileName,
-                                 bool isManifest)
+void ZipArchive::AddBinaryManifestFile(const Json::Value& manifest)
+{
+  std::string binaryManifestData(toBinaryManifest(manifest));
+  std::string archiveEntry(bundleName + "/manifest.bin");
+
+  CheckAndAddToArchivedNames(archiveEntry);
+
+  if (MZ_FALSE == mz_zip_writer_add_mem(writeArchive.get(),
+                                        archiveEntry.c_str(),
+                                        binaryManifestData.data(),
+                                        binaryManifestData.size(),
+                                        compressionLevel)) {
+    throw std::runtime_error("Error writing manifest.bin to archive " +
+                             fileName);
+  }
+}
+
+void ZipArchive::OpenPreviousArchive()
 {
+  std::ifstream existing(fileName, std::ios::in | std::ios::binary);
+  if (!existing.is_open() ||
+      existing.peek() == std::ifstream::traits_type::eof()) {
+    return;
+  }
+  existing.close();
+
+  // The output file is overwritten, so keep the previous archive around
+  // under a different name until the new archive is finalized.
+  previousFileName = fileName + ".previous";
+  std::remove(previousFileName.c_str());
+  if (std::rename(fileName.c_str(), previousFileName.c_str()) != 0) {
+    std::clog << "Cannot reuse entries of " << fileName << ": "
+              << get_error_str() << std::endl;
+    previousFileName.clear();
+    return;
+  }
+
+  previousArchive.reset(new mz_zip_archive());
+  if (!mz_zip_reader_init_file(
+        previousArchive.get(), previousFileName.c_str(), 0)) {
+    std::clog << "Cannot reuse entries of " << fileName
+              << ": not a zip archive" << std::endl;
+    previousArchive.reset();
+    return;
+  }
+
+  char archiveName[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
+  mz_uint numZipIndices = mz_zip_reader_get_num_files(previousArchive.get());
+  for (mz_uint index = 0; index < numZipIndices; ++index) {
+    if (!mz_zip_reader_is_file_a_directory(previousArchive.get(), index)) {
+      mz_zip_reader_get_filename(
+        previousArchive.get(), index, archiveName, sizeof archiveName);
+      previousEntries.emplace(archiveName, index);
+    }
+  }
+  std::clog << "Reusing unchanged entries of " << fileName << " ("
+            << previousEntries.size() << " files)" << std::endl;
+}
+
+ZipArchive::ResourceEntry ZipArchive::PrepareResourceEntry(
+  const std::string& resFileName,
+  bool isManifest)
+{
+  ResourceEntry entry;
+  entry.fileName = resFileName;
   std::string archiveName = resFileName;
 
   // This check exists solely to maintain a deprecated way of adding manifest.json
   // through the --res-add option.
-  if (isManifest || resFileName == std::string("manifest.json")) {
-    Json::Value root;
-    parseAndValidateJsonFromFile(resFileName, root);
+  entry.addsManifest =
+    isManifest || resFileName == std::string("manifest.json");
+  if (entry.addsManifest) {
+    parseAndValidateJsonFromFile(resFileName, entry.manifest);
   }
 
   // if it is a manifest file, we ignore the parent directory path because the
@@ -424,23 +792,209 @@ void ZipArchive::AddResourceFile(const std::string& resFileName,
       resFileName.substr(resFileName.find_last_of(PATH_SEPARATOR) + 1);
   }
 
-  std::string archiveEntry = bundleName + "/" + archiveName;
-  CheckAndAddToArchivedNames(archiveEntry);
+  entry.archiveEntry = bundleName + "/" + archiveName;
+  CheckAndAddToArchivedNames(entry.archiveEntry);
+
+  entry.store = compressionLevel == 0 ||
+                options.storedExtensions.count(fileExtension(resFileName)) > 0;
+  return entry;
+}
+
+void ZipArchive::CompressEntry(ResourceEntry& entry) const
+{
+  entry.content = readFile(entry.fileName);
+  entry.crc32 = static_cast<mz_uint32>(
+    mz_crc32(MZ_CRC32_INIT,
+             reinterpret_cast<const mz_uint8*>(entry.content.data()),
+             entry.content.size()));
+
+  // miniz stores files of up to 3 bytes without compression
+  bool store = entry.store || entry.content.size() <= 3;
+
+  auto previous = previousEntries.find(entry.archiveEntry);
+  if (previous != previousEntries.end()) {
+    mz_zip_archive_file_stat stat;
+    if (mz_zip_reader_file_stat(
+          previousArchive.get(), previous->second, &stat) &&
+        stat.m_uncomp_size == entry.content.size() &&
+        stat.m_crc32 == entry.crc32 &&
+        (stat.m_method == MZ_DEFLATED) == !store &&
+        (store || compressedEntryComment == stat.m_comment)) {
+      entry.reuse = true;
+      entry.content.clear();
+      entry.content.shrink_to_fit();
+      return;
+    }
+  }
+
+  if (store) {
+    return;
+  }
+
+  std::size_t compressedSize = 0;
+  std::unique_ptr<void, void (*)(void*)> compressed(
+    tdefl_compress_mem_to_heap(
+      entry.content.data(),
+      entry.content.size(),
+      &compressedSize,
+      static_cast<int>(tdefl_create_comp_flags_from_zip_params(
+        compressionLevel, -15, MZ_DEFAULT_STRATEGY))),
+    ::free);
+  if (!compressed) {
+    throw std::runtime_error("Error compressing file " + entry.fileName);
+  }
+  auto begin = static_cast<const char*>(compressed.get());
+  entry.data.assign(begin, begin + compressedSize);
+  entry.compressed = true;
+}
 
-  if (!mz_zip_writer_add_file(writeArchive.get(),
-                              archiveEntry.c_str(),
-                              resFileName.c_str(),
-                              NULL,
-                              0,
-                              compressionLevel)) {
+void ZipArchive::WriteEntry(ResourceEntry& entry)
+{
+  mz_bool result = MZ_FALSE;
+  if (entry.reuse) {
+    std::clog << "\t reusing " << entry.archiveEntry << std::endl;
+    result = mz_zip_writer_add_from_zip_reader(
+      writeArchive.get(),
+      previousArchive.get(),
+      previousEntries.at(entry.archiveEntry));
+  } else if (entry.compressed) {
+    result = mz_zip_writer_add_mem_ex(writeArchive.get(),
+                                      entry.archiveEntry.c_str(),
+                                      entry.data.data(),
+                                      entry.data.size(),
+                                      compressedEntryComment.data(),
+                                      static_cast<mz_uint16>(
+                                        compressedEntryComment.size()),
+                                      static_cast<mz_uint>(compressionLevel) |
+                                        MZ_ZIP_FLAG_COMPRESSED_DATA,
+                                      entry.content.size(),
+                                      entry.crc32);
+  } else {
+    result = mz_zip_writer_add_mem(writeArchive.get(),
+                                   entry.archiveEntry.c_str(),
+                                   entry.content.data(),
+                                   entry.content.size(),
+                                   MZ_NO_COMPRESSION);
+  }
+  if (!result) {
     throw std::runtime_error("Error writing file to archive");
   }
+  entry.content = std::vector<char>();
+  entry.data = std::vector<char>();
+
   // add a directory entries for the file path
+  const std::string& archiveEntry = entry.archiveEntry;
   size_t lastPathSeparatorPos = archiveEntry.find("/", 0);
   while (lastPathSeparatorPos != std::string::npos) {
     AddDirectory(archiveEntry.substr(0, lastPathSeparatorPos + 1));
     lastPathSeparatorPos = archiveEntry.find("/", lastPathSeparatorPos + 1);
   }
+
+  if (entry.addsManifest && options.binaryManifest) {
+    AddBinaryManifestFile(entry.manifest);
+  }
+}
+
+void ZipArchive::AddResourceFile(const std::string& resFileName,
+                                 bool isManifest)
+{
+  ResourceEntry entry(PrepareResourceEntry(resFileName, isManifest));
+  CompressEntry(entry);
+  WriteEntry(entry);
+}
+
+void ZipArchive::AddResourceFiles(const std::vector<std::string>& resFileNames)
+{
+  std::vector<ResourceEntry> entries;
+  entries.reserve(resFileNames.size());
+  for (auto const& resFileName : resFileNames) {
+    entries.push_back(PrepareResourceEntry(resFileName, false));
+  }
+
+  auto numThreads = static_cast<std::size_t>(
+    (std::min)(static_cast<std::size_t>(options.jobs), entries.size()));
+  if (numThreads <= 1) {
+    for (auto& entry : entries) {
+      CompressEntry(entry);
+      WriteEntry(entry);
+    }
+    return;
+  }
+
+  // Workers compress entries ahead of the writer, which writes them in
+  // order. The number of entries held in memory is bounded by a window.
+  const std::size_t window = 4 * numThreads;
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::size_t next = 0;
+  std::size_t written = 0;
+
+  auto worker = [&]() {
+    for (;;) {
+      std::size_t index = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&]() {
+          return next >= entries.size() || next - written < window;
+        });
+        if (next >= entries.size()) {
+          return;
+        }
+        index = next++;
+      }
+      auto& entry = entries[index];
+      try {
+        CompressEntry(entry);
+      } catch (...) {
+        entry.error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        entry.done = true;
+      }
+      cond.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < numThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+
+  std::exception_ptr error;
+  for (auto& entry : entries) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [&entry]() { return entry.done; });
+    }
+    try {
+      if (entry.error) {
+        std::rethrow_exception(entry.error);
+      }
+      WriteEntry(entry);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++written;
+      if (error) {
+        // stop handing out further entries
+        next = entries.size();
+      }
+    }
+    cond.notify_all();
+    if (error) {
+      break;
+    }
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
 }
 
 void ZipArchive::AddDirectory(const std::string& dirName)
@@ -478,6 +1032,12 @@ ZipArchive::~ZipArchive()
   }
   // check state after closing the archive file.
   assert(writeArchive->m_zip_mode == MZ_ZIP_MODE_INVALID);
+  if (previousArchive) {
+    mz_zip_reader_end(previousArchive.get());
+  }
+  if (!previousFileName.empty()) {
+    std::remove(previousFileName.c_str());
+  }
 }
 
 void ZipArchive::AddResourcesFromArchive(const std::string& archiveFileName)
@@ -592,7 +1152,11 @@ enum OptionIndex
   RESADD,
   ZIPADD,
   MANIFESTADD,
-  BUNDLEFILE
+  BUNDLEFILE,
+  BINARYMANIFEST,
+  JOBS,
+  INCREMENTAL,
+  STOREEXT
 };
 
 const option::Descriptor usage[] = {
@@ -665,13 +1229,43 @@ const option::Descriptor usage[] = {
     Custom_Arg::NonEmpty,
     " --bundle-file, -b \tPath to the bundle binary. The resources zip file "
     "will be appended to this binary. " },
+  { BINARYMANIFEST,
+    0,
+    "B",
+    "binary-manifest",
+    Custom_Arg::None,
+    " --binary-manifest, -B  \tAdd a compiled 'manifest.bin' next to the "
+    "bundle manifest. The framework loads it instead of parsing the JSON "
+    "manifest." },
+  { JOBS,
+    0,
+    "j",
+    "jobs",
+    Custom_Arg::Numeric,
+    " --jobs, -j  \tNumber of threads compressing resource files. Defaults "
+    "to the number of hardware threads." },
+  { INCREMENTAL,
+    0,
+    "i",
+    "incremental",
+    Custom_Arg::None,
+    " --incremental, -i  \tReuse the compressed entries of an existing "
+    "--out-file for resource files whose content did not change." },
+  { STOREEXT,
+    0,
+    "s",
+    "store-ext",
+    Custom_Arg::NonEmpty,
+    " --store-ext, -s \tStore files with this extension without "
+    "compression. Use 'compressed' to store common compressed formats like "
+    "png, jpg or zip." },
   { UNKNOWN,
     0,
     "",
     "",
     Custom_Arg::None,
-    "\nNote:\n1. Only options --res-add and --zip-add can be specified "
-    "multiple times." },
+    "\nNote:\n1. Only options --res-add, --zip-add, --manifest-add and "
+    "--store-ext can be specified multiple times." },
   { UNKNOWN,
     0,
     "",
@@ -754,7 +1348,8 @@ static int checkSanity(option::Parser& parse, option::Option* options)
         }
       }
     };
-  check_multiple_args({ BUNDLEFILE, OUTFILE, BUNDLENAME });
+  check_multiple_args(
+    { BUNDLEFILE, OUTFILE, BUNDLENAME, BINARYMANIFEST, JOBS, INCREMENTAL });
 
   // At-least one of --bundle-file or --out-file is required.
   if (!options[BUNDLEFILE] && !options[OUTFILE]) {
@@ -790,7 +1385,7 @@ int main(int argc, char** argv)
 {
   const int BUNDLE_MANIFEST_VALIDATION_ERROR_CODE(2);
 
-  int compressionLevel = MZ_DEFAULT_LEVEL; //default compression level;
+  ZipArchiveOptions archiveOptions; // default compression level etc.
   int return_code = EXIT_SUCCESS;
   std::string bundleName;
 
@@ -824,9 +1419,30 @@ int main(int argc, char** argv)
 
   if (options[COMPRESSIONLEVEL]) {
     char* endptr = nullptr;
-    compressionLevel = strtol(options[COMPRESSIONLEVEL].arg, &endptr, 10);
+    archiveOptions.compressionLevel = static_cast<int>(
+      strtol(options[COMPRESSIONLEVEL].arg, &endptr, 10));
+  }
+  std::clog << "using compression level " << archiveOptions.compressionLevel
+            << std::endl;
+
+  archiveOptions.binaryManifest = options[BINARYMANIFEST].count() > 0;
+  archiveOptions.incremental = options[INCREMENTAL].count() > 0;
+  archiveOptions.jobs = (std::max)(1u, std::thread::hardware_concurrency());
+  if (options[JOBS]) {
+    char* endptr = nullptr;
+    archiveOptions.jobs = static_cast<unsigned int>(
+      (std::max)(1L, strtol(options[JOBS].arg, &endptr, 10)));
+  }
+  for (option::Option* opt = options[STOREEXT]; opt; opt = opt->next()) {
+    std::string ext(opt->arg);
+    if (ext == "compressed") {
+      archiveOptions.storedExtensions.insert(
+        COMPRESSED_FORMAT_EXTENSIONS.begin(),
+        COMPRESSED_FORMAT_EXTENSIONS.end());
+    } else {
+      archiveOptions.storedExtensions.insert(fileExtension("." + ext));
+    }
   }
-  std::clog << "using compression level " << compressionLevel << std::endl;
 
   std::string zipFile;
   bool deleteTempFile = false;
@@ -849,7 +1465,7 @@ int main(int argc, char** argv)
       }
 
       std::unique_ptr<ZipArchive> zipArchive(
-        new ZipArchive(zipFile, compressionLevel, bundleName));
+        new ZipArchive(zipFile, bundleName, archiveOptions));
 
       // map of manifest file to its JSON data
       std::unordered_map<std::string, Json::Value> manifests;
@@ -873,10 +1489,12 @@ int main(int argc, char** argv)
         zipArchive->AddManifestFile(AggregateManifestsAndValidate(manifests));
       }
       // Add resource files to the zip archive
+      std::vector<std::string> resFileNames;
       for (option::Option* resopt = options[RESADD]; resopt;
            resopt = resopt->next()) {
-        zipArchive->AddResourceFile(resopt->arg);
+        resFileNames.push_back(resopt->arg);
       }
+      zipArchive->AddResourceFiles(resFileNames);
       // Merge resources from supplied zip archives
       for (option::Option* opt = options[ZIPADD]; opt; opt = opt->next()) {
         zipArchive->AddResourcesFromArchive(opt->arg);
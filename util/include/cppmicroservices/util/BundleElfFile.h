@@ -28,7 +28,6 @@
 #include <cerrno>
 #include <cstring>
 #include <elf.h>
-#include <fstream>
 #include <map>
 #include <memory>
 #include <new>
@@ -101,54 +100,56 @@ public:
   typedef typename ElfType::Word Word;
   typedef typename ElfType::Off Off;
 
-  BundleElfFile(std::ifstream& fs, std::size_t fileSize, const std::string& fileName)
+  BundleElfFile(const std::shared_ptr<const MappedFile>& file)
     : m_rawData()
   {
-    if (fileSize < sizeof(Ehdr)) {
+    // Read the ELF header
+    auto elfHeader = file->GetView<Ehdr>(0);
+    if (!elfHeader) {
       throw InvalidElfException("Missing ELF header");
     }
 
-    fs.seekg(0);
-
-    // Read the ELF header
-    Ehdr elfHeader;
-    fs.read(reinterpret_cast<char*>(&elfHeader), sizeof elfHeader);
-
-    if (elfHeader.e_type != ET_DYN) {
+    if (elfHeader->e_type != ET_DYN) {
       throw InvalidElfException("Not an ELF shared library");
     }
 
-    if (elfHeader.e_shoff +
-       (elfHeader.e_shnum * elfHeader.e_shentsize) >
-       fileSize) {
-      throw InvalidElfException("ELF section headers missing");
+    if (elfHeader->e_shentsize != sizeof(Shdr)) {
+      throw InvalidElfException("Invalid ELF section header size");
     }
 
-    // read in all section headers
-    auto sectionHeaders = std::make_unique<Shdr[]>(elfHeader.e_shnum);
-    fs.seekg(elfHeader.e_shoff);
-    fs.read(reinterpret_cast<char*>(sectionHeaders.get()),
-      sizeof(Shdr) * elfHeader.e_shnum);
+    auto sectionHeaders =
+      file->GetView<Shdr>(elfHeader->e_shoff, elfHeader->e_shnum);
+    if (!sectionHeaders || elfHeader->e_shstrndx >= elfHeader->e_shnum) {
+      throw InvalidElfException("ELF section headers missing");
+    }
 
     // parse the .us_resources section
-    // keep the buffer in a smart pointer to correctly clean up at end
-    // of scope even if exceptions occur.
-    auto buffer = std::make_unique<char[]>(sectionHeaders[elfHeader.e_shstrndx].sh_size);
-    if (nullptr != buffer) {
-      fs.seekg(sectionHeaders[elfHeader.e_shstrndx].sh_offset);
-      fs.read(buffer.get(), sectionHeaders[elfHeader.e_shstrndx].sh_size);
-
-      for (int i = 0; i < elfHeader.e_shnum; ++i) {
-        if (0 == strcmp(".us_resources", (buffer.get() + sectionHeaders[i].sh_name))) {
-          fs.seekg(sectionHeaders[i].sh_offset);
-          auto zipContentSize = sectionHeaders[i].sh_size;
-          if (0 < zipContentSize) {
-            off_t pa_offset = (sectionHeaders[i].sh_offset) & ~(sysconf(_SC_PAGESIZE) - 1);
-            size_t mappedLength = zipContentSize + (sectionHeaders[i].sh_offset) - pa_offset;
-            m_rawData = std::make_shared<RawBundleResources>(std::make_unique<MappedFile>(fileName, mappedLength, pa_offset));
-            break;
-          }
+    auto const& stringTableHeader = sectionHeaders[elfHeader->e_shstrndx];
+    auto stringTable = file->GetView<char>(stringTableHeader.sh_offset,
+                                           stringTableHeader.sh_size);
+    if (!stringTable) {
+      throw InvalidElfException("ELF section name table missing");
+    }
+
+    const char sectionName[] = ".us_resources";
+    for (int i = 0; i < elfHeader->e_shnum; ++i) {
+      auto const nameOffset = sectionHeaders[i].sh_name;
+      if (nameOffset >= stringTableHeader.sh_size ||
+          stringTableHeader.sh_size - nameOffset < sizeof sectionName ||
+          0 != memcmp(sectionName, stringTable + nameOffset, sizeof sectionName)) {
+        continue;
+      }
+      auto zipContentSize = sectionHeaders[i].sh_size;
+      if (0 < zipContentSize) {
+        auto zipContent =
+          file->GetView<char>(sectionHeaders[i].sh_offset, zipContentSize);
+        if (!zipContent) {
+          throw InvalidElfException("ELF section .us_resources truncated");
         }
+        m_rawData = std::make_shared<RawBundleResources>(
+          std::make_unique<MappedFileRange>(
+            file, zipContent, static_cast<std::size_t>(zipContentSize)));
+        break;
       }
     }
   }
@@ -167,34 +168,21 @@ std::unique_ptr<BundleObjFile> CreateBundleElfFile(const std::string& fileName)
     throw InvalidElfException("Stat for " + fileName + " failed", errno);
   }
 
-  std::size_t fileSize = elfStat.st_size;
-
-  if (fileSize < EI_NIDENT) {
-    throw InvalidElfException("Missing ELF identification");
+  errno = 0;
+  auto elfFile = std::make_shared<const MappedFile>(fileName);
+  auto elfIdent = elfFile->GetView<unsigned char>(0, EI_NIDENT);
+  if (!elfIdent) {
+    throw InvalidElfException("Missing ELF identification", errno);
   }
 
-  std::ifstream elfFile(fileName.c_str(), std::ios_base::binary);
-  elfFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-  char elfIdent[EI_NIDENT];
-  elfFile.read(elfIdent, sizeof elfIdent);
-
   if (memcmp(elfIdent, ELFMAG, SELFMAG) != 0) {
     throw InvalidElfException("Not an ELF object file");
   }
 
-  std::ifstream selfFile(fileName, std::ios_base::binary);
-  char selfIdent[EI_NIDENT];
-  selfFile.read(selfIdent, sizeof selfIdent);
-  selfFile.close();
-  if (memcmp(elfIdent, selfIdent, EI_VERSION) != 0) {
-    throw InvalidElfException("Not a compatible ELF object file");
-  }
-
   if (elfIdent[EI_CLASS] == ELFCLASS32) {
-    return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS32>>(elfFile, fileSize, fileName));
+    return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS32>>(elfFile));
   } else if (elfIdent[EI_CLASS] == ELFCLASS64) {
-    return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS64>>(elfFile, fileSize, fileName));
+    return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS64>>(elfFile));
   } else {
     throw InvalidElfException("Unknown ELF format");
   }
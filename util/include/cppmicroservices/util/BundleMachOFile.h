@@ -31,7 +31,6 @@
 #include <mach-o/fat.h>
 #include <mach-o/loader.h>
 #include <mach-o/nlist.h>
-#include <fstream>
 #include <memory>
 
 #include <sys/stat.h>
@@ -86,70 +85,76 @@ public:
   typedef typename MachOType::Mhdr Mhdr;
   typedef typename MachOType::symtab_entry symtab_entry;
 
-  BundleMachOFile(std::ifstream& fs, std::size_t fileOffset, const std::string& location)
+  BundleMachOFile(const std::shared_ptr<const MappedFile>& file,
+                  std::size_t fileOffset)
     : m_rawData()
   {
-    fs.seekg(fileOffset);
-    Mhdr mhdr;
-    fs.read(reinterpret_cast<char*>(&mhdr), sizeof mhdr);
-    if (mhdr.filetype != MH_DYLIB && mhdr.filetype != MH_BUNDLE) {
+    auto mhdr = file->GetView<Mhdr>(fileOffset);
+    if (!mhdr) {
+      throw InvalidMachOException("Missing Mach-O header.");
+    }
+    if (mhdr->filetype != MH_DYLIB && mhdr->filetype != MH_BUNDLE) {
       throw InvalidMachOException(
         "Not a Mach-O dynamic shared library or bundle file.");
     }
-      
-    fs.seekg(fileOffset + sizeof(mach_header_64));
 
     // iterate over all load commands
-    uint32_t ncmds = mhdr.ncmds;
-    uint32_t lcmd_offset = static_cast<uint32_t>(fs.tellg());
-    
-    for (uint32_t i = 0; i < ncmds; ++i) {
-      load_command lcmd;
-      fs.read(reinterpret_cast<char*>(&lcmd), sizeof lcmd);
-      if (!m_rawData && LC_SEGMENT_64 == lcmd.cmd) {
-        m_rawData = GetRawBundleResources<segment_command_64, section_64>(fs, location, fileOffset, lcmd_offset);
-      } else if (!m_rawData && LC_SEGMENT == lcmd.cmd) {
-        m_rawData = GetRawBundleResources<segment_command, section>(fs, location, fileOffset, lcmd_offset);
+    uint32_t ncmds = mhdr->ncmds;
+    uint64_t lcmd_offset = fileOffset + sizeof(Mhdr);
+
+    for (uint32_t i = 0; i < ncmds && !m_rawData; ++i) {
+      auto lcmd = file->GetView<load_command>(lcmd_offset);
+      if (!lcmd || lcmd->cmdsize < sizeof(load_command)) {
+        throw InvalidMachOException("Invalid Mach-O load command.");
+      }
+      if (LC_SEGMENT_64 == lcmd->cmd) {
+        m_rawData = GetRawBundleResources<segment_command_64, section_64>(
+          file, fileOffset, lcmd_offset);
+      } else if (LC_SEGMENT == lcmd->cmd) {
+        m_rawData = GetRawBundleResources<segment_command, section>(
+          file, fileOffset, lcmd_offset);
       }
 
-      lcmd_offset += lcmd.cmdsize;
-      fs.seekg(lcmd_offset);
+      lcmd_offset += lcmd->cmdsize;
     }
   }
 
   template<typename SegmentCommand, typename Section>
-  std::shared_ptr<RawBundleResources> GetRawBundleResources(std::ifstream& fs, const std::string& filePath, std::size_t fileOffset, uint32_t lcmd_offset)
+  static std::shared_ptr<RawBundleResources> GetRawBundleResources(
+    const std::shared_ptr<const MappedFile>& file,
+    std::size_t fileOffset,
+    uint64_t lcmd_offset)
   {
-    fs.seekg(fileOffset + lcmd_offset);
-    SegmentCommand segment;
-    fs.read(reinterpret_cast<char*>(&segment), sizeof(SegmentCommand));
-    if(0 == strcmp("__TEXT", segment.segname)) {
-       // find "us_resources" section
-       for (uint32_t i = 0; i < segment.nsects; ++i) {
-         Section section;
-         fs.read(reinterpret_cast<char*>(&section), sizeof(Section));
-         if (0 == strcmp("us_resources", section.sectname) &&
-             0 < section.size) {
-           // try to be smart about when to use mmap. Benchmark tests show
-           // that mmap is slower than std::ifstream::read until the file size is around 10mb.
-           constexpr std::size_t zipFileSizeThreshold{10485760};
-           if(section.size >= zipFileSizeThreshold) {
-             off_t pa_offset = (fileOffset + section.offset) & ~(sysconf(_SC_PAGESIZE) - 1);
-             size_t mappedLength = section.size + (fileOffset + section.offset) - pa_offset;
-             return std::make_shared<RawBundleResources>(std::make_unique<MappedFile>(filePath, mappedLength, pa_offset));
-           } else {
-             void* zipData = malloc(section.size * sizeof(char));
-             if (zipData) {
-               std::unique_ptr<void, void(*)(void*)> scopedData(zipData, ::free);
-               fs.seekg(fileOffset + section.offset);
-               fs.read(reinterpret_cast<char*>(zipData), section.size);
-               return std::make_shared<RawBundleResources>( std::make_unique<RawDataContainer>(std::move(scopedData), section.size) );
-             }
-           }
-           
-         }
-         fs.seekg(lcmd_offset + sizeof(SegmentCommand) + ((i+1)*sizeof(Section)));
-       }
+    auto segment = file->GetView<SegmentCommand>(lcmd_offset);
+    if (!segment) {
+      throw InvalidMachOException("Invalid Mach-O segment command.");
+    }
+    if (0 == strncmp("__TEXT", segment->segname, sizeof segment->segname)) {
+      auto sections = file->GetView<Section>(
+        lcmd_offset + sizeof(SegmentCommand), segment->nsects);
+      if (!sections) {
+        throw InvalidMachOException("Invalid Mach-O section headers.");
+      }
+      // find "us_resources" section
+      for (uint32_t i = 0; i < segment->nsects; ++i) {
+        auto const& section = sections[i];
+        if (0 == strncmp("us_resources",
+                         section.sectname,
+                         sizeof section.sectname) &&
+            0 < section.size) {
+          // The section data is read lazily through the existing mapping
+          // of the whole file.
+          auto zipContent =
+            file->GetView<char>(fileOffset + section.offset, section.size);
+          if (!zipContent) {
+            throw InvalidMachOException(
+              "Mach-O section us_resources truncated.");
+          }
+          return std::make_shared<RawBundleResources>(
+            std::make_unique<MappedFileRange>(
+              file, zipContent, static_cast<std::size_t>(section.size)));
+        }
+      }
     }
     return {};
   }
@@ -160,37 +165,43 @@ private:
   std::shared_ptr<RawBundleResources> m_rawData;
 };
 
-static std::vector<std::vector<uint32_t>> GetMachOIdents(std::ifstream& is)
+static std::vector<std::vector<uint32_t>> GetMachOIdents(const MappedFile& file)
 {
   // magic (32 or 64 bit) | cputype | offset
   std::vector<std::vector<uint32_t>> idents;
 
-  uint32_t magic;
-  is.seekg(0);
-  is.read(reinterpret_cast<char*>(&magic), sizeof magic);
-
-  if (readBE(magic) == FAT_MAGIC) {
-    is.seekg(0);
-    fat_header fatHdr;
-    is.read(reinterpret_cast<char*>(&fatHdr), sizeof fatHdr);
-    std::unique_ptr<fat_arch[]> fatArchs(new fat_arch[readBE(fatHdr.nfat_arch)]);
-    is.read(reinterpret_cast<char*>(fatArchs.get()),
-            sizeof(fatArchs) * readBE(fatHdr.nfat_arch));
-    const fat_arch* currArch = fatArchs.get();
-    for (uint32_t i = 0; i < readBE(fatHdr.nfat_arch); ++i, ++currArch) {
-      is.seekg(readBE(currArch->offset));
-      mach_header machHdr;
-      is.read(reinterpret_cast<char*>(&machHdr), sizeof machHdr);
+  auto magic = file.GetView<uint32_t>(0);
+  if (!magic) {
+    throw InvalidMachOException("Missing magic number");
+  }
+
+  if (readBE(*magic) == FAT_MAGIC) {
+    auto fatHdr = file.GetView<fat_header>(0);
+    auto const nfatArch = fatHdr ? readBE(fatHdr->nfat_arch) : 0;
+    auto fatArchs = file.GetView<fat_arch>(sizeof(fat_header), nfatArch);
+    if (!fatHdr || !fatArchs) {
+      throw InvalidMachOException("Invalid fat binary header");
+    }
+    for (uint32_t i = 0; i < nfatArch; ++i) {
+      auto const& currArch = fatArchs[i];
+      auto machHdr = file.GetView<mach_header>(readBE(currArch.offset));
+      if (!machHdr) {
+        throw InvalidMachOException("Invalid fat binary architecture");
+      }
       std::vector<uint32_t> ident(3, 0);
-      ident[0] = machHdr.magic;
-      ident[1] = readBE(currArch->cputype);
-      ident[2] = readBE(currArch->offset);
+      ident[0] = machHdr->magic;
+      ident[1] = readBE(currArch.cputype);
+      ident[2] = readBE(currArch.offset);
       idents.push_back(ident);
     }
   } else {
+    auto header = file.GetView<uint32_t>(0, 2);
+    if (!header) {
+      throw InvalidMachOException("Missing Mach-O header");
+    }
     std::vector<uint32_t> ident(3, 0);
-    ident[0] = magic;
-    is.read(reinterpret_cast<char*>(&ident[1]), sizeof(uint32_t));
+    ident[0] = header[0];
+    ident[1] = header[1];
     idents.push_back(ident);
   }
   return idents;
@@ -236,18 +247,14 @@ std::unique_ptr<BundleObjFile> CreateBundleMachOFile(const std::string& fileName
     throw InvalidMachOException("Stat for " + fileName + " failed", errno);
   }
 
-  std::size_t fileSize = machStat.st_size;
-
-  // magic number
-  if (fileSize < sizeof(uint32_t)) {
-    throw InvalidMachOException("Missing magic number");
+  errno = 0;
+  auto machFile = std::make_shared<const MappedFile>(fileName);
+  if (!machFile->GetData()) {
+    throw InvalidMachOException("Mapping " + fileName + " failed", errno);
   }
 
-  std::ifstream machFile(fileName.c_str(), std::ios_base::binary);
-  machFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
   std::vector<uint32_t> selfIdent = GetMachOIdent();
-  std::vector<std::vector<uint32_t>> fileIdents = GetMachOIdents(machFile);
+  std::vector<std::vector<uint32_t>> fileIdents = GetMachOIdents(*machFile);
 
   std::vector<uint32_t> matchingIdent(3, 0);
 
@@ -264,9 +271,9 @@ std::unique_ptr<BundleObjFile> CreateBundleMachOFile(const std::string& fileName
   }
 
   if (matchingIdent[0] == MH_MAGIC) {
-    return std::make_unique<BundleMachOFile<MachO<MH_MAGIC>>>(machFile, matchingIdent[2], fileName);
+    return std::make_unique<BundleMachOFile<MachO<MH_MAGIC>>>(machFile, matchingIdent[2]);
   } else if (matchingIdent[0] == MH_MAGIC_64) {
-    return std::make_unique<BundleMachOFile<MachO<MH_MAGIC_64>>>(machFile, matchingIdent[2], fileName);
+    return std::make_unique<BundleMachOFile<MachO<MH_MAGIC_64>>>(machFile, matchingIdent[2]);
   } else {
     throw InvalidMachOException(
       "Internal error: Mach-O magic field value is neither MH_MAGIC nor MH_MAGIC_64");
@@ -23,6 +23,7 @@
 #ifndef CPPMICROSERVICES_UTIL_FILESYSTEM_H
 #define CPPMICROSERVICES_UTIL_FILESYSTEM_H
 
+#include <cstdint>
 #include <string>
 
 namespace cppmicroservices {
@@ -48,6 +49,13 @@ bool IsDirectory(const std::string& path);
 bool IsFile(const std::string& path);
 bool IsRelative(const std::string& path);
 
+// Get the last modification time (in nanoseconds since the epoch, with
+// the resolution of the file system) and the size in bytes of the file at
+// path. Returns false if the file does not exist.
+bool GetFileStatus(const std::string& path,
+                   int64_t& lastModified,
+                   uint64_t& size);
+
 std::string GetAbsolute(const std::string& path, const std::string& base);
 
 void MakePath(const std::string& path);
@@ -27,6 +27,9 @@
 
 #include "DataContainer.h"
 
+#include <cstdint>
+#include <memory>
+
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -40,22 +43,67 @@ public:
   MappedFile()
     : fileDesc(-1)
     , mappedAddress(nullptr)
-    , mapSize(0) {}
-  MappedFile(const std::string& fileLocation, size_t mapLength, off_t offset)
+    , mapSize(0)
+    , dataOffset(0)
+    , dataSize(0) {}
+
+  // Maps length bytes starting at offset. The offset does not need to be
+  // page aligned, GetData() returns the address of the byte at offset.
+  MappedFile(const std::string& fileLocation, size_t length, off_t offset)
     : fileDesc(-1)
     , mappedAddress(nullptr)
-    , mapSize(mapLength)
+    , mapSize(0)
+    , dataOffset(0)
+    , dataSize(0)
   {
+    off_t pageOffset = offset & ~(static_cast<off_t>(sysconf(_SC_PAGESIZE)) - 1);
+    dataOffset = static_cast<size_t>(offset - pageOffset);
     fileDesc = open(fileLocation.c_str(), O_RDONLY);
     if(fileDesc >= 0) {
-      mappedAddress = mmap(0, mapLength, PROT_READ, MAP_PRIVATE, fileDesc, offset);
+      mappedAddress = mmap(0, length + dataOffset, PROT_READ, MAP_PRIVATE, fileDesc, pageOffset);
       if (MAP_FAILED == mappedAddress) {
         mappedAddress = nullptr;
-        mapSize = 0;
+      } else {
+        mapSize = length + dataOffset;
+        dataSize = length;
       }
     }
   }
-    
+
+  // Maps the whole file. Parsing an object file through a single read-only
+  // mapping replaces many small reads, and only the pages which are
+  // actually touched are read. GetData() returns nullptr if the file
+  // cannot be opened or is empty.
+  explicit MappedFile(const std::string& fileLocation)
+    : fileDesc(-1)
+    , mappedAddress(nullptr)
+    , mapSize(0)
+    , dataOffset(0)
+    , dataSize(0)
+  {
+    fileDesc = open(fileLocation.c_str(), O_RDONLY);
+    struct stat fileStat;
+    if (fileDesc >= 0 && fstat(fileDesc, &fileStat) == 0 &&
+        fileStat.st_size > 0) {
+      auto const length = static_cast<size_t>(fileStat.st_size);
+      mappedAddress = mmap(0, length, PROT_READ, MAP_PRIVATE, fileDesc, 0);
+      if (MAP_FAILED == mappedAddress) {
+        mappedAddress = nullptr;
+      } else {
+        mapSize = length;
+        dataSize = length;
+      }
+    }
+    // The mapping stays valid after closing the file.
+    if (fileDesc >= 0) {
+      close(fileDesc);
+      fileDesc = -1;
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
   ~MappedFile()
   {
     if(mappedAddress && mapSize) {
@@ -66,13 +114,58 @@ public:
     }
   }
   
-  void* GetData() const override { return mappedAddress; }
-  std::size_t GetSize() const override { return mapSize; }
+  void* GetData() const override
+  {
+    return mappedAddress ? static_cast<char*>(mappedAddress) + dataOffset : nullptr;
+  }
+  std::size_t GetSize() const override { return dataSize; }
+
+  // Returns a pointer to count objects of type T starting at offset
+  // relative to GetData(), or nullptr if they do not lie completely
+  // within the mapped data or are not suitably aligned.
+  template<typename T>
+  const T* GetView(std::uint64_t offset, std::uint64_t count = 1) const
+  {
+    auto const data = static_cast<const char*>(GetData());
+    if (!data || offset > dataSize ||
+        count > (dataSize - offset) / sizeof(T)) {
+      return nullptr;
+    }
+    auto const address = data + offset;
+    if (reinterpret_cast<std::uintptr_t>(address) % alignof(T) != 0) {
+      return nullptr;
+    }
+    return reinterpret_cast<const T*>(address);
+  }
 
 private:
   int fileDesc;
   void* mappedAddress;
   size_t mapSize;
+  size_t dataOffset;
+  size_t dataSize;
+};
+
+// Refers to a range of bytes within a MappedFile and keeps the
+// mapping alive.
+class MappedFileRange final : public DataContainer
+{
+public:
+  MappedFileRange(std::shared_ptr<const MappedFile> file,
+                  const void* data,
+                  std::size_t size)
+    : m_File(std::move(file))
+    , m_Data(data)
+    , m_Size(size)
+  {}
+
+  void* GetData() const override { return const_cast<void*>(m_Data); }
+  std::size_t GetSize() const override { return m_Size; }
+
+private:
+  std::shared_ptr<const MappedFile> m_File;
+  const void* m_Data;
+  std::size_t m_Size;
 };
 
 }
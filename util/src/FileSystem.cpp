@@ -248,6 +248,42 @@ bool IsFile(const std::string& path)
   return S_ISREG(s.st_mode);
 }
 
+bool GetFileStatus(const std::string& path,
+                   int64_t& lastModified,
+                   uint64_t& size)
+{
+  US_STAT s;
+  errno = 0;
+  if (us_stat(path.c_str(), &s)) {
+    if (not_found_c_error(errno))
+      return false;
+    else
+      throw std::invalid_argument(GetLastCErrorStr());
+  }
+#if defined(US_PLATFORM_WINDOWS)
+  // _stat only has a resolution of one second
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+  if (!::GetFileAttributesExW(
+        ToWString(path).c_str(), GetFileExInfoStandard, &attributes)) {
+    throw std::invalid_argument(GetLastWin32ErrorStr());
+  }
+  ULARGE_INTEGER writeTime;
+  writeTime.LowPart = attributes.ftLastWriteTime.dwLowDateTime;
+  writeTime.HighPart = attributes.ftLastWriteTime.dwHighDateTime;
+  // FILETIME counts 100 nanosecond intervals since January 1, 1601
+  lastModified =
+    (static_cast<int64_t>(writeTime.QuadPart) - 116444736000000000LL) * 100;
+#elif defined(US_PLATFORM_APPLE)
+  lastModified = static_cast<int64_t>(s.st_mtimespec.tv_sec) * 1000000000 +
+                 s.st_mtimespec.tv_nsec;
+#else
+  lastModified =
+    static_cast<int64_t>(s.st_mtim.tv_sec) * 1000000000 + s.st_mtim.tv_nsec;
+#endif
+  size = static_cast<uint64_t>(s.st_size);
+  return true;
+}
+
 bool IsRelative(const std::string& path)
 {
 #ifdef US_PLATFORM_WINDOWS